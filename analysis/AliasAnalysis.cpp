@@ -0,0 +1,286 @@
+#include "AliasAnalysis.h"
+#include "InstructionBuilder.h"
+#include "Traversals.h"
+
+
+namespace ir {
+bool AliasAnalysis::Run() {
+    if (graph->IsEmpty()) {
+        return true;
+    }
+    PassManager::Run<RPO>(graph);
+
+    auto &info = graph->GetAliasInfo();
+    info.Clear();
+    info.GetReferences().Reserve(graph->GetInstructionBuilder()->GetNextId());
+    // definitions precede uses in RPO, except for inputs of PHIs coming by back edges
+    for (auto *bblock : graph->GetRPO()) {
+        for (auto *instr : *bblock) {
+            if (instr->GetType() == OperandType::REF) {
+                info.GetReferences().Insert(instr->GetId(), computeRefInfo(instr));
+                if (isAllocation(instr)) {
+                    info.GetNonEscapingAllocations().Insert(instr->GetId());
+                }
+            }
+        }
+    }
+    for (auto *bblock : graph->GetRPO()) {
+        for (auto *instr : *bblock) {
+            if (instr->GetType() == OperandType::REF) {
+                findEscapes(instr);
+            }
+        }
+    }
+    return true;
+}
+
+/* static */
+AliasResult AliasAnalysis::CheckAlias(const Graph *graph, const InstructionBase *lhs, const InstructionBase *rhs) {
+    ASSERT((graph) && graph->IsAnalysisValid(AnalysisFlag::ALIAS_ANALYSIS));
+    ASSERT((lhs) && (rhs) && IsMemoryAccess(lhs) && IsMemoryAccess(rhs));
+    if (isObjectAccess(lhs) != isObjectAccess(rhs) || getAccessedType(lhs) != getAccessedType(rhs)) {
+        return AliasResult::NO_ALIAS;
+    }
+    auto refResult = CheckRefAlias(graph, getReference(lhs), getReference(rhs));
+    if (refResult == AliasResult::NO_ALIAS) {
+        return AliasResult::NO_ALIAS;
+    }
+
+    if (isObjectAccess(lhs)) {
+        return getImmediate(lhs) == getImmediate(rhs) ? refResult : AliasResult::NO_ALIAS;
+    }
+
+    uint64_t lhsIdx = 0;
+    uint64_t rhsIdx = 0;
+    bool lhsConstant = getConstantIndex(lhs, lhsIdx);
+    bool rhsConstant = getConstantIndex(rhs, rhsIdx);
+    if (lhsConstant && rhsConstant) {
+        return lhsIdx == rhsIdx ? refResult : AliasResult::NO_ALIAS;
+    }
+    if (!lhsConstant && !rhsConstant && getIndex(lhs) == getIndex(rhs)) {
+        return refResult;
+    }
+    return AliasResult::MAY_ALIAS;
+}
+
+/* static */
+AliasResult AliasAnalysis::CheckRefAlias(const Graph *graph, const InstructionBase *lhs, const InstructionBase *rhs) {
+    ASSERT((graph) && graph->IsAnalysisValid(AnalysisFlag::ALIAS_ANALYSIS));
+    ASSERT((lhs) && (rhs) && lhs->GetType() == OperandType::REF && rhs->GetType() == OperandType::REF);
+    const auto &info = graph->GetAliasInfo();
+    auto lhsInfo = getRefInfo(info, lhs);
+    auto rhsInfo = getRefInfo(info, rhs);
+    if (lhsInfo.base == rhsInfo.base) {
+        return AliasResult::MUST_ALIAS;
+    }
+
+    bool lhsAllocation = isAllocation(lhsInfo.base);
+    bool rhsAllocation = isAllocation(rhsInfo.base);
+    if (lhsAllocation && rhsAllocation) {
+        return AliasResult::NO_ALIAS;
+    }
+    // arguments are passed before any object is allocated
+    if ((lhsAllocation && rhsInfo.base->IsInputArgument())
+            || (rhsAllocation && lhsInfo.base->IsInputArgument())) {
+        return AliasResult::NO_ALIAS;
+    }
+    const auto &nonEscapingAllocations = info.GetNonEscapingAllocations();
+    if ((lhsAllocation && nonEscapingAllocations.Contains(lhsInfo.base->GetId()))
+            || (rhsAllocation && nonEscapingAllocations.Contains(rhsInfo.base->GetId()))) {
+        return AliasResult::NO_ALIAS;
+    }
+    if (lhsInfo.typeId != AliasInfo::UNKNOWN_TYPE_ID && rhsInfo.typeId != AliasInfo::UNKNOWN_TYPE_ID
+            && lhsInfo.typeId != rhsInfo.typeId) {
+        return AliasResult::NO_ALIAS;
+    }
+    return AliasResult::MAY_ALIAS;
+}
+
+/* static */
+bool AliasAnalysis::IsMemoryAccess(const InstructionBase *instr) {
+    ASSERT(instr);
+    switch (instr->GetOpcode()) {
+    case Opcode::LOAD_ARRAY:
+    case Opcode::LOAD_ARRAY_IMM:
+    case Opcode::LOAD_OBJECT:
+    case Opcode::STORE_ARRAY:
+    case Opcode::STORE_ARRAY_IMM:
+    case Opcode::STORE_OBJECT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* static */
+bool AliasAnalysis::isAllocation(const InstructionBase *instr) {
+    ASSERT(instr);
+    auto opcode = instr->GetOpcode();
+    return opcode == Opcode::NEW_OBJECT || opcode == Opcode::NEW_ARRAY || opcode == Opcode::NEW_ARRAY_IMM;
+}
+
+/* static */
+bool AliasAnalysis::isObjectAccess(const InstructionBase *instr) {
+    ASSERT(instr);
+    return instr->GetOpcode() == Opcode::LOAD_OBJECT || instr->GetOpcode() == Opcode::STORE_OBJECT;
+}
+
+/* static */
+const InstructionBase *AliasAnalysis::getReference(const InstructionBase *access) {
+    ASSERT((access) && IsMemoryAccess(access));
+    return access->AsInputsInstruction()->GetInput(0).GetInstruction();
+}
+
+/* static */
+OperandType AliasAnalysis::getAccessedType(const InstructionBase *access) {
+    ASSERT((access) && IsMemoryAccess(access));
+    switch (access->GetOpcode()) {
+    case Opcode::STORE_ARRAY:
+    case Opcode::STORE_ARRAY_IMM:
+    case Opcode::STORE_OBJECT: {
+        // CASTs have types of their inputs, not of their results
+        const auto *value = access->AsInputsInstruction()->GetInput(1).GetInstruction();
+        if (value->GetOpcode() == Opcode::CAST) {
+            return static_cast<const CastInstruction *>(value)->GetTargetType();
+        }
+        return value->GetType();
+    }
+    default:
+        return access->GetType();
+    }
+}
+
+/* static */
+bool AliasAnalysis::getConstantIndex(const InstructionBase *access, uint64_t &idx) {
+    ASSERT(access);
+    if (access->GetOpcode() == Opcode::LOAD_ARRAY_IMM || access->GetOpcode() == Opcode::STORE_ARRAY_IMM) {
+        idx = getImmediate(access);
+        return true;
+    }
+    const auto *index = getIndex(access);
+    if (index->IsConst()) {
+        idx = index->AsConst()->GetValue();
+        return true;
+    }
+    return false;
+}
+
+/* static */
+uint64_t AliasAnalysis::getImmediate(const InstructionBase *access) {
+    ASSERT(access);
+    switch (access->GetOpcode()) {
+    case Opcode::LOAD_ARRAY_IMM:
+    case Opcode::LOAD_OBJECT:
+        return static_cast<const LoadImmInstruction *>(access)->GetValue();
+    case Opcode::STORE_ARRAY_IMM:
+    case Opcode::STORE_OBJECT:
+        return static_cast<const StoreImmInstruction *>(access)->GetValue();
+    default:
+        UNREACHABLE("the access must have immediate offset or index");
+        return 0;
+    }
+}
+
+/* static */
+const InstructionBase *AliasAnalysis::getIndex(const InstructionBase *access) {
+    ASSERT(access);
+    const auto *inputs = access->AsInputsInstruction();
+    switch (access->GetOpcode()) {
+    case Opcode::LOAD_ARRAY:
+        return inputs->GetInput(1).GetInstruction();
+    case Opcode::STORE_ARRAY:
+        return inputs->GetInput(2).GetInstruction();
+    default:
+        UNREACHABLE("the access must have index input");
+        return nullptr;
+    }
+}
+
+AliasAnalysis::RefInfo AliasAnalysis::computeRefInfo(const InstructionBase *ref) const {
+    ASSERT((ref) && ref->GetType() == OperandType::REF);
+    switch (ref->GetOpcode()) {
+    case Opcode::NEW_OBJECT:
+        return {ref, static_cast<const NewObjectInstruction *>(ref)->GetTypeId()};
+    case Opcode::NEW_ARRAY:
+        return {ref, static_cast<const NewArrayInstruction *>(ref)->GetTypeId()};
+    case Opcode::NEW_ARRAY_IMM:
+        return {ref, static_cast<const NewArrayImmInstruction *>(ref)->GetTypeId()};
+    case Opcode::MOVE:
+        return getRefInfo(graph->GetAliasInfo(), ref->AsInputsInstruction()->GetInput(0).GetInstruction());
+    case Opcode::PHI: {
+        // inputs coming by back edges are not resolved yet, so such PHIs are bases themselves
+        const auto *phi = ref->AsPhi();
+        const auto &references = graph->GetAliasInfo().GetReferences();
+        RefInfo info;
+        for (size_t i = 0, end = phi->GetInputsCount(); i < end; ++i) {
+            const auto *input = phi->GetInput(i).GetInstruction();
+            const auto *inputInfo = references.Find(input->GetId());
+            if (inputInfo == nullptr) {
+                return {phi, AliasInfo::UNKNOWN_TYPE_ID};
+            }
+            if (i == 0) {
+                info = *inputInfo;
+                continue;
+            }
+            if (inputInfo->base != info.base) {
+                info.base = phi;
+            }
+            if (inputInfo->typeId != info.typeId) {
+                info.typeId = AliasInfo::UNKNOWN_TYPE_ID;
+            }
+        }
+        return info.base ? info : RefInfo{phi, AliasInfo::UNKNOWN_TYPE_ID};
+    }
+    default:
+        return {ref, AliasInfo::UNKNOWN_TYPE_ID};
+    }
+}
+
+/* static */
+AliasAnalysis::RefInfo AliasAnalysis::getRefInfo(const AliasInfo &info, const InstructionBase *ref) {
+    ASSERT(ref);
+    // references, which are not resolved yet, are bases themselves
+    const auto *refInfo = info.GetReferences().Find(ref->GetId());
+    return refInfo ? *refInfo : RefInfo{ref, AliasInfo::UNKNOWN_TYPE_ID};
+}
+
+void AliasAnalysis::findEscapes(const InstructionBase *ref) {
+    ASSERT(ref);
+    auto &info = graph->GetAliasInfo();
+    auto &nonEscapingAllocations = info.GetNonEscapingAllocations();
+    const auto *base = getRefInfo(info, ref).base;
+    if (!nonEscapingAllocations.Contains(base->GetId()) || !isAllocation(base)) {
+        return;
+    }
+    for (const auto *user : ref->GetUsers()) {
+        bool escapes = false;
+        switch (user->GetOpcode()) {
+        case Opcode::LOAD_ARRAY:
+        case Opcode::LOAD_ARRAY_IMM:
+        case Opcode::LOAD_OBJECT:
+        case Opcode::LEN:
+        case Opcode::NULL_CHECK:
+        case Opcode::BOUNDS_CHECK:
+        case Opcode::CMP:
+            break;
+        case Opcode::STORE_ARRAY:
+        case Opcode::STORE_ARRAY_IMM:
+        case Opcode::STORE_OBJECT:
+            // the reference must not be the stored value
+            escapes = user->AsInputsInstruction()->GetInput(1) == ref;
+            break;
+        case Opcode::MOVE:
+        case Opcode::PHI:
+            escapes = getRefInfo(info, user).base != base;
+            break;
+        default:
+            escapes = true;
+            break;
+        }
+        if (escapes) {
+            nonEscapingAllocations.Erase(base->GetId());
+            return;
+        }
+    }
+}
+}   // namespace ir
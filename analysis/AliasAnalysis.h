@@ -0,0 +1,65 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_ALIAS_ANALYSIS_H_
+#define JIT_AOT_COMPILERS_COURSE_ALIAS_ANALYSIS_H_
+
+#include "PassBase.h"
+
+
+namespace ir {
+enum class AliasResult : uint8_t {
+    NO_ALIAS = 0,
+    MAY_ALIAS,
+    MUST_ALIAS
+};
+
+// Disambiguates accesses of objects' fields and arrays' elements.
+// References are resolved through MOVEs and PHIs into their bases: allocation sites,
+// arguments or other values. Distinct allocation sites never alias, neither do
+// allocation sites and arguments, and allocated objects, which do not escape,
+// are not aliased by references of other bases. References to allocated objects
+// of different types never alias too.
+// Accesses are disambiguated by field offsets and constant indices, and accesses
+// of values of different types are assumed to access different fields or arrays.
+// Bases of all references are computed once and cached in the graph's AliasInfo,
+// so that queries of all passes take constant time. Adding and removing instructions
+// and retargeting users with ReplaceInputInUsers invalidate the cache; passes, which
+// set inputs directly, must invalidate ALIAS_ANALYSIS themselves.
+class AliasAnalysis final : public PassBase {
+public:
+    explicit AliasAnalysis(Graph *graph) : PassBase(graph) {}
+    NO_COPY_SEMANTIC(AliasAnalysis);
+    NO_MOVE_SEMANTIC(AliasAnalysis);
+    ~AliasAnalysis() noexcept override = default;
+
+    bool Run() override;
+
+    // Queries require the analysis to be valid, e.g. run via PassManager::Run<AliasAnalysis>.
+    // Both instructions must be accesses of objects or arrays.
+    static AliasResult CheckAlias(const Graph *graph, const InstructionBase *lhs, const InstructionBase *rhs);
+    static AliasResult CheckRefAlias(const Graph *graph, const InstructionBase *lhs, const InstructionBase *rhs);
+
+    static bool IsMemoryAccess(const InstructionBase *instr);
+
+public:
+    static constexpr AnalysisFlag SET_FLAG = AnalysisFlag::ALIAS_ANALYSIS;
+
+private:
+    using RefInfo = AliasInfo::RefInfo;
+
+    static bool isAllocation(const InstructionBase *instr);
+    static bool isObjectAccess(const InstructionBase *instr);
+    static const InstructionBase *getReference(const InstructionBase *access);
+    static OperandType getAccessedType(const InstructionBase *access);
+    // Returns the field's offset or the element's index of the access.
+    static uint64_t getImmediate(const InstructionBase *access);
+    // Sets the index to the constant index of the array's access, if it is known.
+    static bool getConstantIndex(const InstructionBase *access, uint64_t &idx);
+    static const InstructionBase *getIndex(const InstructionBase *access);
+
+    static RefInfo getRefInfo(const AliasInfo &info, const InstructionBase *ref);
+
+    RefInfo computeRefInfo(const InstructionBase *ref) const;
+    void findEscapes(const InstructionBase *ref);
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_ALIAS_ANALYSIS_H_
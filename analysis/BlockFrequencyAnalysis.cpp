@@ -0,0 +1,216 @@
+#include <algorithm>
+#include "BlockFrequencyAnalysis.h"
+#include "DomTree.h"
+#include "LoopAnalyzer.h"
+#include "Traversals.h"
+
+
+namespace ir {
+bool BlockFrequencyAnalysis::Run() {
+    if (graph->IsEmpty()) {
+        return true;
+    }
+    PassManager::Run<DomTreeBuilder>(graph);
+    PassManager::Run<LoopAnalyzer>(graph);
+    PassManager::Run<RPO>(graph);
+
+    computeBranchProbabilities();
+    computeFrequencies();
+    return true;
+}
+
+void BlockFrequencyAnalysis::computeBranchProbabilities() {
+    graph->ForEachBasicBlock([](BasicBlock *bblock) {
+        if (bblock->GetSuccessorsCount() == 2 && bblock->EndsWithConditionalJump() != nullptr) {
+            bblock->SetBranchProbability(estimateBranchProbability(bblock));
+        }
+    });
+}
+
+/* static */
+double BlockFrequencyAnalysis::estimateBranchProbability(const BasicBlock *bblock) {
+    ASSERT(bblock);
+    double probability = 0.5;
+    probability = combine(probability, estimateByLoops(bblock));
+    probability = combine(probability, estimateByOpcode(bblock));
+    probability = combine(probability, estimateByReturns(bblock));
+    return probability;
+}
+
+// Back edges are taken and exits from loops are not.
+/* static */
+double BlockFrequencyAnalysis::estimateByLoops(const BasicBlock *bblock) {
+    const auto &succs = bblock->GetSuccessors();
+    bool backEdge0 = isBackEdge(bblock, succs[0]);
+    bool backEdge1 = isBackEdge(bblock, succs[1]);
+    if (backEdge0 != backEdge1) {
+        return backEdge0 ? LOOP_BRANCH_PROBABILITY : 1.0 - LOOP_BRANCH_PROBABILITY;
+    }
+
+    const auto *loop = bblock->GetLoop();
+    if (loop == nullptr || loop->IsRoot()) {
+        return 0.5;
+    }
+    auto staysInLoop = [loop](const BasicBlock *succ) {
+        return succ->GetLoop() == loop || succ->GetLoop()->IsIn(loop);
+    };
+    bool stays0 = staysInLoop(succs[0]);
+    bool stays1 = staysInLoop(succs[1]);
+    if (stays0 != stays1) {
+        return stays0 ? LOOP_BRANCH_PROBABILITY : 1.0 - LOOP_BRANCH_PROBABILITY;
+    }
+    return 0.5;
+}
+
+// Comparisons for equality with constants and for being negative usually fail.
+/* static */
+double BlockFrequencyAnalysis::estimateByOpcode(const BasicBlock *bblock) {
+    const auto *cmp = bblock->EndsWithConditionalJump();
+    ASSERT(cmp);
+    const auto *lhs = cmp->GetInput(0).GetInstruction();
+    const auto *rhs = cmp->GetInput(1).GetInstruction();
+    auto ccode = cmp->GetCondCode();
+    if (lhs->IsConst() && !rhs->IsConst()) {
+        // mirror the comparison to have the constant on the right
+        std::swap(lhs, rhs);
+        ccode = mirrorCondCode(ccode);
+    }
+    if (!rhs->IsConst() || lhs->IsConst()) {
+        return 0.5;
+    }
+
+    bool isZero = rhs->AsConst()->GetValue() == 0;
+    switch (ccode) {
+    case CondCode::EQ:
+        return 1.0 - OPCODE_PROBABILITY;
+    case CondCode::NE:
+        return OPCODE_PROBABILITY;
+    case CondCode::LT:
+    case CondCode::LE:
+        return isZero ? 1.0 - OPCODE_PROBABILITY : 0.5;
+    case CondCode::GT:
+    case CondCode::GE:
+        return isZero ? OPCODE_PROBABILITY : 0.5;
+    default:
+        UNREACHABLE("unexpected condition code");
+        return 0.5;
+    }
+}
+
+// Branches leading to returns are usually early exits handling special cases.
+/* static */
+double BlockFrequencyAnalysis::estimateByReturns(const BasicBlock *bblock) {
+    auto returns = [](const BasicBlock *succ) {
+        // look through a single unconditional jump
+        const auto *last = succ->GetLastInstruction();
+        bool isEmpty = last == nullptr || (succ->GetSize() == 1 && last->GetOpcode() == Opcode::JMP);
+        if (succ->GetSuccessorsCount() == 1 && isEmpty) {
+            succ = succ->GetSuccessors()[0];
+            last = succ->GetLastInstruction();
+        }
+        return last != nullptr && (last->GetOpcode() == Opcode::RET || last->GetOpcode() == Opcode::RETVOID);
+    };
+    const auto &succs = bblock->GetSuccessors();
+    bool returns0 = returns(succs[0]);
+    bool returns1 = returns(succs[1]);
+    if (returns0 != returns1) {
+        return returns0 ? 1.0 - RETURN_PROBABILITY : RETURN_PROBABILITY;
+    }
+    return 0.5;
+}
+
+/* static */
+double BlockFrequencyAnalysis::combine(double probability, double predicted) {
+    auto taken = probability * predicted;
+    auto notTaken = (1.0 - probability) * (1.0 - predicted);
+    return taken / (taken + notTaken);
+}
+
+void BlockFrequencyAnalysis::computeFrequencies() {
+    auto rpo = graph->GetRPO();
+    rpoNumbers.Clear();
+    rpoNumbers.Reserve(graph->GetMaximumBlockId() + 1);
+    for (size_t i = 0, end = rpo.size(); i < end; ++i) {
+        rpoNumbers.Insert(rpo[i]->GetId(), i);
+    }
+    cyclicProbabilities.Clear();
+
+    // frequencies of inner loops' blocks are relative to their headers,
+    // until they are recomputed by the outer loops
+    orderLoops();
+    for (const auto *loop : loopsOrder) {
+        collectRegion(loop);
+        propagateFrequencies(loop);
+    }
+}
+
+void BlockFrequencyAnalysis::orderLoops() {
+    loopsOrder.clear();
+    loopsStack.clear();
+    loopsStack.push_back(graph->GetLoopTree());
+    while (!loopsStack.empty()) {
+        const auto *loop = loopsStack.back();
+        loopsStack.pop_back();
+        loopsOrder.push_back(loop);
+        const auto &inner = loop->GetInnerLoops();
+        loopsStack.insert(loopsStack.end(), inner.begin(), inner.end());
+    }
+    // inner loops follow the outer ones in preorder
+    std::ranges::reverse(loopsOrder);
+}
+
+void BlockFrequencyAnalysis::collectRegion(const Loop *loop) {
+    ASSERT(loop && loopsStack.empty());
+    region.clear();
+    loopsStack.push_back(loop);
+    while (!loopsStack.empty()) {
+        const auto *current = loopsStack.back();
+        loopsStack.pop_back();
+        for (auto *bblock : current->GetBasicBlocks()) {
+            // unreachable blocks are not numbered
+            if (rpoNumbers.Contains(bblock->GetId())) {
+                region.push_back(bblock);
+            }
+        }
+        const auto &inner = current->GetInnerLoops();
+        loopsStack.insert(loopsStack.end(), inner.begin(), inner.end());
+    }
+    std::ranges::sort(region, [this](const BasicBlock *lhs, const BasicBlock *rhs) {
+        return rpoNumbers.At(lhs->GetId()) < rpoNumbers.At(rhs->GetId());
+    });
+    for (auto *bblock : region) {
+        bblock->SetFrequency(0);
+    }
+}
+
+void BlockFrequencyAnalysis::propagateFrequencies(const Loop *loop) {
+    ASSERT(loop);
+    const auto *head = loop->IsRoot() ? graph->GetFirstBasicBlock() : loop->GetHeader();
+    for (auto *bblock : region) {
+        double frequency = 1.0;
+        if (bblock != head) {
+            frequency = 0;
+            for (const auto *pred : bblock->GetPredecessors()) {
+                if (!isBackEdge(pred, bblock)) {
+                    frequency += pred->GetFrequency() * pred->GetEdgeProbability(bblock);
+                }
+            }
+            if (const auto *cyclic = cyclicProbabilities.Find(bblock->GetId())) {
+                // the header of an inner loop is executed on each iteration
+                frequency /= 1.0 - *cyclic;
+            }
+        }
+        bblock->SetFrequency(frequency);
+    }
+
+    // edges of irreducible loops are not distinguished from forward ones
+    if (loop->IsRoot() || loop->IsIrreducible()) {
+        return;
+    }
+    double cyclic = 0;
+    for (const auto *backEdgeSource : loop->GetBackEdges()) {
+        cyclic += backEdgeSource->GetFrequency() * backEdgeSource->GetEdgeProbability(head);
+    }
+    cyclicProbabilities.Insert(head->GetId(), std::min(cyclic, MAX_CYCLIC_PROBABILITY));
+}
+}   // namespace ir
@@ -0,0 +1,73 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_BLOCK_FREQUENCY_ANALYSIS_H_
+#define JIT_AOT_COMPILERS_COURSE_BLOCK_FREQUENCY_ANALYSIS_H_
+
+#include "IdMap.h"
+#include "Loop.h"
+#include "PassBase.h"
+#include <vector>
+
+
+namespace ir {
+// Estimates probabilities of branches with static heuristics and propagates them
+// into frequencies of basic blocks relative to the graph's entry, following
+// "Static Branch Frequency and Program Profile Analysis" by Wu and Larus.
+// Results are saved into basic blocks.
+class BlockFrequencyAnalysis final : public PassBase {
+public:
+    explicit BlockFrequencyAnalysis(Graph *graph)
+        : PassBase(graph),
+          rpoNumbers(GetScratchResource()),
+          cyclicProbabilities(GetScratchResource()),
+          loopsOrder(GetScratchResource()),
+          loopsStack(GetScratchResource()),
+          region(GetScratchResource())
+    {}
+    NO_COPY_SEMANTIC(BlockFrequencyAnalysis);
+    NO_MOVE_SEMANTIC(BlockFrequencyAnalysis);
+    ~BlockFrequencyAnalysis() noexcept override = default;
+
+    bool Run() override;
+
+public:
+    static constexpr AnalysisFlag SET_FLAG = AnalysisFlag::BLOCK_FREQUENCY;
+
+    // probabilities of the predicted branches
+    static constexpr double LOOP_BRANCH_PROBABILITY = 0.88;
+    static constexpr double OPCODE_PROBABILITY = 0.84;
+    static constexpr double RETURN_PROBABILITY = 0.72;
+    // bounds the estimated number of a loop's iterations
+    static constexpr double MAX_CYCLIC_PROBABILITY = 0.999;
+
+private:
+    void computeBranchProbabilities();
+    // Returns probability of the first successor of the conditional branch.
+    static double estimateBranchProbability(const BasicBlock *bblock);
+    static double estimateByLoops(const BasicBlock *bblock);
+    static double estimateByOpcode(const BasicBlock *bblock);
+    static double estimateByReturns(const BasicBlock *bblock);
+    // Combines the probabilities predicted independently (Dempster-Shafer theory).
+    static double combine(double probability, double predicted);
+
+    void computeFrequencies();
+    // Orders loops from the innermost ones to the root.
+    void orderLoops();
+    void collectRegion(const Loop *loop);
+    void propagateFrequencies(const Loop *loop);
+
+    static bool isBackEdge(const BasicBlock *from, const BasicBlock *to) {
+        return to->IsLoopHeader() && to->Dominates(from);
+    }
+
+private:
+    IdMap<size_t> rpoNumbers;
+    // keyed by IDs of loops' headers
+    IdMap<double> cyclicProbabilities;
+
+    std::pmr::vector<const Loop *> loopsOrder;
+    std::pmr::vector<const Loop *> loopsStack;
+    // blocks of the loop being processed and of its inner loops in RPO
+    std::pmr::vector<BasicBlock *> region;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_BLOCK_FREQUENCY_ANALYSIS_H_
@@ -1,4 +1,5 @@
 #include "DSU.h"
+#include <ranges>
 
 
 namespace ir {
@@ -13,21 +14,24 @@ BasicBlock *DSU::Find(BasicBlock *bblock) {
 }
 
 void DSU::compressUniversum(BasicBlock *bblock) {
-    auto anc = getUniversum(bblock->GetId());
-    ASSERT(anc != nullptr);
-
-    if (getUniversum(anc->GetId()) == nullptr) {    // return if root
-        return;
+    ASSERT(getUniversum(bblock->GetId()) != nullptr);
+    // collect nodes, whose ancestors are not roots
+    compressionPath.clear();
+    for (auto *node = bblock; getUniversum(getUniversum(node->GetId())->GetId()) != nullptr;
+         node = getUniversum(node->GetId())) {
+        compressionPath.push_back(node);
     }
 
-    compressUniversum(anc);
-
-    auto minForBBlock = getLabel(bblock);
-    auto minForAnc = getLabel(anc);
-    if (getSemiDominator(minForAnc) < getSemiDominator(minForBBlock)) {
-        setLabel(bblock, minForAnc);      // update min semi-dominator
+    // compress starting from the node closest to the root
+    for (auto *node : std::views::reverse(compressionPath)) {
+        auto anc = getUniversum(node->GetId());
+        auto minForBBlock = getLabel(node);
+        auto minForAnc = getLabel(anc);
+        if (getSemiDominator(minForAnc) < getSemiDominator(minForBBlock)) {
+            setLabel(node, minForAnc);      // update min semi-dominator
+        }
+        setUniversum(node->GetId(), getUniversum(anc->GetId()));  // link to the root
     }
-    setUniversum(bblock->GetId(), getUniversum(anc->GetId()));  // link to the root
 }
 
 void DSU::Dump() const {
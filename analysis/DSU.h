@@ -17,6 +17,7 @@ public:
         const std::pmr::vector<size_t> &sdoms,
         std::pmr::memory_resource *memResource)
         : universum(labels.size(), nullptr, memResource),
+          compressionPath(memResource),
           labels(labels),
           sdoms(sdoms)
     {}
@@ -70,6 +71,8 @@ private:
 
 private:
     std::pmr::vector<BasicBlock *> universum;
+    // buffer for nodes on the path being compressed
+    std::pmr::vector<BasicBlock *> compressionPath;
     std::pmr::vector<BasicBlock *> &labels;
     const std::pmr::vector<size_t> &sdoms;
 };
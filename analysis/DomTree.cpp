@@ -1,47 +1,54 @@
 #include "DomTree.h"
+#include <algorithm>
 #include <numeric>
+#include <ranges>
 #include "Traversals.h"
 
 
 namespace ir {
-DSU DomTreeBuilder::resetStructs() {
-    graph->ForEachBasicBlock([](BasicBlock *bblock) {
-        bblock->ClearDominatedBlocks();
-        bblock->SetDominator(nullptr);
-    });
-
+void DomTreeBuilder::resetStructs() {
     lastNumber = -1;
 
     auto bblocksCount = graph->GetMaximumBlockId() + 1;
     sdoms.resize(bblocksCount, BasicBlock::INVALID_ID);
-    sdomsSet.resize(bblocksCount);
     idoms.resize(bblocksCount, nullptr);
     labels.resize(bblocksCount, nullptr);
     orderedBBlocks.resize(bblocksCount, nullptr);
     bblocksParents.resize(bblocksCount, nullptr);
-
-    return DSU(labels, sdoms, graph->GetMemoryResource());
 }
 
 void DomTreeBuilder::dfsTraverse(BasicBlock *bblock) {
+    ASSERT((bblock) && dfsStack.empty());
+    visitBlock(bblock);
+    while (!dfsStack.empty()) {
+        auto [current, succIdx] = dfsStack.back();
+        const auto &succs = current->GetSuccessors();
+        if (succIdx == succs.size()) {
+            dfsStack.pop_back();
+            continue;
+        }
+        ++dfsStack.back().second;
+        auto *succ = succs[succIdx];
+        if (getLabel(succ) == nullptr) {
+            setBlockDFOParent(succ, current);
+            visitBlock(succ);
+        }
+    }
+}
+
+void DomTreeBuilder::visitBlock(BasicBlock *bblock) {
     ++lastNumber;
-    ASSERT((bblock) && (lastNumber < static_cast<int>(getSize())));
+    ASSERT((bblock) && (lastNumber < static_cast<int>(orderedBBlocks.size())));
 
     ASSERT(bblock->GetId() < labels.size());
     labels[bblock->GetId()] = bblock;
     setSemiDomNumber(bblock, lastNumber);
     setOrderedBlock(lastNumber, bblock);
-
-    for (auto *succ : bblock->GetSuccessors()) {
-        if (getLabel(succ) == nullptr) {
-            setBlockDFOParent(succ, bblock);
-            dfsTraverse(succ);
-        }
-    }
+    dfsStack.emplace_back(bblock, 0);
 }
 
 void DomTreeBuilder::computeSDoms(DSU &sdomsHelper) {
-    for (int i = getSize() - 1; i >= 0; --i) {
+    for (int i = lastNumber; i >= 0; --i) {
         auto *currentBlock = getOrderedBlock(i);
 
         for (const auto &pred : currentBlock->GetPredecessors()) {
@@ -68,4 +75,69 @@ void DomTreeBuilder::computeSDoms(DSU &sdomsHelper) {
         }
     }
 }
+
+void DomTreeBuilder::computeIDoms() {
+    for (size_t i = 1; i < getBlocksCount(); ++i) {
+        auto *currentBlock = getOrderedBlock(i);
+        auto currentBlockId = currentBlock->GetId();
+        if (getImmDominator(currentBlockId) != getOrderedBlock(getSemiDomNumber(currentBlock))) {
+            setImmDominator(currentBlockId,
+                            getImmDominator(getImmDominator(currentBlockId)->GetId()));
+        }
+    }
+}
+
+void DomTreeBuilder::computeSemiNCA() {
+    auto count = getBlocksCount();
+    semiNumbers.resize(count);
+    std::iota(semiNumbers.begin(), semiNumbers.end(), 0);
+    minSemiNodes.assign(semiNumbers.begin(), semiNumbers.end());
+    ancestors.assign(count, NO_ANCESTOR);
+
+    // compute semi-dominators in reverse DFO
+    for (size_t i = count - 1; i > 0; --i) {
+        auto *bblock = getOrderedBlock(i);
+        auto semi = semiNumbers[i];
+        for (auto *pred : bblock->GetPredecessors()) {
+            semi = std::min(semi, semiNumbers[evalSemiNCA(getDFONumber(pred))]);
+        }
+        semiNumbers[i] = semi;
+        ancestors[i] = getDFONumber(getBlockDFOParent(bblock));
+    }
+
+    // immediate dominator is the nearest common ancestor of the DFO parent
+    // and the semi-dominator in the dominators tree built so far;
+    // the link-eval forest is not needed anymore, so its storage is reused for the tree
+    auto &idomNumbers = ancestors;
+    for (size_t i = 1; i < count; ++i) {
+        auto *bblock = getOrderedBlock(i);
+        auto idom = getDFONumber(getBlockDFOParent(bblock));
+        while (idom > semiNumbers[i]) {
+            idom = idomNumbers[idom];
+        }
+        idomNumbers[i] = idom;
+        setImmDominator(bblock->GetId(), getOrderedBlock(idom));
+    }
+}
+
+// Returns DFO number of the node with the minimal semi-dominator on the path
+// from the given node to the root of its tree in the link-eval forest.
+size_t DomTreeBuilder::evalSemiNCA(size_t number) {
+    if (ancestors[number] == NO_ANCESTOR) {
+        return number;
+    }
+    // collect nodes, whose ancestors are not roots
+    compressionPath.clear();
+    for (auto node = number; ancestors[ancestors[node]] != NO_ANCESTOR; node = ancestors[node]) {
+        compressionPath.push_back(node);
+    }
+    for (auto node : std::views::reverse(compressionPath)) {
+        auto anc = ancestors[node];
+        if (semiNumbers[minSemiNodes[anc]] < semiNumbers[minSemiNodes[node]]) {
+            minSemiNodes[node] = minSemiNodes[anc];
+        }
+        ancestors[node] = ancestors[anc];
+    }
+    return minSemiNodes[number];
+}
 }   // namespace ir
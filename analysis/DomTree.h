@@ -2,8 +2,10 @@
 #define JIT_AOT_COMPILERS_COURSE_DOM_TREE_H_
 
 #include "AllocatorUtils.h"
+#include "CompilerBase.h"
 #include "DSU.h"
 #include "PassBase.h"
+#include <utility>
 #include <vector>
 
 
@@ -37,19 +39,29 @@ private:
     std::pmr::vector<BasicBlock *> dominated;
 };
 
-// This pass implements Tarjan's algorithm for building Dominators Tree for the inputs graph
+// This pass builds Dominators Tree for the input graph using either
+// Lengauer-Tarjan algorithm or Semi-NCA algorithm, see CompilerOptions.
+// Semi-NCA keeps all its data in flat vectors indexed by DFO numbers of blocks.
 class DomTreeBuilder : public PassBase {
 public:
     using VectorBBlocks = std::pmr::vector<BasicBlock *>;
 
     explicit DomTreeBuilder(Graph *graph)
+        : DomTreeBuilder(graph, graph->GetCompiler()->GetOptions().GetDomTreeAlgorithm()) {}
+    DomTreeBuilder(Graph *graph, DominatorsAlgorithm algorithm)
         : PassBase(graph),
-          idoms(graph->GetMemoryResource()),
-          sdoms(graph->GetMemoryResource()),
-          sdomsSet(graph->GetMemoryResource()),
-          labels(graph->GetMemoryResource()),
-          orderedBBlocks(graph->GetMemoryResource()),
-          bblocksParents(graph->GetMemoryResource())
+          algorithm(algorithm),
+          idoms(GetScratchResource()),
+          sdoms(GetScratchResource()),
+          sdomsSet(GetScratchResource()),
+          labels(GetScratchResource()),
+          orderedBBlocks(GetScratchResource()),
+          bblocksParents(GetScratchResource()),
+          dfsStack(GetScratchResource()),
+          semiNumbers(GetScratchResource()),
+          ancestors(GetScratchResource()),
+          minSemiNodes(GetScratchResource()),
+          compressionPath(GetScratchResource())
     {}
     NO_COPY_SEMANTIC(DomTreeBuilder);
     NO_MOVE_SEMANTIC(DomTreeBuilder);
@@ -58,8 +70,8 @@ public:
     bool Run() override {
         return build<true>(nullptr);
     }
-    auto Build() {
-        std::pmr::vector<DominatorInfo> doms(graph->GetMemoryResource());
+    auto Build(std::pmr::memory_resource *mem) {
+        std::pmr::vector<DominatorInfo> doms(graph->GetMaximumBlockId() + 1, DominatorInfo(mem), mem);
         build<false>(&doms);
         return doms;
     }
@@ -76,14 +88,23 @@ private:
     bool build(std::pmr::vector<DominatorInfo> *doms);
 
     template <bool InPlace>
-    void computeIDoms(std::pmr::vector<DominatorInfo> *doms);
+    void setIDoms(std::pmr::vector<DominatorInfo> *doms);
 
-    DSU resetStructs();
+    void resetStructs();
+    // Numbers blocks in depth-first order without recursion.
     void dfsTraverse(BasicBlock *bblock);
+    void visitBlock(BasicBlock *bblock);
+
+    // Lengauer-Tarjan
     void computeSDoms(DSU &sdomsHelper);
+    void computeIDoms();
+
+    // Semi-NCA
+    void computeSemiNCA();
+    size_t evalSemiNCA(size_t number);
 
-    size_t getSize() const {
-        return idoms.size();
+    size_t getBlocksCount() const {
+        return static_cast<size_t>(lastNumber + 1);
     }
 
     BasicBlock *getImmDominator(size_t id) {
@@ -103,6 +124,10 @@ private:
         ASSERT((bblock) && bblock->GetId() < sdoms.size());
         sdoms[bblock->GetId()] = visitNumber;
     }
+    // DFO number is kept as the initial semi-dominator number
+    size_t getDFONumber(BasicBlock *bblock) {
+        return getSemiDomNumber(bblock);
+    }
 
     const VectorBBlocks &getSemiDoms(BasicBlock *bblock) {
         ASSERT((bblock) && bblock->GetId() < sdomsSet.size());
@@ -138,6 +163,10 @@ private:
     }
 
 private:
+    static constexpr size_t NO_ANCESTOR = static_cast<size_t>(-1);
+
+    DominatorsAlgorithm algorithm;
+
     int lastNumber = 0;
 
     VectorBBlocks idoms;
@@ -153,33 +182,53 @@ private:
     VectorBBlocks orderedBBlocks;
     // basic blocks' parents in DFO tree
     VectorBBlocks bblocksParents;
+    // blocks being traversed and indices of their next successors
+    std::pmr::vector<std::pair<BasicBlock *, size_t>> dfsStack;
+
+    // Semi-NCA data indexed by DFO numbers:
+    // semi-dominators, ancestors in the link-eval forest and nodes with min semi-dominators on paths to them
+    std::pmr::vector<size_t> semiNumbers;
+    std::pmr::vector<size_t> ancestors;
+    std::pmr::vector<size_t> minSemiNodes;
+    std::pmr::vector<size_t> compressionPath;
 };
 
 template <bool InPlace>
 bool DomTreeBuilder::build(std::pmr::vector<DominatorInfo> *doms) {
     if (!graph->IsEmpty()) {
-        auto sdomsHelper = resetStructs();
+        resetStructs();
+        if constexpr (InPlace) {
+            graph->ForEachBasicBlock([](BasicBlock *bblock) {
+                bblock->ClearDominatedBlocks();
+                bblock->SetDominator(nullptr);
+            });
+        }
 
         dfsTraverse(graph->GetFirstBasicBlock());
         // check graph's connectivity
         ASSERT(lastNumber == static_cast<int>(graph->GetBasicBlocksCount()) - 1);
-        computeSDoms(sdomsHelper);
-        computeIDoms<InPlace>(doms);
+        if (algorithm == DominatorsAlgorithm::SEMI_NCA) {
+            computeSemiNCA();
+        } else {
+            auto bblocksCount = graph->GetMaximumBlockId() + 1;
+            sdomsSet.resize(bblocksCount);
+            DSU sdomsHelper(labels, sdoms, GetScratchResource());
+            computeSDoms(sdomsHelper);
+            computeIDoms();
+        }
+        setIDoms<InPlace>(doms);
+        if constexpr (InPlace) {
+            graph->NumberDomTree();
+        }
     }
     return true;
 }
 
 template <bool InPlace>
-void DomTreeBuilder::computeIDoms(std::pmr::vector<DominatorInfo> *doms) {
-    for (size_t i = 1; i < getSize(); ++i) {
+void DomTreeBuilder::setIDoms(std::pmr::vector<DominatorInfo> *doms) {
+    for (size_t i = 1; i < getBlocksCount(); ++i) {
         auto *currentBlock = getOrderedBlock(i);
-        auto currentBlockId = currentBlock->GetId();
-        if (getImmDominator(currentBlockId) != getOrderedBlock(getSemiDomNumber(currentBlock))) {
-            setImmDominator(currentBlockId,
-                            getImmDominator(getImmDominator(currentBlockId)->GetId()));
-        }
-
-        auto *immDom = getImmDominator(currentBlockId);
+        auto *immDom = getImmDominator(currentBlock->GetId());
         if constexpr (InPlace) {
             currentBlock->SetDominator(immDom);
             immDom->AddDominatedBlock(currentBlock);
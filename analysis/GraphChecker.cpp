@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <utility>
 
 #include "DomTree.h"
@@ -13,6 +14,9 @@ bool GraphChecker::Run() {
         /* DFO dry run to check graph is properly connected */
     });
     ASSERT(graph->VerifyFirstBlock());
+    if (graph->GetCompiler()->GetOptions().GetVerifyDomTree()) {
+        VerifyDomTree(graph);
+    }
     return true;
 }
 
@@ -22,8 +26,9 @@ void GraphChecker::VerifyDomTree(Graph *graph) {
     if (!graph->IsAnalysisValid(AnalysisFlag::DOM_TREE)) {
         return;
     }
+    utils::ScratchScope scratch;
     DomTreeBuilder builder(graph);
-    auto domsTreeInfo = builder.Build();
+    auto domsTreeInfo = builder.Build(scratch.GetArena());
     graph->ForEachBasicBlock([&doms = std::as_const(domsTreeInfo)](const BasicBlock *bblock) {
         auto info = doms[bblock->GetId()];
         ASSERT(info.GetDominator() == bblock->GetDominator());
@@ -71,8 +76,8 @@ void GraphChecker::VerifyPhiBasicBlocks(const PhiInstruction *phi) {
     ASSERT(sources.size() == phi->GetInputsCount());
     ASSERT(sources.size() == preds.size());
 
-    std::pmr::vector<bool> sourcesMask(
-        sources.size(), false, bblock->GetGraph()->GetMemoryResource());
+    utils::ScratchScope scratch;
+    std::pmr::vector<bool> sourcesMask(sources.size(), false, scratch.GetArena());
     for (const auto *pred : preds) {
         auto it = std::find(sources.begin(), sources.end(), pred);
         ASSERT(it != sources.end());
@@ -126,35 +131,26 @@ void GraphChecker::verifyDFG(const InstructionBase *instr) {
     if (instr->HasInputs()) {
         const auto *graph = instr->GetBasicBlock()->GetGraph();
         const auto *typed = static_cast<const InputsInstruction *>(instr);
-        auto found = false;
 
-        for (size_t i = 0, end_idx = typed->GetInputsCount(); i < end_idx; ++i) {
-            const auto &input = typed->GetInput(i);
+        for (const auto &input : typed->GetInputs()) {
             ASSERT((input.GetInstruction()) && (input->GetBasicBlock()));
             ASSERT(input->GetBasicBlock()->GetGraph() == graph);
-
-            auto currUsers = input->GetUsers();
-            auto iter = std::find(currUsers.begin(), currUsers.end(), instr);
-            if (iter != currUsers.end()) {
-                found = true;
-                break;
-            }
+            // attached inputs are always linked into their definitions' users
+            ASSERT(input.GetUser() == instr);
         }
-        ASSERT(found == true);
     }
 
-    auto inputUsers = instr->GetUsers();
-    for (auto &&user : inputUsers) {
-        ASSERT(user->HasInputs() == true);
+    [[maybe_unused]] size_t usesCount = 0;
+    for (const auto *use = instr->GetFirstUse(); use != nullptr; use = use->GetNextUse()) {
+        ASSERT(use->GetInstruction() == instr);
+        auto *user = use->GetUser();
+        ASSERT((user) && user->HasInputs() == true);
         auto *typed = static_cast<const InputsInstruction *>(user);
-        bool found = false;
-        for (size_t i = 0, end_idx = typed->GetInputsCount(); i < end_idx; ++i) {
-            if (typed->GetInput(i) == instr) {
-                found = true;
-                break;
-            }
-        }
-        ASSERT(found == true);
+        ASSERT(std::ranges::any_of(typed->GetInputs(), [use](const Input &input) {
+            return &input == use;
+        }));
+        ++usesCount;
     }
+    ASSERT(usesCount == instr->UsersCount());
 }
 }   // namespace ir
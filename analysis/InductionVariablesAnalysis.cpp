@@ -0,0 +1,340 @@
+#include <algorithm>
+#include "InductionVariablesAnalysis.h"
+#include <limits>
+#include "LoopAnalyzer.h"
+#include "Traversals.h"
+#include <utility>
+
+
+namespace ir {
+// Values of all integer types are sign-extended from their sizes with SignExtend, so that
+// results of the wrapping arithmetic below are valid modulo the sizes.
+static uint64_t wrapAdd(int64_t lhs, int64_t rhs) {
+    return static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs);
+}
+
+static uint64_t wrapMul(int64_t lhs, int64_t rhs) {
+    return static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs);
+}
+
+static bool getConstant(const InstructionBase *instr, int64_t &value) {
+    if (!instr->IsConst()) {
+        return false;
+    }
+    value = SignExtend(instr->AsConst()->GetValue(), instr->GetType());
+    return true;
+}
+
+static int64_t negate(int64_t value) {
+    return static_cast<int64_t>(wrapMul(value, -1));
+}
+
+// Converts the shift into the multiplier, if the shift is not out of the type's size.
+static bool getShiftScale(int64_t shift, OperandType type, int64_t &scale) {
+    if (shift < 0 || static_cast<size_t>(shift) >= GetTypeBitSize(type)) {
+        return false;
+    }
+    scale = static_cast<int64_t>(uint64_t(1) << shift);
+    return true;
+}
+
+// Matches the instruction as `scale * input + offset` with constant scale and offset,
+// returns the input or nullptr.
+static InstructionBase *matchLinear(InstructionBase *instr, int64_t &scale, int64_t &offset) {
+    auto type = instr->GetType();
+    if (!IsIntegerType(type) || !instr->HasInputs() || instr->IsPhi()) {
+        return nullptr;
+    }
+    auto *inputs = instr->AsInputsInstruction();
+    auto *lhs = inputs->GetInput(0).GetInstruction();
+    auto opcode = instr->GetOpcode();
+    int64_t value = 0;
+    switch (opcode) {
+    case Opcode::ADDI:
+    case Opcode::SUBI:
+    case Opcode::MULI:
+    case Opcode::SLLI:
+        value = SignExtend(static_cast<BinaryImmInstruction *>(instr)->GetValue(), type);
+        break;
+    case Opcode::NEG:
+        scale = -1;
+        offset = 0;
+        return lhs;
+    case Opcode::ADD:
+    case Opcode::SUB:
+    case Opcode::MUL:
+    case Opcode::SLL: {
+        auto *rhs = inputs->GetInput(1).GetInstruction();
+        if (getConstant(rhs, value)) {
+            break;
+        }
+        // only commutative operations and subtraction from a constant are matched on the left
+        if (opcode == Opcode::SLL || !getConstant(lhs, value)) {
+            return nullptr;
+        }
+        if (opcode == Opcode::SUB) {
+            scale = -1;
+            offset = value;
+            return rhs;
+        }
+        lhs = rhs;
+        break;
+    }
+    default:
+        return nullptr;
+    }
+
+    scale = 1;
+    offset = 0;
+    switch (opcode) {
+    case Opcode::ADD:
+    case Opcode::ADDI:
+        offset = value;
+        break;
+    case Opcode::SUB:
+    case Opcode::SUBI:
+        offset = negate(value);
+        break;
+    case Opcode::MUL:
+    case Opcode::MULI:
+        scale = value;
+        break;
+    case Opcode::SLL:
+    case Opcode::SLLI:
+        if (!getShiftScale(value, type, scale)) {
+            return nullptr;
+        }
+        break;
+    default:
+        UNREACHABLE("unexpected opcode");
+        return nullptr;
+    }
+    return lhs;
+}
+
+static bool isInLoop(const Loop *loop, const BasicBlock *bblock) {
+    const auto *blockLoop = bblock->GetLoop();
+    return blockLoop == loop || blockLoop->IsIn(loop);
+}
+
+bool InductionVariablesAnalysis::Run() {
+    if (graph->IsEmpty()) {
+        return true;
+    }
+    PassManager::Run<LoopAnalyzer>(graph);
+    PassManager::Run<RPO>(graph);
+
+    // headers precede other blocks of their loops in RPO, and definitions precede uses
+    loops.clear();
+    for (auto *bblock : graph->GetRPO()) {
+        auto *loop = bblock->GetLoop();
+        if (loop->GetHeader() == bblock) {
+            loop->ClearInductionVariables();
+            if (isInductionLoop(loop)) {
+                loops.push_back(loop);
+                findBasicVariables(loop);
+            }
+        }
+        if (isInductionLoop(loop)) {
+            for (auto *instr : *bblock) {
+                findDerivedVariable(loop, instr);
+            }
+        }
+    }
+    for (auto *loop : loops) {
+        findExitTest(loop);
+        computeTripCount(loop);
+    }
+    return true;
+}
+
+void InductionVariablesAnalysis::findBasicVariables(Loop *loop) {
+    ASSERT(isInductionLoop(loop));
+    const auto &backEdges = std::as_const(*loop).GetBackEdges();
+    for (auto *phi : loop->GetHeader()->IteratePhi()) {
+        if (!IsIntegerType(phi->GetType())) {
+            continue;
+        }
+        // all inputs coming from outside the loop and all inputs coming by back edges must be the same
+        InstructionBase *init = nullptr;
+        InstructionBase *update = nullptr;
+        bool isValid = true;
+        for (size_t i = 0, end = phi->GetInputsCount(); i < end && isValid; ++i) {
+            auto *input = phi->GetInput(i).GetInstruction();
+            bool isBackEdge = std::ranges::find(backEdges, phi->GetSourceBasicBlock(i)) != backEdges.end();
+            auto *&expected = isBackEdge ? update : init;
+            isValid = expected == nullptr || expected == input;
+            expected = input;
+        }
+        int64_t step = 0;
+        if (isValid && init != nullptr && update != nullptr && findStep(loop, phi, update, step)) {
+            loop->AddInductionVariable({phi, phi, 1, 0, init, step});
+        }
+    }
+}
+
+/* static */
+bool InductionVariablesAnalysis::findStep(const Loop *loop, PhiInstruction *phi, InstructionBase *update,
+                                          int64_t &step) {
+    ASSERT((loop) && (phi) && (update));
+    int64_t total = 0;
+    // the update must be executed once per iteration
+    for (auto *instr = update; instr != phi;) {
+        if (instr->GetBasicBlock()->GetLoop() != loop) {
+            return false;
+        }
+        int64_t scale = 0;
+        int64_t offset = 0;
+        instr = matchLinear(instr, scale, offset);
+        if (instr == nullptr || scale != 1) {
+            return false;
+        }
+        total = static_cast<int64_t>(wrapAdd(total, offset));
+    }
+    step = SignExtend(static_cast<uint64_t>(total), phi->GetType());
+    return step != 0;
+}
+
+void InductionVariablesAnalysis::findDerivedVariable(Loop *loop, InstructionBase *instr) {
+    ASSERT((loop) && (instr));
+    int64_t scale = 0;
+    int64_t offset = 0;
+    auto *input = matchLinear(instr, scale, offset);
+    if (input == nullptr) {
+        return;
+    }
+    const auto *base = loop->FindInductionVariable(input);
+    if (base == nullptr) {
+        return;
+    }
+    auto type = instr->GetType();
+    auto var = *base;
+    var.value = instr;
+    var.scale = SignExtend(wrapMul(base->scale, scale), type);
+    var.offset = SignExtend(wrapAdd(static_cast<int64_t>(wrapMul(base->offset, scale)), offset), type);
+    loop->AddInductionVariable(var);
+}
+
+void InductionVariablesAnalysis::findExitTest(Loop *loop) {
+    ASSERT(isInductionLoop(loop));
+    const auto &exitingBlocks = loop->GetExitingBlocks();
+    if (exitingBlocks.size() != 1) {
+        return;
+    }
+    // the test must be executed exactly once per iteration
+    auto *bblock = exitingBlocks[0];
+    const auto &backEdges = std::as_const(*loop).GetBackEdges();
+    if (bblock->GetLoop() != loop
+            || !std::ranges::all_of(backEdges, [bblock](auto *source) { return bblock->Dominates(source); })) {
+        return;
+    }
+    auto *cmp = bblock->EndsWithConditionalJump();
+    if (cmp == nullptr) {
+        return;
+    }
+
+    const auto &succs = bblock->GetSuccessors();
+    ASSERT(succs.size() == 2);
+    bool staysOnTrue = isInLoop(loop, succs[0]);
+    if (staysOnTrue == isInLoop(loop, succs[1])) {
+        return;
+    }
+    auto ccode = staysOnTrue ? cmp->GetCondCode() : negateCondCode(cmp->GetCondCode());
+    auto *var = cmp->GetInput(0).GetInstruction();
+    auto *bound = cmp->GetInput(1).GetInstruction();
+    if (loop->FindInductionVariable(var) == nullptr) {
+        std::swap(var, bound);
+        ccode = mirrorCondCode(ccode);
+    }
+    if (loop->FindInductionVariable(var) != nullptr && !isInLoop(loop, bound->GetBasicBlock())) {
+        loop->SetExitTest({var, bound, ccode});
+    }
+}
+
+void InductionVariablesAnalysis::computeTripCount(Loop *loop) {
+    ASSERT(isInductionLoop(loop));
+    const auto *test = loop->GetExitTest();
+    if (test == nullptr) {
+        return;
+    }
+    const auto *var = loop->FindInductionVariable(test->var);
+    int64_t init = 0;
+    int64_t bound = 0;
+    auto type = test->var->GetType();
+    if (!IsSignedType(type) || !getConstant(var->init, init) || !getConstant(test->bound, bound)) {
+        return;
+    }
+    int64_t first = 0;
+    if (__builtin_mul_overflow(var->scale, init, &first) || __builtin_add_overflow(first, var->offset, &first)) {
+        return;
+    }
+    int64_t increment = 0;
+    if (__builtin_mul_overflow(var->scale, var->step, &increment)) {
+        return;
+    }
+    loop->SetTripCount(ComputeTripCount(first, increment, test->ccode, bound, type));
+}
+
+/* static */
+uint64_t InductionVariablesAnalysis::ComputeTripCount(int64_t first, int64_t step, CondCode ccode, int64_t bound,
+                                                      OperandType type) {
+    ASSERT(IsSignedType(type));
+    auto bits = GetTypeBitSize(type);
+    auto maxValue = static_cast<int64_t>(std::numeric_limits<uint64_t>::max() >> (65 - bits));
+    auto minValue = -maxValue - 1;
+    auto isInRange = [minValue, maxValue](int64_t value) { return minValue <= value && value <= maxValue; };
+    if (!isInRange(first) || !isInRange(bound) || step == 0) {
+        return 0;
+    }
+    if (!compare(ccode, first, bound)) {
+        return 1;
+    }
+
+    // decreasing values are handled as the negated increasing ones
+    auto normFirst = first;
+    auto normStep = step;
+    auto normBound = bound;
+    if (step < 0) {
+        if (__builtin_sub_overflow(0, first, &normFirst) || __builtin_sub_overflow(0, step, &normStep)
+                || __builtin_sub_overflow(0, bound, &normBound)) {
+            return 0;
+        }
+        ccode = mirrorCondCode(ccode);
+    }
+    int64_t diff = 0;
+    if (__builtin_sub_overflow(normBound, normFirst, &diff)) {
+        return 0;
+    }
+    // number of passed tests
+    int64_t count = 0;
+    switch (ccode) {
+    case CondCode::EQ:
+        count = 1;
+        break;
+    case CondCode::NE:
+        if (diff % normStep != 0 || diff / normStep <= 0) {
+            // the variable steps over the bound or moves away from it, and wraps
+            return 0;
+        }
+        count = diff / normStep;
+        break;
+    case CondCode::LT:
+        count = diff / normStep + (diff % normStep != 0);
+        break;
+    case CondCode::LE:
+        count = diff / normStep + 1;
+        break;
+    default:
+        // the variable moves away from the bound and wraps
+        return 0;
+    }
+
+    // the value failing the test must not wrap
+    int64_t last = 0;
+    if (__builtin_mul_overflow(count, step, &last) || __builtin_add_overflow(last, first, &last)
+            || !isInRange(last)) {
+        return 0;
+    }
+    return static_cast<uint64_t>(count) + 1;
+}
+}   // namespace ir
@@ -0,0 +1,46 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_INDUCTION_VARIABLES_ANALYSIS_H_
+#define JIT_AOT_COMPILERS_COURSE_INDUCTION_VARIABLES_ANALYSIS_H_
+
+#include "Loop.h"
+#include "PassBase.h"
+#include <vector>
+
+
+namespace ir {
+// Finds induction variables of reducible loops, the tests controlling exits
+// from the loops and their trip counts, and saves them into the loops.
+// Steps, scales and offsets of the variables must be constants.
+// The loops keep the results until the loop tree is rebuilt or the analysis is rerun,
+// and nothing marks them stale when updates or exit tests of the variables are edited,
+// so loop transformations must rerun the analysis after such edits.
+class InductionVariablesAnalysis final : public PassBase {
+public:
+    explicit InductionVariablesAnalysis(Graph *graph) : PassBase(graph), loops(GetScratchResource()) {}
+    NO_COPY_SEMANTIC(InductionVariablesAnalysis);
+    NO_MOVE_SEMANTIC(InductionVariablesAnalysis);
+    ~InductionVariablesAnalysis() noexcept override = default;
+
+    bool Run() override;
+
+    // Returns the number of executions of a test on the value, which is `first + k * step`
+    // on the k-th execution, until `value ccode bound` fails, or zero if it is unknown.
+    static uint64_t ComputeTripCount(int64_t first, int64_t step, CondCode ccode, int64_t bound,
+                                     OperandType type);
+
+private:
+    static bool isInductionLoop(const Loop *loop) {
+        return loop != nullptr && !loop->IsRoot() && !loop->IsIrreducible();
+    }
+
+    void findBasicVariables(Loop *loop);
+    static bool findStep(const Loop *loop, PhiInstruction *phi, InstructionBase *update, int64_t &step);
+    void findDerivedVariable(Loop *loop, InstructionBase *instr);
+    void findExitTest(Loop *loop);
+    void computeTripCount(Loop *loop);
+
+private:
+    std::pmr::vector<Loop *> loops;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_INDUCTION_VARIABLES_ANALYSIS_H_
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include "DomTree.h"
 #include "GraphChecker.h"
 #include "InstructionBuilder.h"
 #include "LinearOrdering.h"
 #include "LoopAnalyzer.h"
+#include <utility>
 
 
 namespace ir {
@@ -12,7 +14,7 @@ bool LinearOrdering::Run() {
 
     cfgChanged = false;
 
-    std::pmr::vector<BasicBlock *> newOrder(graph->GetMemoryResource());
+    std::pmr::vector<BasicBlock *> newOrder(GetScratchResource());
     newOrder.reserve(graph->GetBasicBlocksCount());
     orderBlocks(newOrder);
 
@@ -24,18 +26,13 @@ bool LinearOrdering::Run() {
 }
 
 void LinearOrdering::orderBlocks(std::pmr::vector<BasicBlock *> &newOrder) {
-    visitedMarker = graph->GetNewMarker();
+    MarkerHolder visited(graph);
+    visitedMarker = visited.GetMarker();
+    initForwardEdgesCounters();
 
-    std::pmr::list<BasicBlock *> remainedBlocks(graph->GetMemoryResource());
-    remainedBlocks.push_back(graph->GetFirstBasicBlock());
-
-    while (!remainedBlocks.empty()) {
-        auto *bblock = remainedBlocks.front();
-        ASSERT(bblock);
-        ASSERT(!isVisited(bblock));
-        remainedBlocks.pop_front();
-
-        bblock->SetMarker(visitedMarker);
+    nextBlock = graph->GetFirstBasicBlock();
+    for (auto *bblock = popNextBlock(); bblock != nullptr; bblock = popNextBlock()) {
+        setVisited(bblock);
         newOrder.push_back(bblock);
 
         auto &succs = bblock->GetSuccessors();
@@ -43,18 +40,16 @@ void LinearOrdering::orderBlocks(std::pmr::vector<BasicBlock *> &newOrder) {
             && !isVisited(succs[0])
             && !unvisitedForwardEdgesExist(succs[0]))
         {
-            remainedBlocks.push_front(succs[0]);
+            pushFront(succs[0]);
         } else if (succs.size() == 2) {
-            queueCond(remainedBlocks, bblock);
+            queueCond(bblock);
         }
     }
 
-    graph->ReleaseMarker(visitedMarker);
     visitedMarker = utils::to_underlying(MarkersConstants::UNDEF_VALUE);
 }
 
-void LinearOrdering::queueCond(std::pmr::list<BasicBlock *> &remainedBlocks,
-                               BasicBlock *bblock) {
+void LinearOrdering::queueCond(BasicBlock *bblock) {
     ASSERT(bblock);
     auto *loop = bblock->GetLoop();
     ASSERT(loop);
@@ -65,34 +60,66 @@ void LinearOrdering::queueCond(std::pmr::list<BasicBlock *> &remainedBlocks,
     ASSERT((trueBranch) && (falseBranch));
 
     if (isVisited(falseBranch) && isVisited(trueBranch)) {
-        remainedBlocks.push_front(insertJmpBlock(bblock, falseBranch));
+        pushFront(insertJmpBlock(bblock, falseBranch));
     } else if (mustInverseCondition(bblock)) {
         bblock->InverseConditionalBranch();
-        queueCond(remainedBlocks, bblock);
+        queueCond(bblock);
     } else {
         if (falseBranch->GetLoop() != loop) {
-            addIntoQueue(remainedBlocks, falseBranch);
+            addIntoQueue(falseBranch);
         } else {
-            remainedBlocks.push_front(falseBranch);
+            pushFront(falseBranch);
         }
-        addIntoQueue(remainedBlocks, trueBranch);
+        addIntoQueue(trueBranch);
     }
 }
 
-void LinearOrdering::addIntoQueue(std::pmr::list<BasicBlock *> &remainedBlocks,
-                                  BasicBlock *bblock) {
+void LinearOrdering::addIntoQueue(BasicBlock *bblock) {
+    ASSERT(bblock);
     if (isVisited(bblock) || unvisitedForwardEdgesExist(bblock)) {
         return;
     }
+    ASSERT(bblock->GetLoop());
+    if (nextBlock != nullptr && bblock->GetLoop()->IsIn(nextBlock->GetLoop())) {
+        // blocks of inner loops go before the following blocks of outer ones
+        pushFront(bblock);
+    } else {
+        pushIntoQueue(bblock, backSequence++);
+    }
+}
+
+void LinearOrdering::pushFront(BasicBlock *bblock) {
     ASSERT(bblock);
-    auto *loop = bblock->GetLoop();
+    if (nextBlock != nullptr) {
+        pushIntoQueue(nextBlock, --frontSequence);
+    }
+    nextBlock = bblock;
+}
+
+void LinearOrdering::pushIntoQueue(BasicBlock *bblock, int64_t sequence) {
+    ASSERT(bblock);
+    const auto *loop = bblock->GetLoop();
     ASSERT(loop);
-    auto insertPos = std::find_if(remainedBlocks.begin(),
-                                  remainedBlocks.end(),
-                                  [loop](const BasicBlock *b) {
-        return loop->IsIn(b->GetLoop());
-    });
-    remainedBlocks.insert(insertPos, bblock);
+    size_t depth = 0;
+    for (const auto *outer = loop->GetOuterLoop(); outer != nullptr; outer = outer->GetOuterLoop()) {
+        ++depth;
+    }
+    readyBlocks.push({depth, loop->GetId(), sequence, bblock});
+}
+
+BasicBlock *LinearOrdering::popNextBlock() {
+    if (nextBlock != nullptr) {
+        return std::exchange(nextBlock, nullptr);
+    }
+    while (!readyBlocks.empty()) {
+        auto *bblock = readyBlocks.top().bblock;
+        readyBlocks.pop();
+        // blocks, which have no forward edges, may be queued several times
+        if (!isVisited(bblock)) {
+            return bblock;
+        }
+    }
+    return nullptr;
 }
 
 // Utility function used to place false successor immediately after conditional branch
@@ -116,22 +143,40 @@ bool LinearOrdering::mustInverseCondition(BasicBlock *bblock) {
             && !unvisitedForwardEdgesExist(trueBranch));
 }
 
-bool LinearOrdering::unvisitedForwardEdgesExist(BasicBlock *bblock) {
-    ASSERT(bblock);
-    if (bblock->GetLoop()->IsIrreducible()) {
+void LinearOrdering::initForwardEdgesCounters() {
+    forwardEdgesCounters.Clear();
+    forwardEdgesCounters.Reserve(graph->GetMaximumBlockId() + 1);
+    graph->ForEachBasicBlock([this](BasicBlock *bblock) {
+        auto count = std::ranges::count_if(bblock->GetPredecessors(), [bblock](const BasicBlock *pred) {
+            return isForwardEdge(pred, bblock);
+        });
+        forwardEdgesCounters.Insert(bblock->GetId(), static_cast<size_t>(count));
+    });
+}
+
+/* static */
+bool LinearOrdering::isForwardEdge(const BasicBlock *pred, const BasicBlock *succ) {
+    ASSERT((pred) && (succ));
+    // all predecessors must come before the block, except for back edges' sources
+    if (succ->GetLoop()->IsIrreducible()) {
         return false;
     }
+    return !succ->IsLoopHeader() || !succ->Dominates(pred);
+}
 
-    // here we ensure that all predecessors come before the given block
-    auto preds = bblock->GetPredecessors();
-    if (!bblock->IsLoopHeader()) {
-        return std::any_of(preds.begin(), preds.end(), [this](auto pred) {
-            return !isVisited(pred);
-        });
+void LinearOrdering::setVisited(BasicBlock *bblock) {
+    ASSERT((bblock) && !isVisited(bblock));
+    bblock->SetMarker(visitedMarker);
+    for (auto *succ : bblock->GetSuccessors()) {
+        if (isVisited(succ) || !isForwardEdge(bblock, succ)) {
+            continue;
+        }
+        auto *counter = forwardEdgesCounters.Find(succ->GetId());
+        if (counter != nullptr) {
+            ASSERT(*counter != 0);
+            --(*counter);
+        }
     }
-    return std::any_of(preds.begin(), preds.end(), [bblock, this](auto pred) {
-        return !bblock->Dominates(pred) && !isVisited(pred);
-    });
 }
 
 BasicBlock *LinearOrdering::insertJmpBlock(BasicBlock *pred, BasicBlock *succ) {
@@ -151,6 +196,7 @@ void LinearOrdering::setNewOrder(std::pmr::vector<BasicBlock *> &&newOrder) {
         newOrder[i]->SetId(i);
     }
 
+    // the order is copied into graph's memory
     graph->bblocks = std::move(newOrder);
     graph->unlinkedInstructionsCounter = 0;
 }
@@ -158,6 +204,7 @@ void LinearOrdering::setNewOrder(std::pmr::vector<BasicBlock *> &&newOrder) {
 void LinearOrdering::postOrder() {
     ASSERT(PassManager::Run<GraphChecker>(graph));
 
-    PassManager::SetInvalid<AnalysisFlag::DOM_TREE, AnalysisFlag::RPO>(graph);
+    // inserted blocks split edges, so the dominators tree is kept valid by the graph
+    PassManager::SetInvalid<AnalysisFlag::RPO>(graph);
 }
 }   // namespace ir
@@ -1,14 +1,21 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_LINEAR_ORDERING_H_
 #define JIT_AOT_COMPILERS_COURSE_LINEAR_ORDERING_H_
 
-#include <list>
+#include <cstdint>
+#include "IdMap.h"
 #include "PassBase.h"
+#include <queue>
+#include <tuple>
 
 
 namespace ir {
 class LinearOrdering final : public PassBase {
 public:
-    explicit LinearOrdering(Graph *graph) : PassBase(graph) {}
+    explicit LinearOrdering(Graph *graph)
+        : PassBase(graph),
+          forwardEdgesCounters(GetScratchResource()),
+          readyBlocks(std::less<QueueEntry>(), std::pmr::vector<QueueEntry>(GetScratchResource()))
+    {}
     NO_COPY_SEMANTIC(LinearOrdering);
     NO_MOVE_SEMANTIC(LinearOrdering);
     ~LinearOrdering() noexcept override = default;
@@ -19,19 +26,47 @@ public:
     static constexpr AnalysisFlag SET_FLAG = AnalysisFlag::LINEAR_ORDERING;
 
 private:
+    // Blocks ready to be placed are ordered by depth of their loops, so that inner loops
+    // are completed before blocks of outer loops are placed, then grouped by loops.
+    struct QueueEntry {
+        size_t loopDepth;
+        size_t loopId;
+        // order of insertion, blocks pushed to the front get negative numbers
+        int64_t sequence;
+        BasicBlock *bblock;
+
+        // the greatest entry is popped first
+        bool operator<(const QueueEntry &other) const {
+            return std::tie(loopDepth, other.loopId, other.sequence)
+                < std::tie(other.loopDepth, loopId, sequence);
+        }
+    };
+
     void orderBlocks(std::pmr::vector<BasicBlock *> &newOrder);
 
-    void queueCond(std::pmr::list<BasicBlock *> &remainedBlocks, BasicBlock *bblock);
-    void addIntoQueue(std::pmr::list<BasicBlock *> &remainedBlocks, BasicBlock *bblock);
+    void queueCond(BasicBlock *bblock);
+    void addIntoQueue(BasicBlock *bblock);
+    // Places the block right after the current one.
+    void pushFront(BasicBlock *bblock);
+    void pushIntoQueue(BasicBlock *bblock, int64_t sequence);
+    BasicBlock *popNextBlock();
 
     bool mustInverseCondition(BasicBlock *bblock);
-    bool unvisitedForwardEdgesExist(BasicBlock *bblock);
+
+    void initForwardEdgesCounters();
+    static bool isForwardEdge(const BasicBlock *pred, const BasicBlock *succ);
+    bool unvisitedForwardEdgesExist(const BasicBlock *bblock) const {
+        ASSERT(bblock);
+        const auto *counter = forwardEdgesCounters.Find(bblock->GetId());
+        return counter != nullptr && *counter != 0;
+    }
 
     BasicBlock *insertJmpBlock(BasicBlock *pred, BasicBlock *succ);
 
     void setNewOrder(std::pmr::vector<BasicBlock *> &&newOrder);
     void postOrder();
 
+    void setVisited(BasicBlock *bblock);
     bool isVisited(const BasicBlock *bblock) const {
         ASSERT(bblock);
         return bblock->IsMarkerSet(visitedMarker);
@@ -40,6 +75,14 @@ private:
 private:
     Marker visitedMarker = utils::to_underlying(MarkersConstants::UNDEF_VALUE);
     bool cfgChanged = false;
+
+    // numbers of forward edges from unvisited predecessors
+    IdMap<size_t> forwardEdgesCounters;
+
+    BasicBlock *nextBlock = nullptr;
+    std::priority_queue<QueueEntry, std::pmr::vector<QueueEntry>> readyBlocks;
+    int64_t backSequence = 0;
+    int64_t frontSequence = 0;
 };
 }   // namespace ir
 
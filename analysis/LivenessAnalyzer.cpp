@@ -62,9 +62,9 @@ void LivenessAnalyzer::calculateLiveRanges(BasicBlock::IdType blockId) {
 
     calculateInitialLiveSet(bblock, info);
 
-    for (auto *instr : liveSet) {
-        liveIntervals.GetLiveIntervals(instr)->AddRange(blockRange);
-    }
+    liveSet.ForEach([&liveIntervals, blockRange](size_t number) {
+        liveIntervals[number]->AddRange(blockRange);
+    });
 
     auto blockRangeBegin = blockRange.GetBegin();
     // reverse order instructions
@@ -80,11 +80,12 @@ void LivenessAnalyzer::calculateLiveRanges(BasicBlock::IdType blockId) {
         if (!instr->HasInputs()) {
             continue;
         }
-        auto *withInputs = instr->AsInputsInstruction();
-        for (size_t i = 0, end = withInputs->GetInputsCount(); i < end; ++i) {
-            auto *input = withInputs->GetInput(i).GetInstruction();
+        for (auto &in : instr->AsInputsInstruction()->GetInputs()) {
+            auto *input = in.GetInstruction();
             liveSet.Add(input);
-            liveIntervals.GetLiveIntervals(input)->AddRange(blockRangeBegin, liveNumber);
+            auto *inputIntervals = liveIntervals.GetLiveIntervals(input);
+            inputIntervals->AddRange(blockRangeBegin, liveNumber);
+            inputIntervals->AddUsePosition(liveNumber, true);
         }
     }
 
@@ -93,18 +94,50 @@ void LivenessAnalyzer::calculateLiveRanges(BasicBlock::IdType blockId) {
     }
 
     if (bblock->IsLoopHeader()) {
-        auto *loopInfo = bblock->GetLoop();
-        ASSERT(loopInfo);
+        // values live at the loop's header are live along the whole loop (Wimmer & Franz),
+        // as they are used on the next iterations
+        auto loopRange = getLoopRange(bblock->GetLoop());
+        liveSet.ForEach([&liveIntervals, loopRange](size_t number) {
+            liveIntervals[number]->AddRange(loopRange);
+        });
     }
 }
 
+LiveRange LivenessAnalyzer::getLoopRange(const Loop *loop) {
+    ASSERT((loop) && !loop->IsRoot());
+    auto begin = getBlockInfo(loop->GetHeader()).GetRange().GetBegin();
+    auto end = begin;
+    auto extendRange = [this, &begin, &end](const BasicBlock *bblock) {
+        const auto &range = getBlockInfo(bblock).GetRange();
+        begin = std::min(begin, range.GetBegin());
+        end = std::max(end, range.GetEnd());
+    };
+
+    loopsStack.clear();
+    loopsStack.push_back(loop);
+    while (!loopsStack.empty()) {
+        const auto *current = loopsStack.back();
+        loopsStack.pop_back();
+        std::ranges::for_each(current->GetBasicBlocks(), extendRange);
+        // bodies of irreducible loops are not collected, so back edges' sources bound them
+        std::ranges::for_each(current->GetBackEdges(), extendRange);
+        loopsStack.insert(loopsStack.end(), current->GetInnerLoops().begin(), current->GetInnerLoops().end());
+    }
+    return {begin, end};
+}
+
 void LivenessAnalyzer::calculateInitialLiveSet(BasicBlock *bblock, BlockInfo &info) const {
+    auto &liveIntervals = graph->GetLiveIntervals();
     auto &liveSet = info.GetLiveIn();
+    auto blockRangeEnd = info.GetRange().GetEnd();
     // union of successors' liveIn sets + successors' corresponding edges' PHIs' inputs
     for (auto *succ : bblock->GetSuccessors()) {
         liveSet.Union(getBlockInfo(succ).GetLiveIn());
         for (auto *phi : succ->IteratePhi()) {
-            liveSet.Add(phi->ResolveInput(bblock).GetInstruction());
+            auto *input = phi->ResolveInput(bblock).GetInstruction();
+            liveSet.Add(input);
+            // inputs of PHIs are moved at the end of the block and may reside in memory
+            liveIntervals.GetLiveIntervals(input)->AddUsePosition(blockRangeEnd, false);
         }
     }
 }
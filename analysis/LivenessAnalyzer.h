@@ -11,7 +11,8 @@ class LivenessAnalyzer : public PassBase {
 public:
     explicit LivenessAnalyzer(Graph *graph)
         : PassBase(graph),
-          linearOrderedBlocks(graph->GetMemoryResource())
+          linearOrderedBlocks(GetScratchResource()),
+          loopsStack(GetScratchResource())
     {}
     NO_COPY_SEMANTIC(LivenessAnalyzer);
     NO_MOVE_SEMANTIC(LivenessAnalyzer);
@@ -29,6 +30,8 @@ private:
 
     void calculateLiveRanges(BasicBlock::IdType blockId);
     void calculateInitialLiveSet(BasicBlock *bblock, BlockInfo &info) const;
+    // Returns the range covering all blocks of the loop, including inner loops.
+    LiveRange getLoopRange(const Loop *loop);
 
     BlockInfo &getBlockInfo(BasicBlock *bblock) {
         ASSERT((bblock) && bblock->GetId() < linearOrderedBlocks.size());
@@ -43,6 +46,7 @@ private:
 
 private:
     std::pmr::vector<BlockInfo> linearOrderedBlocks;
+    std::pmr::vector<const Loop *> loopsStack;
 
     LiveRange::RangeType rangeBegin = 0;
 };
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include "DomTree.h"
 #include "LoopAnalyzer.h"
 #include "Traversals.h"
+#include <utility>
 
 
 namespace ir {
@@ -10,11 +12,10 @@ bool LoopAnalyzer::Run() {
         PassManager::Run<DomTreeBuilder>(graph);
 
         collectBackEdges();
-        graph->ReleaseMarker(greyMarker);
-        graph->ReleaseMarker(blackMarker);
 
         populateLoops();
         buildLoopTree();
+        computeLoopsInfo();
     }
     return true;
 }
@@ -23,17 +24,22 @@ void LoopAnalyzer::resetStructs() {
     blockId = 0;
     dfsBlocks.resize(graph->GetBasicBlocksCount(), nullptr);
     loops.clear();
-    greyMarker = graph->GetNewMarker();
-    blackMarker = graph->GetNewMarker();
+    // loops found by the previous run are not valid anymore
+    graph->ForEachBasicBlock([](BasicBlock *bblock) { bblock->SetLoop(nullptr); });
 }
 
 void LoopAnalyzer::collectBackEdges() {
     ASSERT(graph);
+    MarkerHolder grey(graph);
+    MarkerHolder black(graph);
+    greyMarker = grey.GetMarker();
+    blackMarker = black.GetMarker();
     dfsBackEdgesSearch(graph->GetFirstBasicBlock());
     ASSERT(blockId == graph->GetBasicBlocksCount());
 }
 
 void LoopAnalyzer::populateLoops() {
+    MarkerHolder visited(graph);
     for (auto *bblock : dfsBlocks) {
         auto *loop = bblock->GetLoop();
         if (loop == nullptr || loop->GetHeader() != bblock) {
@@ -47,6 +53,9 @@ void LoopAnalyzer::populateLoops() {
                 }
             }
         } else {
+            // blocks visited while populating the previous loop must be visited again
+            visited.Reset();
+            blackMarker = visited.GetMarker();
             populateReducibleLoop(loop);
         }
     }
@@ -71,21 +80,42 @@ void LoopAnalyzer::buildLoopTree() {
     graph->SetLoopTree(rootLoop);
 }
 
+void LoopAnalyzer::computeLoopsInfo() {
+    computeDepths();
+    for (auto *loop : loops) {
+        if (!loop->IsRoot() && !loop->IsIrreducible()) {
+            loop->SetPreHeader(findPreHeader(loop));
+        }
+    }
+    for (auto *bblock : dfsBlocks) {
+        addExits(bblock);
+    }
+}
+
 void LoopAnalyzer::dfsBackEdgesSearch(BasicBlock *bblock) {
-    ASSERT(bblock);
+    ASSERT((bblock) && dfsStack.empty());
 
     bblock->SetMarker(greyMarker);
-    for (auto *succ : bblock->GetSuccessors()) {
+    dfsStack.emplace_back(bblock, 0);
+    while (!dfsStack.empty()) {
+        auto [current, succIdx] = dfsStack.back();
+        const auto &succs = current->GetSuccessors();
+        if (succIdx == succs.size()) {
+            dfsStack.pop_back();
+            current->ClearMarker(greyMarker);
+            current->SetMarker(blackMarker);
+            dfsBlocks[blockId++] = current;
+            continue;
+        }
+        ++dfsStack.back().second;
+        auto *succ = succs[succIdx];
         if (succ->IsMarkerSet(greyMarker)) {
-            addLoopInfo(succ, bblock);
+            addLoopInfo(succ, current);
         } else if (!succ->IsMarkerSet(blackMarker)) {
-            dfsBackEdgesSearch(succ);
+            succ->SetMarker(greyMarker);
+            dfsStack.emplace_back(succ, 0);
         }
     }
-    bblock->ClearMarker(greyMarker);
-    bblock->SetMarker(blackMarker);
-
-    dfsBlocks[blockId++] = bblock;
 }
 
 void LoopAnalyzer::addLoopInfo(BasicBlock *header, BasicBlock *backEdgeSource) {
@@ -108,22 +138,33 @@ void LoopAnalyzer::addLoopInfo(BasicBlock *header, BasicBlock *backEdgeSource) {
 
 void LoopAnalyzer::populateReducibleLoop(Loop *loop) {
     ASSERT(loop);
-    blackMarker = graph->GetNewMarker();
     loop->GetHeader()->SetMarker(blackMarker);
     for (auto *backEdgeSource : loop->GetBackEdges()) {
         dfsPopulateLoops(loop, backEdgeSource);
     }
-    graph->ReleaseMarker(blackMarker);
 }
 
 void LoopAnalyzer::dfsPopulateLoops(Loop *loop, BasicBlock *bblock) {
-    ASSERT((loop) && (bblock));
-    if (bblock->IsMarkerSet(blackMarker)) {
-        return;
+    ASSERT((loop) && (bblock) && populateStack.empty());
+    // predecessors are pushed in reverse order and checked when popped,
+    // so blocks are visited in the same order as by the recursive search
+    populateStack.push_back(bblock);
+    while (!populateStack.empty()) {
+        auto *current = populateStack.back();
+        populateStack.pop_back();
+        if (current->IsMarkerSet(blackMarker)) {
+            continue;
+        }
+        current->SetMarker(blackMarker);
+        addBlockIntoLoop(loop, current);
+
+        const auto &preds = current->GetPredecessors();
+        populateStack.insert(populateStack.end(), preds.rbegin(), preds.rend());
     }
-    bblock->SetMarker(blackMarker);
+}
 
-    auto *blockLoop = bblock->GetLoop();    
+void LoopAnalyzer::addBlockIntoLoop(Loop *loop, BasicBlock *bblock) {
+    auto *blockLoop = bblock->GetLoop();
     if (blockLoop == nullptr) {
         loop->AddBasicBlock(bblock);
     } else if (blockLoop->GetId() != loop->GetId() &&
@@ -131,9 +172,57 @@ void LoopAnalyzer::dfsPopulateLoops(Loop *loop, BasicBlock *bblock) {
         blockLoop->SetOuterLoop(loop);
         loop->AddInnerLoop(blockLoop);
     }
+}
+
+void LoopAnalyzer::computeDepths() {
+    ASSERT(loopsStack.empty());
+    loopsStack.push_back(graph->GetLoopTree());
+    while (!loopsStack.empty()) {
+        auto *loop = loopsStack.back();
+        loopsStack.pop_back();
+        for (auto *inner : loop->GetInnerLoops()) {
+            inner->SetDepth(loop->GetDepth() + 1);
+            loopsStack.push_back(inner);
+        }
+    }
+}
 
-    for (auto *pred : bblock->GetPredecessors()) {
-        dfsPopulateLoops(loop, pred);
+void LoopAnalyzer::addExits(BasicBlock *bblock) {
+    ASSERT((bblock) && (bblock->GetLoop()));
+    for (auto *succ : bblock->GetSuccessors()) {
+        auto *succLoop = succ->GetLoop();
+        ASSERT(succLoop);
+        // the edge leaves all loops of the block, which do not contain the successor
+        for (auto *loop = bblock->GetLoop(); !loop->IsRoot(); loop = loop->GetOuterLoop()) {
+            if (succLoop == loop || succLoop->IsIn(loop)) {
+                break;
+            }
+            if (!loop->IsIrreducible()) {
+                loop->AddExit(bblock, succ);
+            }
+        }
+    }
+}
+
+/* static */
+BasicBlock *LoopAnalyzer::findPreHeader(Loop *loop) {
+    ASSERT((loop) && !loop->IsRoot());
+    const auto &backEdges = std::as_const(*loop).GetBackEdges();
+    BasicBlock *preHeader = nullptr;
+    for (auto *pred : loop->GetHeader()->GetPredecessors()) {
+        // unreachable predecessors are not assigned to loops
+        if (pred->GetLoop() == nullptr || std::ranges::find(backEdges, pred) != backEdges.end()) {
+            continue;
+        }
+        if (preHeader != nullptr) {
+            return nullptr;
+        }
+        preHeader = pred;
+    }
+    // the first block must contain only arguments and constants
+    if (preHeader == nullptr || preHeader->IsFirstInGraph() || preHeader->GetSuccessorsCount() != 1) {
+        return nullptr;
     }
+    return preHeader;
 }
 }   // namespace ir
@@ -3,16 +3,22 @@
 
 #include "Loop.h"
 #include "PassBase.h"
+#include <utility>
 #include <vector>
 
 
 namespace ir {
+// Builds the loop tree and computes depths, preheaders and exits of the loops.
+// Exits are not computed for irreducible loops, as their bodies are not collected.
 class LoopAnalyzer : public PassBase {
 public:
     explicit LoopAnalyzer(Graph *graph)
         : PassBase(graph),
-          dfsBlocks(graph->GetMemoryResource()),
-          loops(graph->GetMemoryResource())
+          dfsBlocks(GetScratchResource()),
+          dfsStack(GetScratchResource()),
+          populateStack(GetScratchResource()),
+          loops(GetScratchResource()),
+          loopsStack(GetScratchResource())
     {}
     NO_COPY_SEMANTIC(LoopAnalyzer);
     NO_MOVE_SEMANTIC(LoopAnalyzer);
@@ -29,12 +35,18 @@ private:
     void collectBackEdges();
     void populateLoops();
     void buildLoopTree();
+    void computeLoopsInfo();
 
     void dfsBackEdgesSearch(BasicBlock *bblock);
     void addLoopInfo(BasicBlock *header, BasicBlock *backEdgeSource);
 
     void populateReducibleLoop(Loop *loop);
     void dfsPopulateLoops(Loop *loop, BasicBlock *bblock);
+    void addBlockIntoLoop(Loop *loop, BasicBlock *bblock);
+
+    void computeDepths();
+    void addExits(BasicBlock *bblock);
+    static BasicBlock *findPreHeader(Loop *loop);
 
     static bool isLoopIrreducible(const BasicBlock *header, const BasicBlock *backEdgeSource) {
         return !header->Dominates(backEdgeSource);
@@ -47,7 +59,13 @@ private:
     size_t blockId = 0;
     std::pmr::vector<BasicBlock *> dfsBlocks;
 
+    // explicit stacks of the depth-first searches:
+    // blocks with indices of their next successors and blocks to be added into loops
+    std::pmr::vector<std::pair<BasicBlock *, size_t>> dfsStack;
+    std::pmr::vector<BasicBlock *> populateStack;
+
     std::pmr::vector<Loop *> loops;
+    std::pmr::vector<Loop *> loopsStack;
 };
 }   // namespace ir
 
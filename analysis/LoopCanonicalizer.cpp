@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <iterator>
+#include "LoopAnalyzer.h"
+#include "LoopCanonicalizer.h"
+#include <utility>
+
+
+namespace ir {
+bool LoopCanonicalizer::Run() {
+    if (graph->IsEmpty()) {
+        return true;
+    }
+    PassManager::Run<LoopAnalyzer>(graph);
+
+    collectLoops();
+    bool changed = false;
+    for (auto *loop : loops) {
+        if (isCanonical(loop)) {
+            continue;
+        }
+        if (loop->GetPreHeader() == nullptr) {
+            insertPreHeader(loop);
+        }
+        if (loop->GetLatch() == nullptr) {
+            insertLatch(loop);
+        }
+        changed = true;
+    }
+    if (!changed) {
+        return true;
+    }
+
+    // exits and blocks of loops are found again on the modified CFG
+    PassManager::Run<LoopAnalyzer>(graph);
+    collectLoops();
+    ASSERT(std::ranges::all_of(loops, isCanonical));
+    return true;
+}
+
+void LoopCanonicalizer::collectLoops() {
+    loops.clear();
+    loops.push_back(graph->GetLoopTree());
+    for (size_t i = 0; i < loops.size(); ++i) {
+        const auto &inner = loops[i]->GetInnerLoops();
+        loops.insert(loops.end(), inner.begin(), inner.end());
+    }
+}
+
+void LoopCanonicalizer::insertPreHeader(Loop *loop) {
+    ASSERT(loop);
+    auto *header = loop->GetHeader();
+    const auto &backEdges = std::as_const(*loop).GetBackEdges();
+    preds.clear();
+    std::ranges::copy_if(header->GetPredecessors(), std::back_inserter(preds), [&backEdges](auto *pred) {
+        return std::ranges::find(backEdges, pred) == backEdges.end();
+    });
+    ASSERT(!preds.empty());
+
+    auto *preHeader = graph->CreateEmptyBasicBlock();
+    graph->InsertBefore(preHeader, header, preds);
+}
+
+void LoopCanonicalizer::insertLatch(Loop *loop) {
+    ASSERT(loop && loop->GetBackEdgesCount() > 1);
+    const auto &backEdges = std::as_const(*loop).GetBackEdges();
+    preds.assign(backEdges.begin(), backEdges.end());
+    auto *latch = graph->CreateEmptyBasicBlock();
+    graph->InsertBefore(latch, loop->GetHeader(), preds);
+}
+}   // namespace ir
@@ -0,0 +1,43 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_LOOP_CANONICALIZER_H_
+#define JIT_AOT_COMPILERS_COURSE_LOOP_CANONICALIZER_H_
+
+#include "Loop.h"
+#include "PassBase.h"
+#include <vector>
+
+
+namespace ir {
+// Inserts blocks into CFG, so that each reducible loop has a dedicated preheader
+// and a single latch. Dominators tree is updated incrementally and loop analysis
+// is valid after the pass.
+class LoopCanonicalizer final : public PassBase {
+public:
+    explicit LoopCanonicalizer(Graph *graph)
+        : PassBase(graph),
+          loops(GetScratchResource()),
+          preds(GetScratchResource())
+    {}
+    NO_COPY_SEMANTIC(LoopCanonicalizer);
+    NO_MOVE_SEMANTIC(LoopCanonicalizer);
+    ~LoopCanonicalizer() noexcept override = default;
+
+    bool Run() override;
+
+private:
+    void collectLoops();
+    static bool isCanonical(const Loop *loop) {
+        return loop->IsRoot() || loop->IsIrreducible()
+            || (loop->GetPreHeader() != nullptr && loop->GetLatch() != nullptr);
+    }
+
+    void insertPreHeader(Loop *loop);
+    void insertLatch(Loop *loop);
+
+private:
+    std::pmr::vector<Loop *> loops;
+    // predecessors of a header redirected into a new block
+    std::pmr::vector<BasicBlock *> preds;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_LOOP_CANONICALIZER_H_
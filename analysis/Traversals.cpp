@@ -26,7 +26,8 @@ void dumpBasicBlock(const BasicBlock *bblock) {
 
 void DumpGraphRPO(const Graph *graph) {
     // run RPO regardless of RPO contained in graph due to possible code errors
-    auto rpoBBlocks = RPO::DoRPO(graph);
+    utils::ScratchScope scratch;
+    auto rpoBBlocks = RPO::DoRPO(graph, scratch.GetArena());
     std::cout << "======================================\n";
     for (auto bblock : rpoBBlocks) {
         dumpBasicBlock(bblock);
@@ -4,6 +4,7 @@
 #include "BasicBlock.h"
 #include <functional>
 #include "PassBase.h"
+#include <utility>
 #include <vector>
 
 
@@ -44,39 +45,49 @@ public:
 
 private:
     DFO(const Graph *graph) : markerMgr(graph) {}
-    DEFAULT_COPY_SEMANTIC(DFO);
-    DEFAULT_MOVE_SEMANTIC(DFO);
+    NO_COPY_SEMANTIC(DFO);
+    NO_MOVE_SEMANTIC(DFO);
     DEFAULT_DTOR(DFO);
 
+    // Traverses blocks on an explicit stack, which keeps the visited block
+    // and the index of its next successor, so that deep graphs cannot overflow the call stack.
     template <typename BBlockT, ValidCallback CallbackT>
     void doTraverse(BBlockT *bblock, CallbackT callback)
     requires std::is_same_v<std::remove_cv_t<BBlockT>, BasicBlock>
-    {
-        visitedCounter = 0;
-        auto visited = markerMgr->GetNewMarker();
-        traverseImpl(bblock, visited, callback);
-        markerMgr->ReleaseMarker(visited);
-    }
-
-    template <typename BBlockT, ValidCallback CallbackT>
-    void traverseImpl(BBlockT *bblock, Marker visited, CallbackT callback)
-    requires std::is_same_v<std::remove_cv_t<BBlockT>, BasicBlock>
     {
         ASSERT(bblock);
-        ++visitedCounter;
-        bblock->SetMarker(visited);
-        for (auto *succ : bblock->GetSuccessors()) {
-            ASSERT(succ->HasPredecessor(bblock));
+        visitedCounter = 0;
+        MarkerHolder visited(markerMgr);
+        std::pmr::vector<std::pair<BBlockT *, size_t>> stack(scratch.GetArena());
+        auto visit = [this, &stack, marker = visited.GetMarker()](BBlockT *block) {
+            ++visitedCounter;
+            block->SetMarker(marker);
+            stack.emplace_back(block, 0);
+        };
+
+        visit(bblock);
+        while (!stack.empty()) {
+            auto [current, succIdx] = stack.back();
+            const auto &succs = current->GetSuccessors();
+            if (succIdx == succs.size()) {
+                stack.pop_back();
+                callback(current);
+                continue;
+            }
+            ++stack.back().second;
+            auto *succ = succs[succIdx];
+            ASSERT(succ->HasPredecessor(current));
             if (!succ->IsMarkerSet(visited)) {
-                traverseImpl(succ, visited, callback);
+                visit(succ);
             }
         }
-        callback(bblock);
     }
 
 private:
     const MarkerManager *markerMgr;
     size_t visitedCounter;
+
+    utils::ScratchScope scratch;
 };
 
 // concepts and helpers
@@ -101,14 +112,15 @@ public:
     ~RPO() noexcept override = default;
 
     bool Run() override {
-        graph->SetRPO(DoRPO(graph));
+        graph->SetRPO(DoRPO(graph, GetScratchResource()));
         return true;
     }
 
     template <GraphType GraphT>
-    static std::pmr::vector<BasicBlockType<GraphT> *> DoRPO(GraphT *graph) {
-        ASSERT(graph);
-        std::pmr::vector<BasicBlockType<GraphT> *> result(graph->GetMemoryResource());
+    static std::pmr::vector<BasicBlockType<GraphT> *> DoRPO(GraphT *graph,
+                                                            std::pmr::memory_resource *mem) {
+        ASSERT((graph) && (mem));
+        std::pmr::vector<BasicBlockType<GraphT> *> result(mem);
         if (graph->IsEmpty()) {
             return result;
         }
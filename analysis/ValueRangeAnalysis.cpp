@@ -0,0 +1,415 @@
+#include <array>
+#include "DomTree.h"
+#include "InstructionBuilder.h"
+#include "Traversals.h"
+#include "ValueRangeAnalysis.h"
+
+
+namespace ir {
+static ValueRange fitIntoType(const ValueRange &range, OperandType type) {
+    auto full = ValueRange::Full(type);
+    return full.Contains(range) ? range : full;
+}
+
+// Applies the operation, which is monotonic in each argument, to bounds of the ranges.
+// Returns the full range if the operation may overflow.
+template <typename OperationT>
+static ValueRange applyToBounds(const ValueRange &lhs, const ValueRange &rhs, OperandType type,
+                                OperationT operation)
+{
+    std::array<std::pair<int64_t, int64_t>, 4> bounds{
+        std::pair{lhs.min, rhs.min}, {lhs.min, rhs.max}, {lhs.max, rhs.min}, {lhs.max, rhs.max}
+    };
+    ValueRange result;
+    for (auto [x, y] : bounds) {
+        int64_t value = 0;
+        if (operation(x, y, &value)) {
+            return ValueRange::Full(type);
+        }
+        result = result.Join(ValueRange::Single(value));
+    }
+    return fitIntoType(result, type);
+}
+
+static bool addBounds(int64_t lhs, int64_t rhs, int64_t *result) {
+    return __builtin_add_overflow(lhs, rhs, result);
+}
+
+static bool subBounds(int64_t lhs, int64_t rhs, int64_t *result) {
+    return __builtin_sub_overflow(lhs, rhs, result);
+}
+
+static bool mulBounds(int64_t lhs, int64_t rhs, int64_t *result) {
+    return __builtin_mul_overflow(lhs, rhs, result);
+}
+
+// Divisors must be positive.
+static bool divBounds(int64_t lhs, int64_t rhs, int64_t *result) {
+    ASSERT(rhs > 0);
+    *result = lhs / rhs;
+    return false;
+}
+
+/* static */
+ValueRange ValueRange::Full(OperandType type) {
+    auto shift = GetTypeBitSize(type) - 1;
+    auto max = static_cast<int64_t>((uint64_t(1) << shift) - 1);
+    return {-max - 1, max};
+}
+
+ValueRange ValueRange::Narrow(CondCode ccode, const ValueRange &bound) const {
+    if (IsEmpty() || bound.IsEmpty()) {
+        return Empty();
+    }
+    switch (ccode) {
+    case CondCode::EQ:
+        return Intersect(bound);
+    case CondCode::NE:
+        if (!bound.IsSingle()) {
+            return *this;
+        }
+        if (IsSingle()) {
+            return min == bound.min ? Empty() : *this;
+        }
+        if (min == bound.min) {
+            return {min + 1, max};
+        }
+        return max == bound.min ? ValueRange{min, max - 1} : *this;
+    case CondCode::LT:
+        if (bound.max == std::numeric_limits<int64_t>::min()) {
+            return Empty();
+        }
+        return {min, std::min(max, bound.max - 1)};
+    case CondCode::LE:
+        return {min, std::min(max, bound.max)};
+    case CondCode::GE:
+        return {std::max(min, bound.min), max};
+    case CondCode::GT:
+        if (bound.min == std::numeric_limits<int64_t>::max()) {
+            return Empty();
+        }
+        return {std::max(min, bound.min + 1), max};
+    default:
+        UNREACHABLE("unexpected condition code");
+        return *this;
+    }
+}
+
+/* static */
+bool ValueRange::AlwaysHolds(CondCode ccode, const ValueRange &lhs, const ValueRange &rhs) {
+    if (lhs.IsEmpty() || rhs.IsEmpty()) {
+        return false;
+    }
+    switch (ccode) {
+    case CondCode::EQ:
+        return lhs.IsSingle() && lhs == rhs;
+    case CondCode::NE:
+        return lhs.max < rhs.min || rhs.max < lhs.min;
+    case CondCode::LT:
+        return lhs.max < rhs.min;
+    case CondCode::LE:
+        return lhs.max <= rhs.min;
+    case CondCode::GE:
+        return lhs.min >= rhs.max;
+    case CondCode::GT:
+        return lhs.min > rhs.max;
+    default:
+        UNREACHABLE("unexpected condition code");
+        return false;
+    }
+}
+
+bool ValueRangeAnalysis::Run() {
+    if (graph->IsEmpty()) {
+        return true;
+    }
+    PassManager::Run<RPO>(graph);
+    PassManager::Run<DomTreeBuilder>(graph);
+
+    initialize();
+    for (size_t i = 0; iterate(false, i >= FORCED_WIDENING_ITERATIONS); ++i) {}
+    for (size_t i = 0; i < NARROWING_ITERATIONS && iterate(true, false); ++i) {}
+    return true;
+}
+
+ValueRange ValueRangeAnalysis::GetRange(const InstructionBase *value) const {
+    ASSERT((value) && isIntegerValue(value));
+    const auto *range = ranges.Find(value->GetId());
+    return range ? *range : ValueRange::Full(getValueType(value));
+}
+
+ValueRange ValueRangeAnalysis::GetRange(const InstructionBase *value, const BasicBlock *bblock) const {
+    ASSERT(bblock);
+    auto range = GetRange(value);
+    // conditions in dominators of the value's block cannot compare the value
+    const auto *definition = value->GetBasicBlock();
+    for (const auto *current = bblock; current != nullptr && current != definition;
+         current = current->GetDominator())
+    {
+        if (current->GetPredecessorsCount() == 1) {
+            range = narrowOnEdge(value, range, current->GetPredecessors()[0], current);
+        }
+    }
+    return range;
+}
+
+ValueRange ValueRangeAnalysis::GetRange(const InstructionBase *value,
+                                        const BasicBlock *pred,
+                                        const BasicBlock *succ) const
+{
+    ASSERT((pred) && (succ));
+    return narrowOnEdge(value, GetRange(value, pred), pred, succ);
+}
+
+ValueRange ValueRangeAnalysis::GetArrayLength(const InstructionBase *array) const {
+    ASSERT((array) && array->GetType() == OperandType::REF);
+    ValueRange nonNegative{0, std::numeric_limits<int64_t>::max()};
+    if (array->GetOpcode() == Opcode::NEW_ARRAY_IMM) {
+        auto length = static_cast<const NewArrayImmInstruction *>(array)->GetValue();
+        return nonNegative.Intersect(ValueRange::Single(static_cast<int64_t>(length)));
+    }
+    if (array->GetOpcode() == Opcode::NEW_ARRAY) {
+        const auto *length = array->AsInputsInstruction()->GetInput(0).GetInstruction();
+        auto range = GetRange(length, array->GetBasicBlock());
+        // arrays cannot be created with negative lengths
+        if (IsSignedType(length->GetType()) || range.min >= 0) {
+            return nonNegative.Intersect(range);
+        }
+    }
+    return nonNegative;
+}
+
+/* static */
+bool ValueRangeAnalysis::isIntegerValue(const InstructionBase *instr) {
+    ASSERT(instr);
+    switch (instr->GetOpcode()) {
+    case Opcode::CMP:
+    case Opcode::RET:
+    case Opcode::NULL_CHECK:
+    case Opcode::ZERO_CHECK:
+    case Opcode::NEGATIVE_CHECK:
+    case Opcode::BOUNDS_CHECK:
+        return false;
+    default:
+        return IsIntegerType(getValueType(instr));
+    }
+}
+
+/* static */
+OperandType ValueRangeAnalysis::getValueType(const InstructionBase *instr) {
+    ASSERT(instr);
+    if (instr->GetOpcode() == Opcode::CAST) {
+        return static_cast<const CastInstruction *>(instr)->GetTargetType();
+    }
+    return instr->GetType();
+}
+
+bool ValueRangeAnalysis::isLoopHeader(const BasicBlock *bblock) const {
+    ASSERT(bblock);
+    auto number = rpoNumbers.At(bblock->GetId());
+    for (const auto *pred : bblock->GetPredecessors()) {
+        const auto *predNumber = rpoNumbers.Find(pred->GetId());
+        if (predNumber != nullptr && *predNumber >= number) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ValueRangeAnalysis::initialize() {
+    ranges.Clear();
+    ranges.Reserve(graph->GetInstructionBuilder()->GetNextId());
+    rpoNumbers.Clear();
+    rpoNumbers.Reserve(graph->GetMaximumBlockId() + 1);
+    size_t number = 0;
+    for (auto *bblock : graph->GetRPO()) {
+        rpoNumbers.Insert(bblock->GetId(), number++);
+        for (auto *instr : *bblock) {
+            if (isIntegerValue(instr)) {
+                ranges.Insert(instr->GetId(), ValueRange::Empty());
+            }
+        }
+    }
+}
+
+bool ValueRangeAnalysis::iterate(bool narrowing, bool widenAll) {
+    bool changed = false;
+    for (auto *bblock : graph->GetRPO()) {
+        bool widen = !narrowing && (widenAll || isLoopHeader(bblock));
+        for (auto *instr : *bblock) {
+            if (!isIntegerValue(instr)) {
+                continue;
+            }
+            auto &range = ranges.At(instr->GetId());
+            auto newRange = evaluate(instr);
+            if (narrowing) {
+                newRange = range.Intersect(newRange);
+            } else {
+                newRange = range.Join(newRange);
+                if (widen && instr->IsPhi() && !range.IsEmpty()) {
+                    // growing bounds of loop-carried values are moved to the type's bounds
+                    auto full = ValueRange::Full(instr->GetType());
+                    newRange.min = newRange.min < range.min ? full.min : newRange.min;
+                    newRange.max = newRange.max > range.max ? full.max : newRange.max;
+                }
+            }
+            if (newRange.IsEmpty()) {
+                newRange = ValueRange::Empty();
+            }
+            if (newRange != range) {
+                range = newRange;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+ValueRange ValueRangeAnalysis::evaluate(const InstructionBase *instr) const {
+    ASSERT((instr) && isIntegerValue(instr));
+    switch (instr->GetOpcode()) {
+    case Opcode::CONST:
+        return ValueRange::Single(SignExtend(instr->AsConst()->GetValue(), instr->GetType()));
+    case Opcode::MOVE:
+        return GetRange(instr->AsInputsInstruction()->GetInput(0).GetInstruction(), instr->GetBasicBlock());
+    case Opcode::CAST:
+        return evaluateCast(static_cast<const CastInstruction *>(instr));
+    case Opcode::PHI:
+        return evaluatePhi(instr->AsPhi());
+    case Opcode::LEN:
+        return GetArrayLength(instr->AsInputsInstruction()->GetInput(0).GetInstruction());
+    default:
+        if (instr->SatisfiesProperty(InstrProp::ARITH)) {
+            return evaluateArithmetic(instr);
+        }
+        return ValueRange::Full(instr->GetType());
+    }
+}
+
+ValueRange ValueRangeAnalysis::evaluatePhi(const PhiInstruction *phi) const {
+    ASSERT(phi);
+    ValueRange result;
+    for (size_t i = 0, end = phi->GetInputsCount(); i < end; ++i) {
+        const auto *source = phi->GetSourceBasicBlock(i);
+        // values never come from unreachable blocks
+        if (rpoNumbers.Contains(source->GetId())) {
+            const auto *input = phi->GetInput(i).GetInstruction();
+            result = result.Join(GetRange(input, source, phi->GetBasicBlock()));
+        }
+    }
+    return result;
+}
+
+ValueRange ValueRangeAnalysis::evaluateArithmetic(const InstructionBase *instr) const {
+    ASSERT(instr);
+    auto type = instr->GetType();
+    const auto *inputs = instr->AsInputsInstruction();
+    auto *bblock = instr->GetBasicBlock();
+    auto lhs = GetRange(inputs->GetInput(0).GetInstruction(), bblock);
+    auto rhs = ValueRange::Single(0);
+    if (inputs->GetInputsCount() == 2) {
+        rhs = GetRange(inputs->GetInput(1).GetInstruction(), bblock);
+    } else if (instr->GetOpcode() != Opcode::NEG && instr->GetOpcode() != Opcode::NOT) {
+        auto imm = static_cast<const BinaryImmInstruction *>(instr)->GetValue();
+        rhs = ValueRange::Single(SignExtend(imm, type));
+    }
+    if (lhs.IsEmpty() || rhs.IsEmpty()) {
+        return ValueRange::Empty();
+    }
+    // values of unsigned types with the sign bit set are large, so they are divided as non-negative ones
+    bool signedDivision = IsSignedType(type) || lhs.min >= 0;
+
+    switch (instr->GetOpcode()) {
+    case Opcode::ADD:
+    case Opcode::ADDI:
+        return applyToBounds(lhs, rhs, type, addBounds);
+    case Opcode::SUB:
+    case Opcode::SUBI:
+        return applyToBounds(lhs, rhs, type, subBounds);
+    case Opcode::MUL:
+    case Opcode::MULI:
+        return applyToBounds(lhs, rhs, type, mulBounds);
+    case Opcode::NEG:
+        return applyToBounds(ValueRange::Single(0), lhs, type, subBounds);
+    case Opcode::DIV:
+    case Opcode::DIVI:
+        return rhs.min > 0 && signedDivision ? applyToBounds(lhs, rhs, type, divBounds) : ValueRange::Full(type);
+    case Opcode::MOD:
+    case Opcode::MODI: {
+        if (rhs.min <= 0 || !signedDivision) {
+            return ValueRange::Full(type);
+        }
+        // remainders have signs of dividends
+        auto bound = rhs.max - 1;
+        if (lhs.min >= 0) {
+            return {0, std::min(lhs.max, bound)};
+        }
+        if (lhs.max <= 0) {
+            return {std::max(lhs.min, -bound), 0};
+        }
+        return {-bound, bound};
+    }
+    case Opcode::AND:
+    case Opcode::ANDI:
+        if (lhs.min >= 0 && rhs.min >= 0) {
+            return {0, std::min(lhs.max, rhs.max)};
+        }
+        if (lhs.min >= 0 || rhs.min >= 0) {
+            return {0, lhs.min >= 0 ? lhs.max : rhs.max};
+        }
+        return ValueRange::Full(type);
+    case Opcode::SRA:
+    case Opcode::SRAI:
+        // shifts of non-negative values do not depend on their kind
+        if (lhs.min >= 0 && rhs.IsSingle() && rhs.min >= 0
+                && static_cast<size_t>(rhs.min) < GetTypeBitSize(type)) {
+            return {lhs.min >> rhs.min, lhs.max >> rhs.min};
+        }
+        return ValueRange::Full(type);
+    default:
+        return ValueRange::Full(type);
+    }
+}
+
+ValueRange ValueRangeAnalysis::evaluateCast(const CastInstruction *cast) const {
+    ASSERT(cast);
+    auto fromType = cast->GetType();
+    auto toType = cast->GetTargetType();
+    if (!IsIntegerType(fromType)) {
+        return ValueRange::Full(toType);
+    }
+    auto range = GetRange(cast->GetInput(0).GetInstruction(), cast->GetBasicBlock());
+    // values of unsigned types are zero-extended, so only their non-negative representations are kept
+    if (range.IsEmpty() || IsSignedType(fromType) || range.min >= 0) {
+        return fitIntoType(range, toType);
+    }
+    return ValueRange::Full(toType);
+}
+
+ValueRange ValueRangeAnalysis::narrowOnEdge(const InstructionBase *value, ValueRange range,
+                                            const BasicBlock *pred, const BasicBlock *succ) const
+{
+    ASSERT((value) && (pred) && (succ));
+    const auto *cmp = pred->EndsWithConditionalJump();
+    // unsigned comparisons do not agree with the ranges' order
+    if (cmp == nullptr || !IsSignedType(cmp->GetType())) {
+        return range;
+    }
+    const auto &succs = pred->GetSuccessors();
+    ASSERT(succs.size() == 2);
+    if (succs[0] == succs[1]) {
+        return range;
+    }
+    // the first successor is the true branch
+    auto ccode = succ == succs[0] ? cmp->GetCondCode() : negateCondCode(cmp->GetCondCode());
+    const auto *lhs = cmp->GetInput(0).GetInstruction();
+    const auto *rhs = cmp->GetInput(1).GetInstruction();
+    if (lhs == value && rhs != value) {
+        return range.Narrow(ccode, GetRange(rhs));
+    }
+    if (rhs == value && lhs != value) {
+        return range.Narrow(mirrorCondCode(ccode), GetRange(lhs));
+    }
+    return range;
+}
+}   // namespace ir
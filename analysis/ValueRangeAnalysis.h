@@ -0,0 +1,111 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_VALUE_RANGE_ANALYSIS_H_
+#define JIT_AOT_COMPILERS_COURSE_VALUE_RANGE_ANALYSIS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include "IdMap.h"
+#include <limits>
+#include "PassBase.h"
+
+
+namespace ir {
+// Closed range of values of an integer type. Values of all types are kept
+// sign-extended from the types' sizes, like constants are.
+struct ValueRange {
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+
+    static ValueRange Full(OperandType type);
+    static ValueRange Empty() {
+        return {};
+    }
+    static ValueRange Single(int64_t value) {
+        return {value, value};
+    }
+
+    bool IsEmpty() const {
+        return min > max;
+    }
+    bool IsSingle() const {
+        return min == max;
+    }
+    bool Contains(int64_t value) const {
+        return min <= value && value <= max;
+    }
+    bool Contains(const ValueRange &other) const {
+        return other.IsEmpty() || (min <= other.min && other.max <= max);
+    }
+
+    ValueRange Join(const ValueRange &other) const {
+        return {std::min(min, other.min), std::max(max, other.max)};
+    }
+    ValueRange Intersect(const ValueRange &other) const {
+        return {std::max(min, other.min), std::min(max, other.max)};
+    }
+    // Returns the subrange of values, for which `value ccode bound` may hold.
+    ValueRange Narrow(CondCode ccode, const ValueRange &bound) const;
+    // Returns true if `lhs ccode rhs` holds for all values of the ranges.
+    static bool AlwaysHolds(CondCode ccode, const ValueRange &lhs, const ValueRange &rhs);
+
+    bool operator==(const ValueRange &other) const = default;
+};
+
+// Computes ranges of integer values with the sparse iterative algorithm:
+// ranges are propagated through arithmetic, casts and PHIs until the fixed point,
+// ranges of PHIs in loop headers are widened to the types' bounds to ensure
+// termination, and then are refined by a few narrowing iterations.
+// Ranges of values at their uses are narrowed by conditions of branches, which
+// dominate the uses, so no copies of values are inserted on the branches.
+// Ranges are kept in the pass's scratch memory and live as long as the pass object,
+// so BranchElimination and CheckElimination run their own instances over the graph
+// they are about to transform.
+class ValueRangeAnalysis final : public PassBase {
+public:
+    explicit ValueRangeAnalysis(Graph *graph)
+        : PassBase(graph),
+          ranges(GetScratchResource()),
+          rpoNumbers(GetScratchResource())
+    {}
+    NO_COPY_SEMANTIC(ValueRangeAnalysis);
+    NO_MOVE_SEMANTIC(ValueRangeAnalysis);
+    ~ValueRangeAnalysis() noexcept override = default;
+
+    bool Run() override;
+
+    // Returns the range of the value, which holds at all its uses.
+    ValueRange GetRange(const InstructionBase *value) const;
+    // Returns the range of the value at the start of the block.
+    ValueRange GetRange(const InstructionBase *value, const BasicBlock *bblock) const;
+    // Returns the range of the value on the edge between the blocks.
+    ValueRange GetRange(const InstructionBase *value, const BasicBlock *pred, const BasicBlock *succ) const;
+    // Returns the range of lengths of the array.
+    ValueRange GetArrayLength(const InstructionBase *array) const;
+
+public:
+    // the number of iterations, after which all PHIs are widened, as loops may be irreducible
+    static constexpr size_t FORCED_WIDENING_ITERATIONS = 8;
+    // the number of iterations refining ranges after the fixed point is reached
+    static constexpr size_t NARROWING_ITERATIONS = 2;
+
+private:
+    static bool isIntegerValue(const InstructionBase *instr);
+    static OperandType getValueType(const InstructionBase *instr);
+
+    bool isLoopHeader(const BasicBlock *bblock) const;
+    void initialize();
+    bool iterate(bool narrowing, bool widenAll);
+    ValueRange evaluate(const InstructionBase *instr) const;
+    ValueRange evaluatePhi(const PhiInstruction *phi) const;
+    ValueRange evaluateArithmetic(const InstructionBase *instr) const;
+    ValueRange evaluateCast(const CastInstruction *cast) const;
+    // Narrows the range of the value by the condition, which holds on the edge.
+    ValueRange narrowOnEdge(const InstructionBase *value, ValueRange range,
+                            const BasicBlock *pred, const BasicBlock *succ) const;
+
+private:
+    IdMap<ValueRange> ranges;
+    IdMap<size_t> rpoNumbers;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_VALUE_RANGE_ANALYSIS_H_
@@ -0,0 +1,62 @@
+#include "benchmark/benchmark.h"
+#include "Compiler.h"
+#include "default/DefaultArch.h"
+#include "DomTree.h"
+
+
+namespace ir::benchmarks {
+// Builds a graph shaped like typical JIT functions: a sequence of
+// if-else diamonds and loops with early exits into the last block.
+static Graph *buildStructuredGraph(Compiler &compiler, size_t blocksCount) {
+    auto *graph = compiler.CreateNewGraph();
+    auto *firstBlock = graph->CreateEmptyBasicBlock();
+    graph->SetFirstBasicBlock(firstBlock);
+    auto *lastBlock = graph->CreateEmptyBasicBlock(true);
+
+    auto *prevBlock = firstBlock;
+    for (size_t i = 0; graph->GetBasicBlocksCount() + 4 <= blocksCount; ++i) {
+        auto *head = graph->CreateEmptyBasicBlock();
+        auto *left = graph->CreateEmptyBasicBlock();
+        auto *right = graph->CreateEmptyBasicBlock();
+        auto *join = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, head);
+        graph->ConnectBasicBlocks(head, left);
+        graph->ConnectBasicBlocks(head, right);
+        graph->ConnectBasicBlocks(left, join);
+        if (i % 2 == 0) {
+            // if-else diamond
+            graph->ConnectBasicBlocks(right, join);
+        } else {
+            // loop with the header in `head` and an exit from its body
+            graph->ConnectBasicBlocks(right, head);
+            graph->ConnectBasicBlocks(right, lastBlock);
+        }
+        prevBlock = join;
+    }
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+    return graph;
+}
+
+static void runDomTreeBuilder(benchmark::State &state, DominatorsAlgorithm algorithm) {
+    Compiler compiler(codegen::DefaultArch::GetInstance());
+    auto *graph = buildStructuredGraph(compiler, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        utils::ScratchScope scratch;
+        DomTreeBuilder builder(graph, algorithm);
+        benchmark::DoNotOptimize(builder.Build(scratch.GetArena()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * graph->GetBasicBlocksCount()));
+}
+
+static void BM_DomTreeLengauerTarjan(benchmark::State &state) {
+    runDomTreeBuilder(state, DominatorsAlgorithm::LENGAUER_TARJAN);
+}
+
+static void BM_DomTreeSemiNCA(benchmark::State &state) {
+    runDomTreeBuilder(state, DominatorsAlgorithm::SEMI_NCA);
+}
+
+BENCHMARK(BM_DomTreeLengauerTarjan)->RangeMultiplier(5)->Range(10, 5000);
+BENCHMARK(BM_DomTreeSemiNCA)->RangeMultiplier(5)->Range(10, 5000);
+}   // namespace ir::benchmarks
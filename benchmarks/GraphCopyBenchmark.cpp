@@ -0,0 +1,57 @@
+#include "benchmark/benchmark.h"
+#include "default/DefaultArch.h"
+#include "Compiler.h"
+#include "GraphCopyHelper.h"
+#include "InstructionBuilder.h"
+
+
+namespace ir::benchmarks {
+static constexpr size_t INSTRUCTIONS_PER_BLOCK = 100;
+
+// Builds a chain of basic blocks filled with arithmetic instructions.
+static Graph *buildGraph(Compiler &compiler, size_t instructionsCount) {
+    auto *graph = compiler.CreateNewGraph();
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    auto opType = OperandType::I64;
+
+    auto *firstBlock = graph->CreateEmptyBasicBlock();
+    graph->SetFirstBasicBlock(firstBlock);
+    auto *arg = instrBuilder->CreateARG(opType);
+    instrBuilder->PushBackInstruction(firstBlock, arg);
+    InstructionBase *value = arg;
+
+    auto *prevBlock = firstBlock;
+    for (size_t created = 0; created < instructionsCount; created += INSTRUCTIONS_PER_BLOCK) {
+        auto *bblock = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, bblock);
+        for (size_t i = 0; i < INSTRUCTIONS_PER_BLOCK; ++i) {
+            value = instrBuilder->CreateADD(opType, value, arg);
+            instrBuilder->PushBackInstruction(bblock, value);
+        }
+        prevBlock = bblock;
+    }
+
+    auto *lastBlock = graph->CreateEmptyBasicBlock();
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+    graph->SetLastBasicBlock(lastBlock);
+    instrBuilder->PushBackInstruction(lastBlock, instrBuilder->CreateRET(opType, value));
+    return graph;
+}
+
+static void BM_GraphCopy(benchmark::State &state) {
+    Compiler compiler(codegen::DefaultArch::GetInstance());
+    auto instructionsCount = static_cast<size_t>(state.range(0));
+    const auto *source = buildGraph(compiler, instructionsCount);
+
+    for (auto _ : state) {
+        auto *copy = compiler.CreateNewGraph();
+        benchmark::DoNotOptimize(GraphCopyHelper::CreateCopy(source, copy));
+
+        state.PauseTiming();
+        compiler.DeleteFunctionGraph(copy->GetId());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * instructionsCount));
+}
+BENCHMARK(BM_GraphCopy)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+}   // namespace ir::benchmarks
@@ -0,0 +1,67 @@
+#include "benchmark/benchmark.h"
+#include "Compiler.h"
+#include "default/DefaultArch.h"
+#include "InstructionBuilder.h"
+#include "LinearOrdering.h"
+
+
+namespace ir::benchmarks {
+// Builds a graph of if-else diamonds and loops with early exits into the last block,
+// which ends up with a lot of predecessors.
+static Graph *buildGraph(Compiler &compiler, size_t blocksCount) {
+    auto *graph = compiler.CreateNewGraph();
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    auto opType = OperandType::I64;
+
+    auto *firstBlock = graph->CreateEmptyBasicBlock();
+    graph->SetFirstBasicBlock(firstBlock);
+    auto *arg = instrBuilder->CreateARG(opType);
+    instrBuilder->PushBackInstruction(firstBlock, arg);
+    auto *lastBlock = graph->CreateEmptyBasicBlock(true);
+    instrBuilder->PushBackInstruction(lastBlock, instrBuilder->CreateRET(opType, arg));
+
+    auto addBranch = [instrBuilder, arg, opType](BasicBlock *bblock) {
+        instrBuilder->PushBackInstruction(
+            bblock, instrBuilder->CreateCMP(opType, CondCode::EQ, arg, arg), instrBuilder->CreateJCMP());
+    };
+
+    auto *prevBlock = firstBlock;
+    for (size_t i = 0; graph->GetBasicBlocksCount() + 4 <= blocksCount; ++i) {
+        auto *head = graph->CreateEmptyBasicBlock();
+        auto *left = graph->CreateEmptyBasicBlock();
+        auto *right = graph->CreateEmptyBasicBlock();
+        auto *join = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, head);
+        addBranch(head);
+        graph->ConnectBasicBlocks(head, left);
+        graph->ConnectBasicBlocks(head, right);
+        graph->ConnectBasicBlocks(left, join);
+        if (i % 2 == 0) {
+            // if-else diamond
+            graph->ConnectBasicBlocks(right, join);
+        } else {
+            // loop with the header in `head` and an exit from its body
+            addBranch(right);
+            graph->ConnectBasicBlocks(right, head);
+            graph->ConnectBasicBlocks(right, lastBlock);
+        }
+        prevBlock = join;
+    }
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+    return graph;
+}
+
+static void BM_LinearOrdering(benchmark::State &state) {
+    Compiler compiler(codegen::DefaultArch::GetInstance());
+    auto *graph = buildGraph(compiler, static_cast<size_t>(state.range(0)));
+    // the first run inserts jump blocks, the following ones keep the graph unchanged
+    PassManager::Run<LinearOrdering>(graph);
+
+    for (auto _ : state) {
+        LinearOrdering ordering(graph);
+        benchmark::DoNotOptimize(ordering.Run());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * graph->GetBasicBlocksCount()));
+}
+BENCHMARK(BM_LinearOrdering)->RangeMultiplier(10)->Range(100, 100'000)->Unit(benchmark::kMicrosecond);
+}   // namespace ir::benchmarks
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"
+#include "Compiler.h"
+#include "default/DefaultArch.h"
+#include "InstructionBuilder.h"
+#include "LivenessAnalyzer.h"
+
+
+namespace ir::benchmarks {
+static constexpr size_t INSTRUCTIONS_PER_BLOCK = 50;
+// distance between an instruction and its input, so that values are live across blocks
+static constexpr size_t USE_DISTANCE = 70;
+
+// Builds a chain of basic blocks filled with arithmetic instructions,
+// each using the previous value and a value defined long before it.
+static Graph *buildGraph(Compiler &compiler, size_t instructionsCount) {
+    auto *graph = compiler.CreateNewGraph();
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    auto opType = OperandType::I64;
+
+    auto *firstBlock = graph->CreateEmptyBasicBlock();
+    graph->SetFirstBasicBlock(firstBlock);
+    auto *arg = instrBuilder->CreateARG(opType);
+    instrBuilder->PushBackInstruction(firstBlock, arg);
+    std::vector<InstructionBase *> values{arg};
+    values.reserve(instructionsCount + 1);
+
+    auto *prevBlock = firstBlock;
+    for (size_t created = 0; created < instructionsCount; created += INSTRUCTIONS_PER_BLOCK) {
+        auto *bblock = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, bblock);
+        for (size_t i = 0; i < INSTRUCTIONS_PER_BLOCK; ++i) {
+            auto *distant = values[values.size() > USE_DISTANCE ? values.size() - USE_DISTANCE : 0];
+            auto *value = instrBuilder->CreateADD(opType, values.back(), distant);
+            instrBuilder->PushBackInstruction(bblock, value);
+            values.push_back(value);
+        }
+        prevBlock = bblock;
+    }
+
+    auto *lastBlock = graph->CreateEmptyBasicBlock();
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+    graph->SetLastBasicBlock(lastBlock);
+    instrBuilder->PushBackInstruction(lastBlock, instrBuilder->CreateRET(opType, values.back()));
+    return graph;
+}
+
+static void BM_LiveIntervalsConstruction(benchmark::State &state) {
+    Compiler compiler(codegen::DefaultArch::GetInstance());
+    auto instructionsCount = static_cast<size_t>(state.range(0));
+    auto *graph = buildGraph(compiler, instructionsCount);
+    // linear order is computed once and kept valid between runs
+    PassManager::Run<LivenessAnalyzer>(graph);
+
+    for (auto _ : state) {
+        LivenessAnalyzer analyzer(graph);
+        benchmark::DoNotOptimize(analyzer.Run());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * instructionsCount));
+}
+BENCHMARK(BM_LiveIntervalsConstruction)->RangeMultiplier(10)->Range(1'000, 100'000);
+}   // namespace ir::benchmarks
@@ -0,0 +1,67 @@
+#include "Arena.h"
+#include "benchmark/benchmark.h"
+#include "LiveAnalysisStructs.h"
+#include <random>
+#include <unordered_set>
+
+
+namespace ir::benchmarks {
+// Live sets of successors of a block, filled with random linear numbers of instructions.
+template <typename SetType, typename InsertType>
+static std::pmr::vector<SetType> makeSuccessorsSets(std::pmr::memory_resource *mem, size_t liveCount,
+                                                    InsertType insert) {
+    constexpr size_t SUCCESSORS_COUNT = 2;
+    // most live values are shared by successors
+    constexpr size_t UNIVERSE_FACTOR = 4;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dist(0, liveCount * UNIVERSE_FACTOR);
+    std::pmr::vector<SetType> sets(mem);
+    sets.reserve(SUCCESSORS_COUNT);
+    for (size_t i = 0; i < SUCCESSORS_COUNT; ++i) {
+        auto &set = sets.emplace_back();
+        for (size_t j = 0; j < liveCount; ++j) {
+            insert(set, dist(gen));
+        }
+    }
+    return sets;
+}
+
+// The former implementation of live sets.
+static void BM_LiveSetUnionHashed(benchmark::State &state) {
+    using HashSet = std::pmr::unordered_set<size_t>;
+    utils::ScratchScope scratch;
+    auto succs = makeSuccessorsSets<HashSet>(
+        scratch.GetArena(), static_cast<size_t>(state.range(0)),
+        [](HashSet &set, size_t number) { set.insert(number); });
+
+    for (auto _ : state) {
+        utils::ScratchScope iterationScratch;
+        HashSet liveSet(iterationScratch.GetArena());
+        for (const auto &succLiveSet : succs) {
+            liveSet.insert(succLiveSet.begin(), succLiveSet.end());
+        }
+        benchmark::DoNotOptimize(liveSet);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LiveSetUnion(benchmark::State &state) {
+    utils::ScratchScope scratch;
+    auto succs = makeSuccessorsSets<LiveSet>(
+        scratch.GetArena(), static_cast<size_t>(state.range(0)),
+        [](LiveSet &set, size_t number) { set.Add(number); });
+
+    for (auto _ : state) {
+        utils::ScratchScope iterationScratch;
+        LiveSet liveSet(iterationScratch.GetArena());
+        for (const auto &succLiveSet : succs) {
+            liveSet.Union(succLiveSet);
+        }
+        benchmark::DoNotOptimize(liveSet);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_LiveSetUnionHashed)->RangeMultiplier(4)->Range(4, 16384);
+BENCHMARK(BM_LiveSetUnion)->RangeMultiplier(4)->Range(4, 16384);
+}   // namespace ir::benchmarks
@@ -0,0 +1,90 @@
+#include "benchmark/benchmark.h"
+#include "Compiler.h"
+#include "DCE.h"
+#include "default/DefaultArch.h"
+#include "DomTree.h"
+#include "InstructionBuilder.h"
+#include "LoopAnalyzer.h"
+#include "Traversals.h"
+
+
+namespace ir::benchmarks {
+// Builds a loop made of a chain of basic blocks, each of which extends
+// a single def-use chain, so that depth of every traversal grows with the graph.
+static Graph *buildLoopChain(Compiler &compiler, size_t blocksCount) {
+    auto *graph = compiler.CreateNewGraph();
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    auto opType = OperandType::I64;
+
+    auto *firstBlock = graph->CreateEmptyBasicBlock();
+    graph->SetFirstBasicBlock(firstBlock);
+    auto *arg = instrBuilder->CreateARG(opType);
+    instrBuilder->PushBackInstruction(firstBlock, arg);
+    InstructionBase *value = arg;
+
+    BasicBlock *header = nullptr;
+    auto *prevBlock = firstBlock;
+    for (size_t i = 0; i < blocksCount; ++i) {
+        auto *bblock = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, bblock);
+        value = instrBuilder->CreateADD(opType, value, arg);
+        instrBuilder->PushBackInstruction(bblock, value);
+        if (header == nullptr) {
+            header = bblock;
+        }
+        prevBlock = bblock;
+    }
+    graph->ConnectBasicBlocks(prevBlock, header);
+
+    auto *lastBlock = graph->CreateEmptyBasicBlock();
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+    graph->SetLastBasicBlock(lastBlock);
+    instrBuilder->PushBackInstruction(lastBlock, instrBuilder->CreateRET(opType, value));
+    return graph;
+}
+
+template <typename CallbackT>
+static void runOnLoopChain(benchmark::State &state, CallbackT callback) {
+    Compiler compiler(codegen::DefaultArch::GetInstance());
+    auto blocksCount = static_cast<size_t>(state.range(0));
+    auto *graph = buildLoopChain(compiler, blocksCount);
+
+    for (auto _ : state) {
+        callback(graph);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blocksCount));
+}
+
+static void BM_RPO(benchmark::State &state) {
+    runOnLoopChain(state, [](Graph *graph) {
+        utils::ScratchScope scratch;
+        benchmark::DoNotOptimize(RPO::DoRPO(graph, scratch.GetArena()));
+    });
+}
+
+static void BM_DomTree(benchmark::State &state) {
+    runOnLoopChain(state, [](Graph *graph) {
+        PassManager::SetInvalid<AnalysisFlag::DOM_TREE>(graph);
+        PassManager::Run<DomTreeBuilder>(graph);
+    });
+}
+
+static void BM_LoopAnalysis(benchmark::State &state) {
+    runOnLoopChain(state, [](Graph *graph) {
+        PassManager::SetInvalid<AnalysisFlag::LOOP_ANALYSIS>(graph);
+        PassManager::Run<LoopAnalyzer>(graph);
+    });
+}
+
+// all instructions are alive, so the graph is not changed between iterations
+static void BM_DCE(benchmark::State &state) {
+    runOnLoopChain(state, [](Graph *graph) {
+        PassManager::Run<DCEPass>(graph);
+    });
+}
+
+BENCHMARK(BM_RPO)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DomTree)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoopAnalysis)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DCE)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+}   // namespace ir::benchmarks
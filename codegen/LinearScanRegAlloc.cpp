@@ -130,7 +130,6 @@ bool LinearScanRegAlloc::resolvePhis(BasicBlock *bblock) {
             insertInto->PushBackInstruction(move);
 
             phi->SetInput(move, idx);
-            input->RemoveUser(phi);
             auto *liveInt = liveIntervals.AddLiveInterval(LiveRange::INVALID_RANGE, move);
             liveInt->SetLocation(phiInfo->GetLocation());
         }
@@ -149,9 +148,6 @@ BasicBlock *LinearScanRegAlloc::breakCriticalEdge(BasicBlock *bblock, BasicBlock
 }
 
 void LinearScanRegAlloc::postAlloc() {
-    PassManager::SetInvalid<
-        AnalysisFlag::DOM_TREE,
-        AnalysisFlag::RPO,
-        AnalysisFlag::LINEAR_ORDERING>(graph);
+    PassManager::SetInvalid<AnalysisFlag::RPO, AnalysisFlag::LINEAR_ORDERING>(graph);
 }
 }   // namespace ir::codegen
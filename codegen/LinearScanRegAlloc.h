@@ -15,7 +15,7 @@ public:
         : PassBase(graph),
           utils::Logger(log4cpp::Category::getInstance(GetName())),
           regsCount(graph->GetCompiler()->GetArch()->GetIntRegsCount()),
-          active(graph->GetMemoryResource()),
+          active(GetScratchResource()),
           regMap(regsCount)
     {}
     ~LinearScanRegAlloc() noexcept override = default;
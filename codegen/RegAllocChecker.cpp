@@ -20,9 +20,8 @@ void RegAllocChecker::verifyPhiInputs(const PhiInstruction *phi) {
 
     GraphChecker::VerifyPhiBasicBlocks(phi);
     const auto &loc = liveIntervals.GetLiveIntervals(phi)->GetLocation();
-    for (size_t i = 0, end = phi->GetInputsCount(); i < end; ++i) {
-        const auto *input = phi->GetInput(i).GetInstruction();
-        ASSERT(liveIntervals.GetLiveIntervals(input)->GetLocation() == loc);
+    for (const auto &input : phi->GetInputs()) {
+        ASSERT(liveIntervals.GetLiveIntervals(input.GetInstruction())->GetLocation() == loc);
     }
 }
 }   // namespace ir
@@ -23,8 +23,12 @@ public:
     virtual Graph *CopyGraph(const Graph *source, InstructionBuilder *instrBuilder) = 0;
     virtual Graph *Optimize(Graph *graph) = 0;
     virtual Graph *GetFunction(FunctionId functionId) = 0;
+    // Releases memory of the function's graph and replaces it with a new empty one.
+    virtual Graph *RecreateFunctionGraph(FunctionId functionId) = 0;
     virtual bool DeleteFunctionGraph(FunctionId functionId) = 0;
     virtual const CompilerOptions &GetOptions() const = 0;
+    // Whether all functions' graphs together hold more memory than the budget allows.
+    virtual bool IsMemoryBudgetExceeded() const = 0;
 };
 }   // namespace ir
 
@@ -1,10 +1,16 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_COMPILER_OPTIONS_H_
 #define JIT_AOT_COMPILERS_COURSE_COMPILER_OPTIONS_H_
 
+#include <cstdint>
 #include "macros.h"
 
 
 namespace ir {
+enum class DominatorsAlgorithm : uint8_t {
+    LENGAUER_TARJAN = 0,
+    SEMI_NCA,
+};
+
 #define PASS_OPTION(type, name, value)      \
 public:                                     \
     type Get##name() const { return name; } \
@@ -23,6 +29,14 @@ public:
 
     PASS_OPTION(size_t, MaxCalleeInstrs, 25);
     PASS_OPTION(size_t, MaxInstrsAfterInlining, 250);
+    // Maximum number of bytes held by all function graphs, 0 means unlimited.
+    // New graphs are not created and optimizations are aborted when the budget is exhausted.
+    PASS_OPTION(size_t, MemoryBudget, 1024UL * 1024 * 1024);
+    // Maximum number of bytes allocated for a single graph being optimized, 0 means unlimited.
+    PASS_OPTION(size_t, MaxGraphMemory, 0);
+    PASS_OPTION(DominatorsAlgorithm, DomTreeAlgorithm, DominatorsAlgorithm::SEMI_NCA);
+    // Makes GraphChecker compare incrementally updated dominators tree with a rebuilt one.
+    PASS_OPTION(bool, VerifyDomTree, false);
 };
 
 #undef PASS_OPTION
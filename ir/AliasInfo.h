@@ -0,0 +1,55 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_ALIAS_INFO_H_
+#define JIT_AOT_COMPILERS_COURSE_ALIAS_INFO_H_
+
+#include "IdMap.h"
+#include "instructions/InstructionBase.h"
+#include <limits>
+
+
+namespace ir {
+// Bases of references computed by AliasAnalysis. They are kept in the graph,
+// so that alias queries of all passes share them while the ALIAS_ANALYSIS flag is valid.
+class AliasInfo final {
+public:
+    static constexpr TypeId::TypeIdType UNKNOWN_TYPE_ID = std::numeric_limits<TypeId::TypeIdType>::max();
+
+    struct RefInfo {
+        const InstructionBase *base = nullptr;
+        // type of the referenced object, if it is known
+        TypeId::TypeIdType typeId = UNKNOWN_TYPE_ID;
+    };
+
+    explicit AliasInfo(std::pmr::memory_resource *memResource)
+        : references(memResource), nonEscapingAllocations(memResource)
+    {}
+    NO_COPY_SEMANTIC(AliasInfo);
+    NO_MOVE_SEMANTIC(AliasInfo);
+    DEFAULT_DTOR(AliasInfo);
+
+    IdMap<RefInfo> &GetReferences() {
+        return references;
+    }
+    const IdMap<RefInfo> &GetReferences() const {
+        return references;
+    }
+
+    // Allocation sites, which are not stored anywhere and not passed to calls.
+    IdSet &GetNonEscapingAllocations() {
+        return nonEscapingAllocations;
+    }
+    const IdSet &GetNonEscapingAllocations() const {
+        return nonEscapingAllocations;
+    }
+
+    void Clear() {
+        references.Clear();
+        nonEscapingAllocations.Clear();
+    }
+
+private:
+    IdMap<RefInfo> references;
+    IdSet nonEscapingAllocations;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_ALIAS_INFO_H_
@@ -14,6 +14,8 @@ enum class AnalysisFlag : uint8_t {
     LOOP_ANALYSIS,
     RPO,
     LINEAR_ORDERING,
+    BLOCK_FREQUENCY,
+    ALIAS_ANALYSIS,
     INVALID,
     ANALYSIS_COUNT = INVALID,
 };
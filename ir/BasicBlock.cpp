@@ -63,6 +63,26 @@ void BasicBlock::InverseConditionalBranch() {
     ASSERT(cmp != nullptr);
     cmp->Inverse();
     std::tie(succs[0], succs[1]) = std::make_tuple(succs[1], succs[0]);
+    branchProbability = 1.0 - branchProbability;
+}
+
+double BasicBlock::GetSuccessorProbability(size_t idx) const {
+    ASSERT(idx < succs.size());
+    if (succs.size() == 2) {
+        return idx == 0 ? branchProbability : 1.0 - branchProbability;
+    }
+    return 1.0 / static_cast<double>(succs.size());
+}
+
+double BasicBlock::GetEdgeProbability(const BasicBlock *succ) const {
+    ASSERT(succ);
+    double probability = 0;
+    for (size_t i = 0, end = succs.size(); i < end; ++i) {
+        if (succs[i] == succ) {
+            probability += GetSuccessorProbability(i);
+        }
+    }
+    return probability;
 }
 
 bool BasicBlock::IsLoopHeader() const {
@@ -71,6 +91,19 @@ bool BasicBlock::IsLoopHeader() const {
 
 bool BasicBlock::Dominates(const BasicBlock *other) const {
     ASSERT(other);
+    if (graph == nullptr || !graph->IsAnalysisValid(AnalysisFlag::DOM_TREE)) {
+        return dominatesByWalk(other);
+    }
+    ASSERT(other->GetGraph() == graph);
+    if (!graph->IsDomTreeNumbered()) {
+        graph->NumberDomTree();
+    }
+    bool res = domTreeEnter <= other->domTreeEnter && other->domTreeExit <= domTreeExit;
+    ASSERT(res == dominatesByWalk(other));
+    return res;
+}
+
+bool BasicBlock::dominatesByWalk(const BasicBlock *other) const {
     if (other == this) {
         // basic block always dominated itself
         return true;
@@ -140,6 +173,7 @@ void BasicBlock::ReplacePredecessor(BasicBlock *prevPred, BasicBlock *newPred) {
 void BasicBlock::MoveConstantUnsafe(InstructionBase *instr) {
     ASSERT(IsFirstInGraph());
     ASSERT((instr) && instr->IsConst());
+    instr->SetBasicBlock(this);
     instr->SetNextInstruction(nullptr);
     if (lastInst == nullptr) {
         ASSERT(firstInst == nullptr);
@@ -152,6 +186,8 @@ void BasicBlock::MoveConstantUnsafe(InstructionBase *instr) {
         lastInst = instr;
     }
     ++instrsCount;
+    assignOrderNumber(instr);
+    onInstructionAdded(instr);
 }
 
 template <bool PushBack>
@@ -176,12 +212,62 @@ void BasicBlock::pushInstruction(InstructionBase *instr) {
             lastInst->SetNextInstruction(instr);
             lastInst = instr;
         } else {
+            instr->SetPrevInstruction(lastPhi);
             instr->SetNextInstruction(firstInst);
             firstInst->SetPrevInstruction(instr);
             firstInst = instr;
+            if (lastPhi) {
+                lastPhi->SetNextInstruction(instr);
+            }
         }
     }
     ++instrsCount;
+    assignOrderNumber(instr);
+    onInstructionAdded(instr);
+}
+
+void BasicBlock::onInstructionAdded(InstructionBase *instr) {
+    ASSERT(instr);
+    // the instruction may reference memory through new bases
+    GetGraph()->SetAnalysisValid<AnalysisFlag::ALIAS_ANALYSIS>(false);
+    if (instr->IsConst() && IsFirstInGraph()) {
+        GetGraph()->GetConstantPool().Insert(instr->AsConst());
+    }
+}
+
+void BasicBlock::assignOrderNumber(InstructionBase *instr) {
+    ASSERT((instr) && instr->GetBasicBlock() == this);
+    if (!orderValid) {
+        return;
+    }
+    auto *prev = instr->GetPrevInstruction();
+    auto *next = instr->GetNextInstruction();
+    // numbers start from ORDER_STRIDE, so there is a gap before the first instruction
+    auto lowerBound = prev ? prev->GetOrderNumber() : 0;
+    if (next == nullptr) {
+        instr->SetOrderNumber(lowerBound + ORDER_STRIDE);
+    } else if (next->GetOrderNumber() - lowerBound > 1) {
+        instr->SetOrderNumber(lowerBound + (next->GetOrderNumber() - lowerBound) / 2);
+    } else {
+        orderValid = false;
+    }
+}
+
+void BasicBlock::renumberInstructions() const {
+    InstructionBase *instr = firstPhi ? firstPhi : firstInst;
+    for (size_t number = ORDER_STRIDE; instr != nullptr; number += ORDER_STRIDE) {
+        instr->SetOrderNumber(number);
+        instr = instr->GetNextInstruction();
+    }
+    orderValid = true;
+}
+
+bool BasicBlock::IsEarlier(const InstructionBase *lhs, const InstructionBase *rhs) const {
+    ASSERT((lhs) && (rhs) && lhs->GetBasicBlock() == this && rhs->GetBasicBlock() == this);
+    if (!orderValid) {
+        renumberInstructions();
+    }
+    return lhs->GetOrderNumber() <= rhs->GetOrderNumber();
 }
 
 void BasicBlock::pushPhi(InstructionBase *instr) {
@@ -226,6 +312,8 @@ void BasicBlock::InsertBefore(InstructionBase *before, InstructionBase *target)
         firstInst = target;
     }
     ++instrsCount;
+    assignOrderNumber(target);
+    onInstructionAdded(target);
 }
 
 void BasicBlock::InsertAfter(InstructionBase *after, InstructionBase *target) {
@@ -244,11 +332,17 @@ void BasicBlock::InsertAfter(InstructionBase *after, InstructionBase *target) {
         lastInst = target;
     }
     ++instrsCount;
+    assignOrderNumber(target);
+    onInstructionAdded(target);
 }
 
 // TODO: write unit test for this method
 void BasicBlock::UnlinkInstruction(InstructionBase *target) {
     ASSERT((target) && (target->GetBasicBlock() == this));
+    if (target->IsConst()) {
+        GetGraph()->GetConstantPool().Erase(target->AsConst());
+    }
+    GetGraph()->SetAnalysisValid<AnalysisFlag::ALIAS_ANALYSIS>(false);
     target->SetBasicBlock(nullptr);
     auto *prev = target->GetPrevInstruction();
     auto *next = target->GetNextInstruction();
@@ -338,7 +432,12 @@ BasicBlock *BasicBlock::SplitAfterInstruction(InstructionBase *instr, bool conne
     ASSERT(nextInstr);
 
     auto *graph = GetGraph();
+    // the tree is updated below at once, as the successors are moved bypassing the graph
+    bool fixDomTree = connectAfterSplit && graph->IsAnalysisValid(AnalysisFlag::DOM_TREE);
+    graph->SetAnalysisValid<AnalysisFlag::DOM_TREE>(false);
     auto *newBBlock = graph->CreateEmptyBasicBlock();
+    // moved instructions keep their relative order
+    newBBlock->orderValid = orderValid;
 
     // might leave unconnected, e.g. for further usage in inlining
     if (connectAfterSplit) {
@@ -379,6 +478,17 @@ BasicBlock *BasicBlock::SplitAfterInstruction(InstructionBase *instr, bool conne
         lastInst = instr;
     }
 
+    if (fixDomTree) {
+        // the new block is the only successor, so it dominates all blocks dominated by this one
+        newBBlock->dominated.swap(dominated);
+        for (auto *bblock : newBBlock->dominated) {
+            bblock->SetDominator(newBBlock);
+        }
+        newBBlock->SetDominator(this);
+        AddDominatedBlock(newBBlock);
+        graph->SetAnalysisValid<AnalysisFlag::DOM_TREE>(true);
+        graph->NumberDomSubtree(this);
+    }
     return newBBlock;
 }
 }   // namespace ir
@@ -103,7 +103,12 @@ public:
     const std::pmr::vector<BasicBlock *> &GetDominatedBlocks() const {
         return dominated;
     }
+    // Indicates whether the first instruction precedes the second one or is the same.
+    // Both instructions must belong to this block. O(1) amortized complexity.
+    bool IsEarlier(const InstructionBase *lhs, const InstructionBase *rhs) const;
+
     // Indicated whether this block dominates over the other.
+    // O(1) complexity if the graph's dominators tree is valid, otherwise O(depth of the tree).
     bool Dominates(const BasicBlock *other) const;
 
     Loop *GetLoop() {
@@ -114,6 +119,16 @@ public:
     }
     bool IsLoopHeader() const;
 
+    // Estimated number of executions per execution of the graph,
+    // valid after BlockFrequencyAnalysis.
+    double GetFrequency() const {
+        return frequency;
+    }
+    // Probability of passing control to the successor with the given index.
+    double GetSuccessorProbability(size_t idx) const;
+    // Sum of probabilities of all edges leading to the successor.
+    double GetEdgeProbability(const BasicBlock *succ) const;
+
     Graph *GetGraph() {
         return graph;
     }
@@ -142,11 +157,33 @@ public:
     void ClearDominatedBlocks() {
         dominated.clear();
     }
+    // Numbers of entering and leaving this block in DFS over the dominators tree.
+    size_t GetDomTreeEnter() const {
+        return domTreeEnter;
+    }
+    size_t GetDomTreeExit() const {
+        return domTreeExit;
+    }
+    void SetDomTreeInterval(size_t enter, size_t exit) {
+        ASSERT(enter < exit);
+        domTreeEnter = enter;
+        domTreeExit = exit;
+    }
 
     void SetLoop(Loop *newLoop) {
         loop = newLoop;
     }
 
+    void SetFrequency(double newFrequency) {
+        ASSERT(newFrequency >= 0);
+        frequency = newFrequency;
+    }
+    // Sets probability of the first successor of a conditional branch.
+    void SetBranchProbability(double probability) {
+        ASSERT(probability >= 0 && probability <= 1);
+        branchProbability = probability;
+    }
+
     void SetGraph(Graph *g) {
         graph = g;
     }
@@ -312,9 +349,17 @@ private:
     void pushInstruction(InstructionBase *instr);
 
     void pushPhi(InstructionBase *instr);
+    // Numbers the instruction between its neighbours if there is a gap,
+    // otherwise the block is renumbered on the next order query.
+    void assignOrderNumber(InstructionBase *instr);
+    void renumberInstructions() const;
+    // Keeps graph's constant pool in sync with constants of the first block.
+    void onInstructionAdded(InstructionBase *instr);
 
     void replaceInControlFlow(InstructionBase *prevInstr, InstructionBase *newInstr);
 
+    bool dominatesByWalk(const BasicBlock *other) const;
+
 private:
     IdType id = INVALID_ID;
 
@@ -329,11 +374,22 @@ private:
     InstructionBase *firstInst = nullptr;
     InstructionBase *lastInst = nullptr;
 
+    // order numbers of instructions are sparse to leave space for insertions
+    static constexpr size_t ORDER_STRIDE = 16;
+    mutable bool orderValid = true;
+
     BasicBlock *dominator = nullptr;
     std::pmr::vector<BasicBlock *> dominated;
+    // the block dominates exactly those blocks, whose intervals are nested into its one
+    size_t domTreeEnter = 0;
+    size_t domTreeExit = 0;
 
     Loop *loop = nullptr;
 
+    double frequency = 1.0;
+    // probability of the true branch of a conditional jump
+    double branchProbability = 0.5;
+
     Graph *graph = nullptr;
 };
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Compiler.h"
 #include "GraphCopyHelper.h"
 #include "Loop.h"
@@ -5,16 +6,200 @@
 
 // TODO: move builders & compiler into a dedicated ir's subdirectory
 namespace ir {
+Compiler::~Compiler() noexcept {
+    for (auto &function : functionsGraphs) {
+        destroyFunction(function);
+    }
+}
+
+Graph *Compiler::CreateNewGraph() {
+    if (!checkMemoryBudget()) {
+        return nullptr;
+    }
+    FunctionData function;
+    function.memory = std::make_unique<FunctionMemory>(&chunkPool);
+    function.owner = functionsGraphs.size();
+
+    auto *mem = &function.memory->tracker;
+    mem->SetLimit(options.GetMaxGraphMemory());
+    auto *instrBuilder = utils::template New<InstructionBuilder>(mem, mem);
+    function.graph = createGraph(function.owner, mem, instrBuilder);
+    functionsGraphs.push_back(std::move(function));
+    return functionsGraphs.back().graph;
+}
+
 Graph *Compiler::CreateNewGraph(InstructionBuilder *instrBuilder) {
-    auto *graph = utils::template New<Graph>(&memResource, this, &memResource, instrBuilder);
-    graph->SetId(functionsGraphs.size());
-    functionsGraphs.push_back(graph);
-    return graph;
+    ASSERT(instrBuilder);
+    if (!checkMemoryBudget()) {
+        return nullptr;
+    }
+    // graph shares memory with the function owning the builder, so that
+    // its blocks and instructions can be moved into the owner's graph
+    auto *builderMem = instrBuilder->GetMemoryResource();
+    auto it = std::find_if(functionsGraphs.begin(), functionsGraphs.end(),
+                           [builderMem](const FunctionData &f) {
+                               return f.memory && &f.memory->tracker == builderMem;
+                           });
+    if (it == functionsGraphs.end()) {
+        WARNING("Instruction builder is not owned by any function");
+        return nullptr;
+    }
+
+    FunctionData function;
+    function.owner = it->owner;
+    function.graph = createGraph(functionsGraphs.size(), &it->memory->tracker, instrBuilder);
+    functionsGraphs.push_back(std::move(function));
+    return functionsGraphs.back().graph;
 }
 
 // Depth first ordered graph copy algorithm implementation.
 Graph *Compiler::CopyGraph(const Graph *source, InstructionBuilder *instrBuilder) {
     ASSERT((source) && (instrBuilder));
-    return GraphCopyHelper::CreateCopy(source, CreateNewGraph(instrBuilder));
+    auto *copy = CreateNewGraph(instrBuilder);
+    if (copy == nullptr) {
+        return nullptr;
+    }
+    return GraphCopyHelper::CreateCopy(source, copy);
+}
+
+Graph *Compiler::Optimize(Graph *graph) {
+    ASSERT(graph);
+    if (optimizationPasses.empty()) {
+        return graph;
+    }
+    auto *copy = CreateNewGraph();
+    if (copy == nullptr) {
+        return graph;
+    }
+    GraphCopyHelper::CreateCopy(graph, copy);
+
+    for (auto &pass : optimizationPasses) {
+        pass(copy);
+        if (copy->IsMemoryLimitExceeded()) {
+            WARNING("Optimization of function #" + std::to_string(graph->GetId()) +
+                    " is aborted: allocated " + std::to_string(copy->GetMemoryStats().currentBytes) +
+                    " bytes with limit of " + std::to_string(copy->GetMemoryTracker()->GetLimit()) +
+                    ", " + std::to_string(GetUsedMemory()) + " bytes are used with budget of " +
+                    std::to_string(options.GetMemoryBudget()));
+            auto copyId = copy->GetId();
+            DeleteFunctionGraph(copyId);
+            eraseTrailingSlots(copyId);
+            return graph;
+        }
+    }
+    replaceFunction(graph->GetId(), copy->GetId());
+    return copy;
+}
+
+Graph *Compiler::RelocateGraph(Graph *graph) {
+    ASSERT((graph) && graph->GetId() < functionsGraphs.size());
+    if (functionsGraphs[graph->GetId()].memory == nullptr) {
+        return graph;
+    }
+    auto *copy = CreateNewGraph();
+    if (copy == nullptr) {
+        return graph;
+    }
+    GraphCopyHelper::CreateCopy(graph, copy);
+    replaceFunction(graph->GetId(), copy->GetId());
+    return copy;
+}
+
+Graph *Compiler::RecreateFunctionGraph(FunctionId functionId) {
+    if (functionId >= functionsGraphs.size()) {
+        return nullptr;
+    }
+    auto &function = functionsGraphs[functionId];
+    if (function.graph == nullptr || function.memory == nullptr) {
+        return nullptr;
+    }
+    destroyFunction(function);
+
+    auto *mem = &function.memory->tracker;
+    mem->ResetStats();
+    mem->SetLimit(options.GetMaxGraphMemory());
+    auto *instrBuilder = utils::template New<InstructionBuilder>(mem, mem);
+    function.graph = createGraph(functionId, mem, instrBuilder);
+    return function.graph;
+}
+
+bool Compiler::DeleteFunctionGraph(FunctionId functionId) {
+    if (functionId >= functionsGraphs.size() || functionsGraphs[functionId].graph == nullptr) {
+        return false;
+    }
+    auto &function = functionsGraphs[functionId];
+    destroyFunction(function);
+    function.memory.reset();
+    return true;
+}
+
+bool Compiler::checkMemoryBudget() {
+    auto budget = options.GetMemoryBudget();
+    if (budget == 0 || chunkPool.GetReservedBytes() < budget) {
+        return true;
+    }
+    chunkPool.Trim();
+    if (chunkPool.GetUsedBytes() < budget) {
+        return true;
+    }
+    WARNING("Compiler's memory budget is exhausted: " + std::to_string(chunkPool.GetUsedBytes()) +
+            " bytes are used with budget of " + std::to_string(budget));
+    return false;
+}
+
+Graph *Compiler::createGraph(FunctionId id, utils::TrackingResource *mem, InstructionBuilder *instrBuilder) {
+    auto *graph = utils::template New<Graph>(mem, this, mem, instrBuilder);
+    graph->SetId(id);
+    return graph;
+}
+
+void Compiler::destroyFunction(FunctionData &function) {
+    if (function.graph == nullptr) {
+        return;
+    }
+    auto id = function.graph->GetId();
+    if (function.memory) {
+        // graphs nested into this function's memory become invalid as well
+        for (auto &nested : functionsGraphs) {
+            if (nested.owner == id && nested.graph != nullptr && nested.memory == nullptr) {
+                std::destroy_at(nested.graph);
+                nested.graph = nullptr;
+            }
+        }
+        auto *instrBuilder = function.graph->GetInstructionBuilder();
+        std::destroy_at(function.graph);
+        std::destroy_at(instrBuilder);
+        function.memory->arena.Release();
+    } else {
+        std::destroy_at(function.graph);
+    }
+    function.graph = nullptr;
+}
+
+void Compiler::replaceFunction(FunctionId target, FunctionId source) {
+    ASSERT(target < functionsGraphs.size() && source < functionsGraphs.size());
+    auto &targetFunction = functionsGraphs[target];
+    auto &sourceFunction = functionsGraphs[source];
+    ASSERT(targetFunction.memory && sourceFunction.memory);
+    destroyFunction(targetFunction);
+
+    targetFunction.graph = sourceFunction.graph;
+    targetFunction.graph->SetId(target);
+    targetFunction.memory = std::move(sourceFunction.memory);
+    sourceFunction.graph = nullptr;
+    for (auto &nested : functionsGraphs) {
+        if (nested.owner == source) {
+            nested.owner = target;
+        }
+    }
+    eraseTrailingSlots(source);
+}
+
+void Compiler::eraseTrailingSlots(FunctionId first) {
+    ASSERT(first < functionsGraphs.size());
+    auto begin = functionsGraphs.begin() + first;
+    if (std::all_of(begin, functionsGraphs.end(), [](const FunctionData &f) { return f.graph == nullptr; })) {
+        functionsGraphs.erase(begin, functionsGraphs.end());
+    }
 }
 }   // namespace ir
@@ -2,53 +2,111 @@
 #define JIT_AOT_COMPILERS_COURSE_COMPILER_H_
 
 #include "AllocatorUtils.h"
+#include "Arena.h"
 #include "CompilerBase.h"
 #include "CompilerOptions.h"
+#include <functional>
 #include "InstructionBuilder.h"
+#include <memory>
 #include <memory_resource>
+#include "PassBase.h"
+#include "TrackingResource.h"
 
 
 namespace ir {
+// Each function graph owns a separate arena, which takes memory chunks
+// from the compiler-wide pool. Deleting a function returns all of its
+// IR memory into the pool for reuse by other functions.
+// Allocations of every function are tracked and can be limited
+// via CompilerOptions, both per graph and for all graphs together.
 class Compiler : public CompilerBase {
 public:
-    explicit Compiler(codegen::ArchInfoBase *arch)
-        : memResource(), functionsGraphs(&memResource), arch(arch) {}
+    explicit Compiler(codegen::ArchInfoBase *arch) : chunkPool(), functionsGraphs(), arch(arch) {}
+    NO_COPY_SEMANTIC(Compiler);
+    NO_MOVE_SEMANTIC(Compiler);
+    ~Compiler() noexcept override;
 
     codegen::ArchInfoBase *GetArch() const override {
         return arch;
     }
-    Graph *CreateNewGraph() override {
-        auto *instrBuilder = utils::template New<InstructionBuilder>(&memResource, &memResource);
-        return CreateNewGraph(instrBuilder);
-    }
+    Graph *CreateNewGraph() override;
+    // Creates graph in the memory owned by the given builder's function.
+    // Returns nullptr if the builder does not belong to any of the compiler's functions.
     Graph *CreateNewGraph(InstructionBuilder *instrBuilder);
     Graph *CopyGraph(const Graph *source, InstructionBuilder *instrBuilder) override;
-    Graph *Optimize(Graph *graph) override {
-        // TODO: run optimizations here
-        return graph;
+    Graph *RecreateFunctionGraph(FunctionId functionId) override;
+    // Applies the registered passes to a copy of the graph, which then replaces the original.
+    // Returns the original graph if the optimization was aborted due to exceeded memory limit.
+    Graph *Optimize(Graph *graph) override;
+    // Copies the function's graph into a fresh arena, which then replaces the original one.
+    // Blocks and instructions of the copy are allocated contiguously and numbered densely.
+    // Graphs sharing memory with another function are returned unchanged.
+    Graph *RelocateGraph(Graph *graph);
+    template <typename PassT>
+    void AddOptimizationPass() {
+        optimizationPasses.push_back([](Graph *graph) { PassManager::Run<PassT>(graph); });
     }
     Graph *GetFunction(FunctionId functionId) override {
         if (functionId >= functionsGraphs.size()) {
             return nullptr;
         }
-        return functionsGraphs[functionId];
-    }
-    bool DeleteFunctionGraph(FunctionId functionId) override {
-        if (functionId >= functionsGraphs.size()) {
-            return false;
-        }
-        functionsGraphs.erase(functionsGraphs.begin() + functionId);
-        return true;
+        return functionsGraphs[functionId].graph;
     }
+    bool DeleteFunctionGraph(FunctionId functionId) override;
     const CompilerOptions &GetOptions() const override {
         return options;
     }
+    CompilerOptions &GetOptions() {
+        return options;
+    }
+    // Checked after every optimization pass, as arenas grow by the passes' allocations.
+    bool IsMemoryBudgetExceeded() const override {
+        auto budget = options.GetMemoryBudget();
+        return budget != 0 && chunkPool.GetUsedBytes() > budget;
+    }
+
+    // Bytes currently held by all functions' arenas.
+    size_t GetUsedMemory() const {
+        return chunkPool.GetUsedBytes();
+    }
+    // Bytes currently reserved from the system, including cached chunks.
+    size_t GetReservedMemory() const {
+        return chunkPool.GetReservedBytes();
+    }
+
+private:
+    struct FunctionMemory {
+        explicit FunctionMemory(utils::ChunkPool *pool) : arena(pool), tracker(&arena) {}
+        NO_COPY_SEMANTIC(FunctionMemory);
+        NO_MOVE_SEMANTIC(FunctionMemory);
+        DEFAULT_DTOR(FunctionMemory);
+
+        utils::Arena arena;
+        utils::TrackingResource tracker;
+    };
+
+    struct FunctionData {
+        Graph *graph = nullptr;
+        // nullptr for graphs allocated in another function's memory
+        std::unique_ptr<FunctionMemory> memory = nullptr;
+        FunctionId owner = 0;
+    };
+
+    bool checkMemoryBudget();
+    Graph *createGraph(FunctionId id, utils::TrackingResource *mem, InstructionBuilder *instrBuilder);
+    void destroyFunction(FunctionData &function);
+    // Moves the source function's graph into the target function's place.
+    void replaceFunction(FunctionId target, FunctionId source);
+    // Erases slots of temporary functions starting from the given one, if all of them are deleted,
+    // so that repeated optimizations do not grow the functions' list.
+    void eraseTrailingSlots(FunctionId first);
 
 private:
-    // TODO: limit maximum memory size
-    std::pmr::monotonic_buffer_resource memResource;
+    utils::ChunkPool chunkPool;
+
+    std::vector<FunctionData> functionsGraphs;
 
-    std::pmr::vector<Graph *> functionsGraphs;
+    std::vector<std::function<void(Graph *)>> optimizationPasses;
 
     CompilerOptions options;
 
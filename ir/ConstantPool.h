@@ -0,0 +1,75 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_CONSTANT_POOL_H_
+#define JIT_AOT_COMPILERS_COURSE_CONSTANT_POOL_H_
+
+#include <cstdint>
+#include <functional>
+#include "instructions/Instruction.h"
+#include "macros.h"
+#include <memory_resource>
+#include <unordered_map>
+
+
+namespace ir {
+// Index of the graph's constants keyed by their types and values,
+// used to share a single constant instruction between all its users.
+class ConstantPool final {
+public:
+    explicit ConstantPool(std::pmr::memory_resource *memResource) : constants(memResource) {}
+    NO_COPY_SEMANTIC(ConstantPool);
+    NO_MOVE_SEMANTIC(ConstantPool);
+    DEFAULT_DTOR(ConstantPool);
+
+    ConstantInstruction *Find(OperandType type, uint64_t value) const {
+        auto iter = constants.find(makeKey(type, value));
+        return iter == constants.end() ? nullptr : iter->second;
+    }
+    // Returns the constant equal to the given one, which was added earlier,
+    // or the given constant if there was no such constant in the pool.
+    ConstantInstruction *Insert(ConstantInstruction *instr) {
+        ASSERT(instr);
+        return constants.try_emplace(makeKey(instr->GetType(), instr->GetValue()), instr).first->second;
+    }
+    // Erases the constant if it is the one kept in the pool.
+    void Erase(const ConstantInstruction *instr) {
+        ASSERT(instr);
+        auto iter = constants.find(makeKey(instr->GetType(), instr->GetValue()));
+        if (iter != constants.end() && iter->second == instr) {
+            constants.erase(iter);
+        }
+    }
+    void Clear() {
+        constants.clear();
+    }
+
+    size_t Size() const {
+        return constants.size();
+    }
+
+private:
+    struct Key {
+        OperandType type;
+        uint64_t value;
+
+        bool operator==(const Key &other) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            return std::hash<uint64_t>{}(key.value) * 31 + static_cast<size_t>(key.type);
+        }
+    };
+
+    // Integer values are truncated to their types' sizes, as the same constant
+    // may be passed either sign- or zero-extended.
+    static Key makeKey(OperandType type, uint64_t value) {
+        if (IsIntegerType(type) && GetTypeBitSize(type) < 64) {
+            value &= (1ULL << GetTypeBitSize(type)) - 1;
+        }
+        return {type, value};
+    }
+
+private:
+    std::pmr::unordered_map<Key, ConstantInstruction *, KeyHash> constants;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_CONSTANT_POOL_H_
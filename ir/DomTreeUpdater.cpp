@@ -0,0 +1,288 @@
+#include <algorithm>
+#include "DomTreeUpdater.h"
+
+
+namespace ir {
+bool DomTreeUpdater::InsertEdge(BasicBlock *from, BasicBlock *to) {
+    ASSERT((from) && (to));
+    if (!isInTree(from)) {
+        // edges between unreachable blocks do not affect dominators
+        return true;
+    }
+
+    BasicBlock *root = nullptr;
+    if (isInTree(to)) {
+        root = findCommonDominator(from, to);
+        if (root == to || root == to->GetDominator()) {
+            return true;
+        }
+    } else {
+        collectNewlyReachable(to);
+        root = from;
+        for (auto *bblock : regionBlocks) {
+            for (auto *succ : bblock->GetSuccessors()) {
+                if (isInTree(succ)) {
+                    root = findCommonDominator(root, succ);
+                }
+            }
+        }
+    }
+    collectSubtree(root);
+    orderRegion(root);
+    ASSERT(postOrder.size() == regionBlocks.size());
+    computeDominators();
+    applyDominators(root);
+    return true;
+}
+
+bool DomTreeUpdater::DeleteEdge(BasicBlock *from, BasicBlock *to) {
+    ASSERT((from) && (to));
+    if (!isInTree(from) || dominates(to, from)) {
+        return true;
+    }
+    ASSERT(isInTree(to));
+
+    auto *root = findCommonDominator(from, to);
+    while (true) {
+        collectSubtree(root);
+        orderRegion(root);
+        // blocks becoming unreachable may be the only way to some blocks out of the subtree
+        auto *newRoot = findLeavingDominator(root);
+        if (newRoot == root) {
+            break;
+        }
+        root = newRoot;
+        region.Reset();
+        regionBlocks.clear();
+    }
+    computeDominators();
+    applyDominators(root);
+    return true;
+}
+
+bool DomTreeUpdater::SplitEdge(BasicBlock *newBlock, BasicBlock *pred, BasicBlock *succ) {
+    ASSERT((newBlock) && (pred) && (succ));
+    if (!isInTree(pred)) {
+        return true;
+    }
+    ASSERT(!isInTree(newBlock));
+    const auto &succs = newBlock->GetSuccessors();
+    if (newBlock->GetPredecessorsCount() != 1
+            || !std::ranges::all_of(succs, [succ](auto *bblock) { return bblock == succ; })) {
+        return false;
+    }
+
+    newBlock->SetDominator(pred);
+    pred->AddDominatedBlock(newBlock);
+    // the new block dominates the successor if the latter cannot be entered the other way
+    const auto &preds = succ->GetPredecessors();
+    bool dominatesSucc = std::ranges::all_of(preds, [this, newBlock, succ](auto *bblock) {
+        return bblock == newBlock || !isInTree(bblock) || dominates(succ, bblock);
+    });
+    if (dominatesSucc) {
+        ASSERT(succ->GetDominator() == pred);
+        pred->RemoveDominatedBlock(succ);
+        succ->SetDominator(newBlock);
+        newBlock->AddDominatedBlock(succ);
+    }
+    graph->NumberDomSubtree(pred);
+    return true;
+}
+
+bool DomTreeUpdater::SplitPredecessors(BasicBlock *newBlock, BasicBlock *succ) {
+    ASSERT((newBlock) && (succ) && !isInTree(newBlock));
+    const auto &succs = newBlock->GetSuccessors();
+    if (succs.size() != 1 || succs[0] != succ) {
+        return false;
+    }
+    BasicBlock *idom = nullptr;
+    for (auto *pred : newBlock->GetPredecessors()) {
+        if (isInTree(pred)) {
+            idom = idom ? findCommonDominator(idom, pred) : pred;
+        }
+    }
+    if (idom == nullptr) {
+        return true;
+    }
+
+    newBlock->SetDominator(idom);
+    idom->AddDominatedBlock(newBlock);
+    // the successor's other predecessors, if any, must be reachable only through it
+    const auto &preds = succ->GetPredecessors();
+    bool dominatesSucc = std::ranges::all_of(preds, [this, newBlock, succ](auto *bblock) {
+        return bblock == newBlock || !isInTree(bblock) || dominates(succ, bblock);
+    });
+    if (dominatesSucc) {
+        ASSERT(succ->GetDominator() == idom);
+        idom->RemoveDominatedBlock(succ);
+        succ->SetDominator(newBlock);
+        newBlock->AddDominatedBlock(succ);
+    }
+    graph->NumberDomSubtree(idom);
+    return true;
+}
+
+/* static */
+bool DomTreeUpdater::dominates(const BasicBlock *dominator, const BasicBlock *bblock) {
+    ASSERT((dominator) && (bblock));
+    for (; bblock != nullptr; bblock = bblock->GetDominator()) {
+        if (bblock == dominator) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BasicBlock *DomTreeUpdater::findCommonDominator(BasicBlock *lhs, BasicBlock *rhs) const {
+    ASSERT((lhs) && (rhs));
+    MarkerHolder ancestors(graph);
+    for (auto *bblock = lhs; bblock != nullptr; bblock = bblock->GetDominator()) {
+        bblock->SetMarker(ancestors);
+    }
+    for (auto *bblock = rhs; bblock != nullptr; bblock = bblock->GetDominator()) {
+        if (bblock->IsMarkerSet(ancestors)) {
+            return bblock;
+        }
+    }
+    UNREACHABLE("blocks of the tree must have a common dominator");
+    return nullptr;
+}
+
+void DomTreeUpdater::collectSubtree(BasicBlock *root) {
+    ASSERT(root);
+    auto idx = regionBlocks.size();
+    if (root->SetMarker(region)) {
+        regionBlocks.push_back(root);
+    }
+    for (; idx < regionBlocks.size(); ++idx) {
+        for (auto *child : regionBlocks[idx]->GetDominatedBlocks()) {
+            if (child->SetMarker(region)) {
+                regionBlocks.push_back(child);
+            }
+        }
+    }
+}
+
+void DomTreeUpdater::collectNewlyReachable(BasicBlock *bblock) {
+    ASSERT((bblock) && !isInTree(bblock));
+    auto idx = regionBlocks.size();
+    bblock->SetMarker(region);
+    regionBlocks.push_back(bblock);
+    for (; idx < regionBlocks.size(); ++idx) {
+        for (auto *succ : regionBlocks[idx]->GetSuccessors()) {
+            if (!isInTree(succ) && succ->SetMarker(region)) {
+                regionBlocks.push_back(succ);
+            }
+        }
+    }
+}
+
+void DomTreeUpdater::orderRegion(BasicBlock *root) {
+    ASSERT((root) && root->IsMarkerSet(region) && dfsStack.empty());
+    postOrder.clear();
+    postNumbers.clear();
+    postNumbers.reserve(regionBlocks.size());
+    ordered.Reset();
+    root->SetMarker(ordered);
+    dfsStack.emplace_back(root, 0);
+    while (!dfsStack.empty()) {
+        auto [current, succIdx] = dfsStack.back();
+        const auto &succs = current->GetSuccessors();
+        if (succIdx == succs.size()) {
+            dfsStack.pop_back();
+            postNumbers.emplace(current->GetId(), postOrder.size());
+            postOrder.push_back(current);
+            continue;
+        }
+        ++dfsStack.back().second;
+        auto *succ = succs[succIdx];
+        if (succ->IsMarkerSet(region) && succ->SetMarker(ordered)) {
+            dfsStack.emplace_back(succ, 0);
+        }
+    }
+}
+
+BasicBlock *DomTreeUpdater::findLeavingDominator(BasicBlock *root) const {
+    for (auto *bblock : regionBlocks) {
+        if (bblock->IsMarkerSet(ordered)) {
+            continue;
+        }
+        for (auto *succ : bblock->GetSuccessors()) {
+            if (succ->IsMarkerSet(region) || !isInTree(succ)) {
+                continue;
+            }
+            // the block's dominators are not affected if it dominates the root
+            auto *common = findCommonDominator(root, succ);
+            if (common != succ) {
+                root = common;
+            }
+        }
+    }
+    return root;
+}
+
+void DomTreeUpdater::computeDominators() {
+    ASSERT(!postOrder.empty());
+    auto rootNumber = postOrder.size() - 1;
+    idoms.assign(postOrder.size(), INVALID_NUMBER);
+    idoms[rootNumber] = rootNumber;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        // reverse postorder without the root
+        for (size_t number = rootNumber; number-- > 0;) {
+            auto newIDom = INVALID_NUMBER;
+            for (auto *pred : postOrder[number]->GetPredecessors()) {
+                // skip predecessors, which are unreachable or not processed yet
+                if (!pred->IsMarkerSet(ordered)) {
+                    continue;
+                }
+                auto predNumber = getPostNumber(pred);
+                if (idoms[predNumber] != INVALID_NUMBER) {
+                    newIDom = newIDom == INVALID_NUMBER ? predNumber : intersect(predNumber, newIDom);
+                }
+            }
+            ASSERT(newIDom != INVALID_NUMBER);
+            if (idoms[number] != newIDom) {
+                idoms[number] = newIDom;
+                changed = true;
+            }
+        }
+    }
+}
+
+size_t DomTreeUpdater::intersect(size_t lhs, size_t rhs) const {
+    while (lhs != rhs) {
+        while (lhs < rhs) {
+            lhs = idoms[lhs];
+        }
+        while (rhs < lhs) {
+            rhs = idoms[rhs];
+        }
+    }
+    return lhs;
+}
+
+void DomTreeUpdater::applyDominators(BasicBlock *root) {
+    ASSERT(root);
+    for (auto *bblock : regionBlocks) {
+        bblock->ClearDominatedBlocks();
+    }
+    for (auto *bblock : regionBlocks) {
+        if (bblock == root) {
+            continue;
+        }
+        if (!bblock->IsMarkerSet(ordered)) {
+            // the block has become unreachable
+            bblock->SetDominator(nullptr);
+            graph->NumberUnreachableBlock(bblock);
+            continue;
+        }
+        auto *idom = postOrder[idoms[getPostNumber(bblock)]];
+        bblock->SetDominator(idom);
+        idom->AddDominatedBlock(bblock);
+    }
+    graph->NumberDomSubtree(root);
+}
+}   // namespace ir
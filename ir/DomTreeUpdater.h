@@ -0,0 +1,97 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_DOM_TREE_UPDATER_H_
+#define JIT_AOT_COMPILERS_COURSE_DOM_TREE_UPDATER_H_
+
+#include "Arena.h"
+#include "Graph.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace ir {
+// Updates the graph's dominators tree after a single modification of CFG,
+// which must be applied before the update.
+// Blocks, which are not reachable from the first one, do not belong to the tree.
+// Only the subtree of the nearest common dominator of the modified edge's ends
+// can change, so dominators are recomputed for blocks of this subtree using
+// the iterative algorithm by Cooper, Harvey and Kennedy.
+// Temporary data is sized by the subtree, and only the subtree is renumbered
+// for dominance checks, so that an update does not take time proportional to the graph.
+class DomTreeUpdater final {
+public:
+    explicit DomTreeUpdater(Graph *graph)
+        : graph(graph),
+          region(graph),
+          ordered(graph),
+          regionBlocks(scratch.GetArena()),
+          postOrder(scratch.GetArena()),
+          dfsStack(scratch.GetArena()),
+          postNumbers(scratch.GetArena()),
+          idoms(scratch.GetArena())
+    {
+        ASSERT(graph);
+    }
+    NO_COPY_SEMANTIC(DomTreeUpdater);
+    NO_MOVE_SEMANTIC(DomTreeUpdater);
+    DEFAULT_DTOR(DomTreeUpdater);
+
+    // Each method returns false if the tree cannot be updated and must be rebuilt.
+    bool InsertEdge(BasicBlock *from, BasicBlock *to);
+    bool DeleteEdge(BasicBlock *from, BasicBlock *to);
+    // The new block must be the only successor of the predecessor on the way
+    // to the successor, and have the successor as the only successor.
+    bool SplitEdge(BasicBlock *newBlock, BasicBlock *pred, BasicBlock *succ);
+    // The new block must replace the successor in its predecessors' successors
+    // and have the successor as the only successor.
+    bool SplitPredecessors(BasicBlock *newBlock, BasicBlock *succ);
+
+private:
+    bool isInTree(const BasicBlock *bblock) const {
+        return bblock == graph->GetFirstBasicBlock() || bblock->GetDominator() != nullptr;
+    }
+    // O(depth of the tree) complexity, does not require the tree to be numbered.
+    static bool dominates(const BasicBlock *dominator, const BasicBlock *bblock);
+    BasicBlock *findCommonDominator(BasicBlock *lhs, BasicBlock *rhs) const;
+
+    // Marks the root's subtree as the region to recompute dominators in.
+    void collectSubtree(BasicBlock *root);
+    // Adds blocks, which were unreachable and become reachable through the given one, into the region.
+    void collectNewlyReachable(BasicBlock *bblock);
+    // Orders blocks of the region reachable from its root in postorder.
+    void orderRegion(BasicBlock *root);
+    // Returns the nearest common dominator of the root and the reachable blocks,
+    // which have predecessors in the region becoming unreachable.
+    BasicBlock *findLeavingDominator(BasicBlock *root) const;
+    void computeDominators();
+    size_t intersect(size_t lhs, size_t rhs) const;
+    void applyDominators(BasicBlock *root);
+
+    size_t getPostNumber(const BasicBlock *bblock) const {
+        auto it = postNumbers.find(bblock->GetId());
+        ASSERT(it != postNumbers.end());
+        return it->second;
+    }
+
+private:
+    static constexpr size_t INVALID_NUMBER = static_cast<size_t>(-1);
+
+    utils::ScratchScope scratch;
+
+    Graph *graph;
+
+    // blocks, whose dominators are recomputed
+    MarkerHolder region;
+    // blocks of the region reachable from its root
+    MarkerHolder ordered;
+    std::pmr::vector<BasicBlock *> regionBlocks;
+
+    std::pmr::vector<BasicBlock *> postOrder;
+    std::pmr::vector<std::pair<BasicBlock *, size_t>> dfsStack;
+    // postorder numbers of the ordered blocks
+    std::pmr::unordered_map<BasicBlock::IdType, size_t> postNumbers;
+    // postorder numbers of new immediate dominators, indexed by postorder numbers
+    std::pmr::vector<size_t> idoms;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_DOM_TREE_UPDATER_H_
@@ -1,5 +1,11 @@
 #include <algorithm>
+#include "Arena.h"
+#include "CompilerBase.h"
+#include "DomTreeUpdater.h"
 #include "Graph.h"
+#include "InstructionBuilder.h"
+#include <memory>
+#include <utility>
 
 
 namespace ir {
@@ -24,6 +30,43 @@ bool Graph::VerifyFirstBlock() const {
     return true;
 }
 
+ConstantInstruction *Graph::FindOrCreateConstant(OperandType type, uint64_t value) {
+    auto *instr = constants.Find(type, value);
+    if (instr == nullptr) {
+        ASSERT(firstBlock);
+        instr = instrBuilder->CreateCONST(type, value);
+        // the block adds the constant into the pool
+        firstBlock->PushBackInstruction(instr);
+        ASSERT(constants.Find(type, value) == instr);
+    }
+    return instr;
+}
+
+void Graph::resetConstantPool() {
+    constants.Clear();
+    if (firstBlock == nullptr) {
+        return;
+    }
+    for (auto *instr : *firstBlock) {
+        if (instr->IsConst()) {
+            constants.Insert(instr->AsConst());
+        }
+    }
+}
+
+bool Graph::IsMemoryLimitExceeded() const {
+    return memResource->IsLimitExceeded() || compiler->IsMemoryBudgetExceeded();
+}
+
+void Graph::AddPassMemoryStats(std::type_index pass, const utils::MemoryStats &stats) {
+    auto &total = passesMemoryStats[pass];
+    total.allocatedBytes += stats.allocatedBytes;
+    total.allocationsCount += stats.allocationsCount;
+    total.currentBytes += stats.currentBytes;
+    total.peakBytes = std::max(total.peakBytes, stats.peakBytes);
+    total.scratchBytes += stats.scratchBytes;
+}
+
 size_t Graph::CountInstructions() const {
     size_t counter = 0;
     ForEachBasicBlock([&counter](const BasicBlock *bblock) { counter += bblock->GetSize(); });
@@ -31,7 +74,7 @@ size_t Graph::CountInstructions() const {
 }
 
 BasicBlock *Graph::CreateEmptyBasicBlock(bool isTerminal) {
-    auto *bblock = New<BasicBlock>(this);
+    auto *bblock = new (blocksFreeLists.Allocate(sizeof(BasicBlock))) BasicBlock(this);
     AddBasicBlock(bblock);
     if (isTerminal) {
         if (!GetLastBasicBlock()) {
@@ -42,11 +85,23 @@ BasicBlock *Graph::CreateEmptyBasicBlock(bool isTerminal) {
     return bblock;
 }
 
+template <typename FunctionType>
+void Graph::updateDomTree(FunctionType update) {
+    if (IsAnalysisValid(AnalysisFlag::DOM_TREE)) {
+        DomTreeUpdater updater(this);
+        if (!update(updater)) {
+            SetAnalysisValid<AnalysisFlag::DOM_TREE>(false);
+            domTreeNumbered = false;
+        }
+    }
+}
+
 void Graph::ConnectBasicBlocks(BasicBlock *lhs, BasicBlock *rhs) {
     ASSERT((lhs) && (rhs));
     lhs->AddSuccessor(rhs);
     rhs->AddPredecessor(lhs);
-    invalidateAfterChangedCFG();
+    updateDomTree([lhs, rhs](DomTreeUpdater &updater) { return updater.InsertEdge(lhs, rhs); });
+    invalidateNonIncrementalAnalyses();
 }
 
 void Graph::DisconnectBasicBlocks(BasicBlock *lhs, BasicBlock *rhs) {
@@ -54,7 +109,8 @@ void Graph::DisconnectBasicBlocks(BasicBlock *lhs, BasicBlock *rhs) {
     FixPHIAfterDisconnect(lhs, rhs);
     lhs->RemoveSuccessor(rhs);
     rhs->RemovePredecessor(lhs);
-    invalidateAfterChangedCFG();
+    updateDomTree([lhs, rhs](DomTreeUpdater &updater) { return updater.DeleteEdge(lhs, rhs); });
+    invalidateNonIncrementalAnalyses();
 }
 
 void Graph::InsertBetween(BasicBlock *bblock, BasicBlock *pred, BasicBlock *succ) {
@@ -71,6 +127,55 @@ void Graph::InsertBetween(BasicBlock *bblock, BasicBlock *pred, BasicBlock *succ
             phi->ReplaceSourceBasicBlock(pred, bblock);
         }
     }
+    updateDomTree([bblock, pred, succ](DomTreeUpdater &updater) {
+        return updater.SplitEdge(bblock, pred, succ);
+    });
+}
+
+void Graph::InsertBefore(BasicBlock *bblock, BasicBlock *succ, std::span<BasicBlock *const> preds) {
+    ASSERT((bblock) && (succ) && !preds.empty());
+    ASSERT(bblock->GetPredecessorsCount() == 0 && bblock->GetSuccessorsCount() == 0);
+    if (preds.size() == 1) {
+        InsertBetween(bblock, preds[0], succ);
+        invalidateNonIncrementalAnalyses();
+        return;
+    }
+
+    mergePhiInputs(bblock, succ, preds);
+    for (auto *pred : preds) {
+        pred->ReplaceSuccessor(succ, bblock);
+        bblock->AddPredecessor(pred);
+        succ->RemovePredecessor(pred);
+    }
+    bblock->AddSuccessor(succ);
+    succ->AddPredecessor(bblock);
+    updateDomTree([bblock, succ](DomTreeUpdater &updater) {
+        return updater.SplitPredecessors(bblock, succ);
+    });
+    invalidateNonIncrementalAnalyses();
+}
+
+void Graph::mergePhiInputs(BasicBlock *bblock, BasicBlock *succ, std::span<BasicBlock *const> preds) {
+    ASSERT((bblock) && (succ) && preds.size() > 1);
+    auto *instrBuilder = GetInstructionBuilder();
+    for (auto *phi : succ->IteratePhi()) {
+        InstructionBase *merged = phi->ResolveInput(preds[0]).GetInstruction();
+        bool isSameInput = std::ranges::all_of(preds, [phi, merged](BasicBlock *pred) {
+            return phi->ResolveInput(pred).GetInstruction() == merged;
+        });
+        if (!isSameInput) {
+            auto *newPhi = instrBuilder->CreatePHI(phi->GetType());
+            instrBuilder->PushBackInstruction(bblock, newPhi);
+            for (auto *pred : preds) {
+                newPhi->AddPhiInput(phi->ResolveInput(pred), pred);
+            }
+            merged = newPhi;
+        }
+        for (auto *pred : preds) {
+            phi->RemovePhiInput(pred);
+        }
+        phi->AddPhiInput(merged, bblock);
+    }
 }
 
 void Graph::FixPHIAfterDisconnect(BasicBlock *phiSource, BasicBlock *phiTarget) {
@@ -86,6 +191,7 @@ void Graph::FixPHIAfterDisconnect(BasicBlock *phiSource, BasicBlock *phiTarget)
             ASSERT(remainingInput);
             phi->ReplaceInputInUsers(remainingInput);
             phiTarget->UnlinkInstruction(phi);
+            phi->RemoveUserFromInputs();
         }
     } else if (predsCount > 2) {
         for (auto *phi : phiTarget->IteratePhi()) {
@@ -99,7 +205,11 @@ void Graph::AddBasicBlock(BasicBlock *bblock) {
     bblock->SetId(bblocks.size());
     bblocks.push_back(bblock);
     bblock->SetGraph(this);
-    invalidateAfterChangedCFG();
+    // the block is not reachable yet, so the dominators tree remains valid
+    bblock->SetDominator(nullptr);
+    bblock->ClearDominatedBlocks();
+    NumberUnreachableBlock(bblock);
+    invalidateNonIncrementalAnalyses();
 }
 
 void Graph::AddBasicBlockBefore(BasicBlock *before, BasicBlock *bblock) {
@@ -151,11 +261,67 @@ void Graph::UnlinkBasicBlockRaw(BasicBlock *bblock) {
     bblock->SetGraph(nullptr);
     ++unlinkedInstructionsCounter;
 
-    invalidateAfterChangedCFG();
+    // unreachable blocks are not in the dominators tree
+    if (bblock == firstBlock || bblock->GetDominator() != nullptr) {
+        SetAnalysisValid<AnalysisFlag::DOM_TREE>(false);
+        domTreeNumbered = false;
+    }
+    invalidateNonIncrementalAnalyses();
 }
 
 void Graph::RemoveUnlinkedBlocks() {
-    UNREACHABLE("TBD");
+    std::erase(bblocks, nullptr);
+    for (size_t i = 0, end = bblocks.size(); i < end; ++i) {
+        bblocks[i]->SetId(i);
+    }
+    unlinkedInstructionsCounter = 0;
+}
+
+void Graph::RenumberBasicBlocks(std::span<BasicBlock *const> order) {
+    ASSERT(order.size() <= GetBasicBlocksCount());
+    utils::ScratchScope scratch;
+    std::pmr::vector<bool> ordered(bblocks.size(), false, scratch.GetArena());
+    for (auto *bblock : order) {
+        ASSERT((bblock) && bblock->GetGraph() == this && bblock->GetId() < bblocks.size());
+        ordered[bblock->GetId()] = true;
+    }
+    // blocks missing in the order (e.g. unreachable ones) are kept after the ordered blocks
+    std::pmr::vector<BasicBlock *> rest(scratch.GetArena());
+    for (auto *bblock : bblocks) {
+        if (bblock != nullptr && !ordered[bblock->GetId()]) {
+            rest.push_back(bblock);
+        }
+    }
+    bblocks.assign(order.begin(), order.end());
+    bblocks.insert(bblocks.end(), rest.begin(), rest.end());
+    for (size_t i = 0, end = bblocks.size(); i < end; ++i) {
+        ASSERT((bblocks[i]) && bblocks[i]->GetGraph() == this);
+        bblocks[i]->SetId(i);
+    }
+    // each block must occur once, otherwise it keeps the ID of its last position
+    ASSERT(std::ranges::all_of(std::views::iota(size_t(0), bblocks.size()),
+                               [this](size_t i) { return bblocks[i]->GetId() == i; }));
+    unlinkedInstructionsCounter = 0;
+    // the order of blocks is the linear order, which is recomputed together with the analyses it uses
+    SetAnalysisValid<AnalysisFlag::LINEAR_ORDERING>(false);
+    SetAnalysisValid<AnalysisFlag::LOOP_ANALYSIS>(false);
+    SetAnalysisValid<AnalysisFlag::BLOCK_FREQUENCY>(false);
+}
+
+void Graph::DestroyBasicBlock(BasicBlock *bblock) {
+    ASSERT((bblock) && bblock->GetGraph() == nullptr && bblock->GetId() == BasicBlock::INVALID_ID);
+    auto *instr = bblock->GetFirstPhiInstruction() ? bblock->GetFirstPhiInstruction()
+                                                   : bblock->GetFirstInstruction();
+    while (instr != nullptr) {
+        auto *next = instr->GetNextInstruction();
+        instr->SetPrevInstruction(nullptr);
+        instr->SetNextInstruction(nullptr);
+        instr->SetBasicBlock(nullptr);
+        instrBuilder->DestroyInstruction(instr);
+        instr = next;
+    }
+    std::destroy_at(bblock);
+    blocksFreeLists.Free(bblock, sizeof(BasicBlock));
 }
 
 void Graph::removePredecessors(BasicBlock *bblock) {
@@ -173,10 +339,88 @@ void Graph::removeSuccessors(BasicBlock *bblock) {
     bblock->GetSuccessors().clear();
 }
 
+void Graph::NumberDomTree() {
+    size_t counter = 0;
+    if (firstBlock) {
+        counter = numberDomSubtree(firstBlock, counter, DOM_TREE_NUMBERS_STEP);
+    }
+    domTreeNextNumber = counter;
+    domTreeNumbered = true;
+    // unreachable blocks dominate only themselves
+    ForEachBasicBlock([this](BasicBlock *bblock) {
+        if (bblock != firstBlock && bblock->GetDominator() == nullptr) {
+            NumberUnreachableBlock(bblock);
+        }
+    });
+}
+
+void Graph::NumberDomSubtree(BasicBlock *root) {
+    ASSERT((root) && (root == firstBlock || root->GetDominator() != nullptr));
+    if (!domTreeNumbered) {
+        return;
+    }
+    size_t subtreeSize = 0;
+    utils::ScratchScope scratch;
+    std::pmr::vector<BasicBlock *> worklist(1, root, scratch.GetArena());
+    while (!worklist.empty()) {
+        auto *bblock = worklist.back();
+        worklist.pop_back();
+        ++subtreeSize;
+        worklist.insert(worklist.end(), bblock->GetDominatedBlocks().begin(), bblock->GetDominatedBlocks().end());
+    }
+    // the subtree takes 2 * size numbers, the last one is not assigned
+    auto step = (root->GetDomTreeExit() - root->GetDomTreeEnter()) / (2 * subtreeSize - 1);
+    if (step == 0) {
+        domTreeNumbered = false;
+        return;
+    }
+    numberDomSubtree(root, root->GetDomTreeEnter(), step);
+}
+
+void Graph::NumberUnreachableBlock(BasicBlock *bblock) {
+    ASSERT(bblock);
+    if (domTreeNumbered) {
+        bblock->SetDomTreeInterval(domTreeNextNumber, domTreeNextNumber + 1);
+        domTreeNextNumber += DOM_TREE_NUMBERS_STEP;
+    }
+}
+
+size_t Graph::numberDomSubtree(BasicBlock *root, size_t counter, size_t step) {
+    ASSERT((root) && step != 0);
+    struct StackEntry {
+        BasicBlock *bblock;
+        size_t childIdx;
+        size_t enterNumber;
+    };
+    utils::ScratchScope scratch;
+    std::pmr::vector<StackEntry> dfsStack(scratch.GetArena());
+    dfsStack.push_back({root, 0, counter});
+    counter += step;
+    while (!dfsStack.empty()) {
+        auto &entry = dfsStack.back();
+        const auto &children = entry.bblock->GetDominatedBlocks();
+        if (entry.childIdx == children.size()) {
+            entry.bblock->SetDomTreeInterval(entry.enterNumber, counter);
+            counter += step;
+            dfsStack.pop_back();
+            continue;
+        }
+        auto *child = children[entry.childIdx++];
+        dfsStack.push_back({child, 0, counter});
+        counter += step;
+    }
+    return counter;
+}
+
 void Graph::invalidateAfterChangedCFG() {
     SetAnalysisValid<AnalysisFlag::DOM_TREE>(false);
+    invalidateNonIncrementalAnalyses();
+}
+
+void Graph::invalidateNonIncrementalAnalyses() {
     SetAnalysisValid<AnalysisFlag::LOOP_ANALYSIS>(false);
     SetAnalysisValid<AnalysisFlag::RPO>(false);
     SetAnalysisValid<AnalysisFlag::LINEAR_ORDERING>(false);
+    SetAnalysisValid<AnalysisFlag::BLOCK_FREQUENCY>(false);
 }
 }   // namespace ir
@@ -3,12 +3,19 @@
 
 #include "AnalysisValidityManager.h"
 #include <algorithm>
+#include "AliasInfo.h"
 #include "AllocatorUtils.h"
 #include "BasicBlock.h"
+#include "ConstantPool.h"
+#include "FreeLists.h"
 #include "LiveAnalysisStructs.h"
 #include "macros.h"
 #include "marker/marker.h"
 #include <ranges>
+#include <span>
+#include "TrackingResource.h"
+#include <typeindex>
+#include <unordered_map>
 
 
 namespace ir {
@@ -22,7 +29,7 @@ class Graph : public MarkerManager, public AnalysisValidityManager {
 public:
     using IdType = FunctionId;
 
-    Graph(CompilerBase *compiler, std::pmr::memory_resource *mem, InstructionBuilder *instrBuilder)
+    Graph(CompilerBase *compiler, utils::TrackingResource *mem, InstructionBuilder *instrBuilder)
         : compiler(compiler),
           firstBlock(nullptr),
           lastBlock(nullptr),
@@ -31,7 +38,11 @@ public:
           loopTreeRoot(nullptr),
           instrBuilder(instrBuilder),
           liveIntervals(mem),
-          memResource(mem)
+          aliasInfo(mem),
+          constants(mem),
+          blocksFreeLists(mem),
+          memResource(mem),
+          passesMemoryStats(mem)
     {
         ASSERT(compiler);
         ASSERT(memResource);
@@ -55,6 +66,23 @@ public:
     std::pmr::memory_resource *GetMemoryResource() const {
         return memResource;
     }
+    utils::TrackingResource *GetMemoryTracker() const {
+        return memResource;
+    }
+    const utils::MemoryStats &GetMemoryStats() const {
+        return memResource->GetStats();
+    }
+    // Checks both the graph's own limit and the compiler-wide memory budget.
+    bool IsMemoryLimitExceeded() const;
+    // Returns memory statistics accumulated over all runs of the pass,
+    // or nullptr if the pass has never been run on this graph.
+    template <typename PassT>
+    const utils::MemoryStats *GetPassMemoryStats() const {
+        auto it = passesMemoryStats.find(typeid(PassT));
+        return it == passesMemoryStats.end() ? nullptr : &it->second;
+    }
+    void AddPassMemoryStats(std::type_index pass, const utils::MemoryStats &stats);
+
     template <typename T, typename... ArgsT>
     [[nodiscard]] T *New(ArgsT&&... args) const {
         return utils::template New<T>(GetMemoryResource(), std::forward<ArgsT>(args)...);
@@ -107,9 +135,23 @@ public:
         return loopTreeRoot;
     }
 
+    // Constants located in the first basic block.
+    ConstantPool &GetConstantPool() {
+        return constants;
+    }
+    const ConstantPool &GetConstantPool() const {
+        return constants;
+    }
+    // Returns the graph's constant with the given type and value, a new constant
+    // is created in the first basic block if there is no such constant yet.
+    ConstantInstruction *FindOrCreateConstant(OperandType type, uint64_t value);
+
     InstructionBuilder *GetInstructionBuilder() {
         return instrBuilder;
     }
+    const InstructionBuilder *GetInstructionBuilder() const {
+        return instrBuilder;
+    }
 
     LiveIntervals &GetLiveIntervals() {
         return liveIntervals;
@@ -118,8 +160,16 @@ public:
         return liveIntervals;
     }
 
+    AliasInfo &GetAliasInfo() {
+        return aliasInfo;
+    }
+    const AliasInfo &GetAliasInfo() const {
+        return aliasInfo;
+    }
+
     void SetFirstBasicBlock(BasicBlock *bblock) {
         firstBlock = bblock;
+        resetConstantPool();
         invalidateAfterChangedCFG();
     }
     // Use this method carefully due to special meaning of last basic block.
@@ -159,6 +209,10 @@ public:
     void ConnectBasicBlocks(BasicBlock *lhs, BasicBlock *rhs);
     void DisconnectBasicBlocks(BasicBlock *lhs, BasicBlock *rhs);
     void InsertBetween(BasicBlock *bblock, BasicBlock *pred, BasicBlock *succ);
+    // Redirects edges from the given predecessors of the successor into the new block,
+    // which becomes their common successor and a predecessor of the successor.
+    // Inputs of the successor's PHIs coming from these predecessors are merged in the new block.
+    void InsertBefore(BasicBlock *bblock, BasicBlock *succ, std::span<BasicBlock *const> preds);
     void FixPHIAfterDisconnect(BasicBlock *phiSource, BasicBlock *phiTarget);
     void AddBasicBlock(BasicBlock *bblock);
     void AddBasicBlockBefore(BasicBlock *before, BasicBlock *bblock);
@@ -168,12 +222,36 @@ public:
     // Use this method only if all adjacent blocks will be deleted immediately after.
     void UnlinkBasicBlockRaw(BasicBlock *bblock);
 
+    // Removes holes left by unlinked blocks, so that IDs of blocks become dense.
     void RemoveUnlinkedBlocks();
+    // Assigns IDs to basic blocks according to their positions in the given order,
+    // which must contain each block of the graph at most once. The missing blocks
+    // are numbered after the ordered ones keeping their relative order.
+    // Invalidates the linear ordering, the loops and the blocks' frequencies.
+    void RenumberBasicBlocks(std::span<BasicBlock *const> order);
+    // Destroys unlinked basic block together with its instructions, which must
+    // have no users. Memory of the block is reused for new blocks.
+    void DestroyBasicBlock(BasicBlock *bblock);
+    const utils::FreeListsStats &GetBlocksRecyclingStats() const {
+        return blocksFreeLists.GetStats();
+    }
+
+    // Numbers blocks in DFS over the dominators tree for constant-time dominance checks.
+    // Numbers are spaced, so that incremental updates renumber only the updated subtree
+    // within its root's interval; if the interval is too narrow, the whole tree is renumbered lazily.
+    void NumberDomTree();
+    void NumberDomSubtree(BasicBlock *root);
+    // Unreachable blocks get intervals following the tree's ones.
+    void NumberUnreachableBlock(BasicBlock *bblock);
+    bool IsDomTreeNumbered() const {
+        return domTreeNumbered;
+    }
 
     bool VerifyFirstBlock() const;
 
 public:
     static constexpr IdType INVALID_ID = static_cast<IdType>(-1);
+    static constexpr size_t DOM_TREE_NUMBERS_STEP = 256;
 
     // the classes needs access to `bblocks` field
     friend class LinearOrdering;
@@ -181,7 +259,16 @@ public:
 private:
     void removePredecessors(BasicBlock *bblock);
     void removeSuccessors(BasicBlock *bblock);
+    void mergePhiInputs(BasicBlock *bblock, BasicBlock *succ, std::span<BasicBlock *const> preds);
+    // Keeps the dominators tree valid if it can be updated incrementally.
+    template <typename FunctionType>
+    void updateDomTree(FunctionType update);
+    // Returns the number following the last one assigned in the subtree.
+    size_t numberDomSubtree(BasicBlock *root, size_t counter, size_t step);
     void invalidateAfterChangedCFG();
+    // Invalidates analyses, which are not updated incrementally on CFG modifications.
+    void invalidateNonIncrementalAnalyses();
+    void resetConstantPool();
 
 private:
     IdType id = INVALID_ID;
@@ -195,6 +282,9 @@ private:
     std::pmr::vector<BasicBlock *> bblocks;
     size_t unlinkedInstructionsCounter = 0;
 
+    bool domTreeNumbered = false;
+    size_t domTreeNextNumber = 0;
+
     std::pmr::vector<BasicBlock *> rpoBlocks;
 
     Loop *loopTreeRoot;
@@ -203,7 +293,15 @@ private:
 
     LiveIntervals liveIntervals;
 
-    mutable std::pmr::memory_resource *memResource;
+    AliasInfo aliasInfo;
+
+    ConstantPool constants;
+
+    utils::FreeLists blocksFreeLists;
+
+    mutable utils::TrackingResource *memResource;
+
+    std::pmr::unordered_map<std::type_index, utils::MemoryStats> passesMemoryStats;
 };
 }   // namespace ir
 
@@ -8,6 +8,11 @@ namespace ir {
 Graph *GraphCopyHelper::CreateCopy(const Graph *source, Graph *copyTarget) {
     ASSERT((source) && (copyTarget) && copyTarget->IsEmpty());
     GraphCopyHelper helper(source, copyTarget);
+    auto nextSourceId = source->GetInstructionBuilder()->GetNextId();
+    helper.translationHelper.origToCopy.Reserve(nextSourceId);
+    helper.translationHelper.copyToOrig.Reserve(
+        copyTarget->GetInstructionBuilder()->GetNextId() + nextSourceId);
+    helper.translationHelper.blocksToCopy.Reserve(source->GetMaximumBlockId() + 1);
     helper.dfoCopy(source->GetFirstBasicBlock());
     ASSERT(helper.target->GetBasicBlocksCount() == helper.source->GetBasicBlocksCount());
     helper.fixDFG();
@@ -15,31 +20,47 @@ Graph *GraphCopyHelper::CreateCopy(const Graph *source, Graph *copyTarget) {
     return copyTarget;
 }
 
-void GraphCopyHelper::dfoCopy(const BasicBlock *currentBBlock) {
-    ASSERT((currentBBlock) && !visited.contains(currentBBlock->GetId()));
+void GraphCopyHelper::dfoCopy(const BasicBlock *firstBBlock) {
+    ASSERT(firstBBlock);
+    std::pmr::vector<std::pair<const BasicBlock *, size_t>> stack(scratch.GetArena());
+    copyBlock(firstBBlock);
+    stack.emplace_back(firstBBlock, 0);
+    while (!stack.empty()) {
+        auto [current, succIdx] = stack.back();
+        const auto &succs = current->GetSuccessors();
+        if (succIdx == succs.size()) {
+            stack.pop_back();
+            if (!stack.empty()) {
+                // attach the created copy with its predecessor after visiting the block
+                auto *parent = stack.back().first;
+                target->ConnectBasicBlocks(translationHelper.ToCopy(parent),
+                                           translationHelper.ToCopy(current));
+            }
+            continue;
+        }
+        ++stack.back().second;
+        const auto *succ = succs[succIdx];
+        if (succ->IsMarkerSet(visited)) {
+            target->ConnectBasicBlocks(translationHelper.ToCopy(current), translationHelper.ToCopy(succ));
+        } else {
+            copyBlock(succ);
+            stack.emplace_back(succ, 0);
+        }
+    }
+}
 
-    auto *bblockCopy = currentBBlock->Copy(target, translationHelper);
-    translationHelper.blocksToCopy.insert({currentBBlock->GetId(), bblockCopy});
+void GraphCopyHelper::copyBlock(const BasicBlock *bblock) {
+    ASSERT((bblock) && !bblock->IsMarkerSet(visited));
+    auto *bblockCopy = bblock->Copy(target, translationHelper);
+    translationHelper.blocksToCopy.Insert(bblock->GetId(), bblockCopy);
 
-    if (currentBBlock == source->GetFirstBasicBlock()) {
+    if (bblock == source->GetFirstBasicBlock()) {
         target->SetFirstBasicBlock(bblockCopy);
     }
-    if (currentBBlock == source->GetLastBasicBlock()) {
+    if (bblock == source->GetLastBasicBlock()) {
         target->SetLastBasicBlock(bblockCopy);
     }
-    visited.insert({currentBBlock->GetId(), bblockCopy});
-
-    for (const auto *succ : currentBBlock->GetSuccessors()) {
-        auto succCopyIter = visited.find(succ->GetId());
-        if (succCopyIter != visited.end()) {
-            // basic block was already visited
-            target->ConnectBasicBlocks(bblockCopy, succCopyIter->second);
-        } else {
-            // visit basic block and attach the created copy with its predecessor
-            dfoCopy(succ);
-            target->ConnectBasicBlocks(bblockCopy, visited.at(succ->GetId()));
-        }
-    }
+    bblock->SetMarker(visited);
 }
 
 void GraphCopyHelper::fixDFG() {
@@ -53,8 +74,8 @@ void GraphCopyHelper::fixDFG() {
                 ASSERT(instr->IsCall());
                 auto *callCopy = static_cast<CallInstruction *>(instr);
                 const auto *callOrig = static_cast<const CallInstruction *>(origInstr);
-                for (size_t i = 0, end = callOrig->GetInputsCount(); i < end; ++i) {
-                    callCopy->AddInput(translation.ToCopy(callOrig->GetInput(i)));
+                for (const auto &input : callOrig->GetInputs()) {
+                    callCopy->AddInput(translation.ToCopy(input));
                 }
             } else if (origInstr->IsPhi()) {
                 ASSERT(instr->IsPhi());
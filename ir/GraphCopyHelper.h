@@ -1,6 +1,7 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_GRAPH_COPY_HELPER_H_
 #define JIT_AOT_COMPILERS_COURSE_GRAPH_COPY_HELPER_H_
 
+#include "Arena.h"
 #include "Graph.h"
 #include "GraphTranslationHelper.h"
 #include "InstructionBuilder.h"
@@ -15,22 +16,27 @@ private:
     GraphCopyHelper(const Graph *source, Graph *copyTarget)
         : source(source),
           target(copyTarget),
-          translationHelper(copyTarget->GetMemoryResource()),
-          visited(copyTarget->GetMemoryResource())
+          translationHelper(scratch.GetArena()),
+          visited(source)
     {}
     NO_COPY_SEMANTIC(GraphCopyHelper);
     NO_MOVE_SEMANTIC(GraphCopyHelper);
     DEFAULT_DTOR(GraphCopyHelper);
 
-    void dfoCopy(const BasicBlock *currentBBlock);
+    // Copies blocks in depth-first order using an explicit stack.
+    void dfoCopy(const BasicBlock *firstBBlock);
+    void copyBlock(const BasicBlock *bblock);
     void fixDFG();
 
 private:
+    // helper's data is needed only while copying
+    utils::ScratchScope scratch;
+
     const Graph *source;
     Graph *target;
 
     GraphTranslationHelper translationHelper;
-    std::pmr::unordered_map<BasicBlock::IdType, BasicBlock *> visited;
+    MarkerHolder visited;
 };
 }   // namespace ir
 
@@ -2,29 +2,29 @@
 #define JIT_AOT_COMPILERS_COURSE_GRAPH_TRANSLATION_HELPER_H_
 
 #include "BasicBlock.h"
-#include <unordered_map>
+#include "IdMap.h"
 
 
 namespace ir {
 struct GraphTranslationHelper final {
     // mapping from Instructions' original IDs into corresponding copied instructions
-    std::pmr::unordered_map<InstructionBase::IdType, InstructionBase *> origToCopy;
-    std::pmr::unordered_map<InstructionBase::IdType, const InstructionBase *> copyToOrig;
-    std::pmr::unordered_map<BasicBlock::IdType, BasicBlock *> blocksToCopy;
+    IdMap<InstructionBase *> origToCopy;
+    IdMap<const InstructionBase *> copyToOrig;
+    IdMap<BasicBlock *> blocksToCopy;
 
     explicit GraphTranslationHelper(std::pmr::memory_resource *memResource)
         : origToCopy(memResource), copyToOrig(memResource), blocksToCopy(memResource) {}
 
     bool Verify(size_t instructionsCount) const {
-        return instructionsCount == origToCopy.size() && instructionsCount == copyToOrig.size();
+        return instructionsCount == origToCopy.Size() && instructionsCount == copyToOrig.Size();
     }
 
     void InsertInstructionsPair(const InstructionBase *origInstr, InstructionBase *copyInstr) {
         ASSERT((origInstr) && (copyInstr));
-        ASSERT(!origToCopy.contains(origInstr->GetId()));
-        ASSERT(!copyToOrig.contains(copyInstr->GetId()));
-        origToCopy.insert({origInstr->GetId(), copyInstr});
-        copyToOrig.insert({copyInstr->GetId(), origInstr});
+        [[maybe_unused]] bool inserted = origToCopy.Insert(origInstr->GetId(), copyInstr);
+        ASSERT(inserted);
+        inserted = copyToOrig.Insert(copyInstr->GetId(), origInstr);
+        ASSERT(inserted);
     }
 
     InstructionBase *ToCopy(const InstructionBase *origInstr) const {
@@ -47,20 +47,13 @@ struct GraphTranslationHelper final {
 
     BasicBlock *ToCopy(const BasicBlock *origBlock) const {
         ASSERT(origBlock);
-        auto copyBlock = blocksToCopy.find(origBlock->GetId());
-        ASSERT(copyBlock != blocksToCopy.end());
-        return copyBlock->second;
+        return blocksToCopy.At(origBlock->GetId());
     }
 
 private:
     template <typename ValueT>
-    static inline ValueT translateImpl(
-        const std::pmr::unordered_map<InstructionBase::IdType, ValueT> &mapping,
-        InstructionBase::IdType id)
-    {
-        auto copyInstr = mapping.find(id);
-        ASSERT(copyInstr != mapping.end());
-        return copyInstr->second;
+    static inline ValueT translateImpl(const IdMap<ValueT> &mapping, InstructionBase::IdType id) {
+        return mapping.At(id);
     }
 };
 }   // namespace ir
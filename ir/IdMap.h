@@ -0,0 +1,151 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_ID_MAP_H_
+#define JIT_AOT_COMPILERS_COURSE_ID_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include "macros.h"
+#include <memory_resource>
+#include <vector>
+
+
+namespace ir {
+// Set of dense IDs of instructions or basic blocks.
+class IdSet final {
+public:
+    using IdType = size_t;
+
+    explicit IdSet(std::pmr::memory_resource *memResource, size_t capacity = 0)
+        : bits(capacity, false, memResource) {}
+    DEFAULT_COPY_SEMANTIC(IdSet);
+    DEFAULT_MOVE_SEMANTIC(IdSet);
+    DEFAULT_DTOR(IdSet);
+
+    // Returns true if the ID was not in the set.
+    bool Insert(IdType id) {
+        if (id >= bits.size()) {
+            bits.resize(growCapacity(id), false);
+        }
+        if (bits[id]) {
+            return false;
+        }
+        bits[id] = true;
+        ++count;
+        return true;
+    }
+    bool Contains(IdType id) const {
+        return id < bits.size() && bits[id];
+    }
+    // Returns true if the ID was in the set.
+    bool Erase(IdType id) {
+        if (!Contains(id)) {
+            return false;
+        }
+        bits[id] = false;
+        --count;
+        return true;
+    }
+    void Clear() {
+        bits.assign(bits.size(), false);
+        count = 0;
+    }
+
+    size_t Size() const {
+        return count;
+    }
+    bool IsEmpty() const {
+        return count == 0;
+    }
+    // IDs below the capacity are stored without reallocation.
+    size_t GetCapacity() const {
+        return bits.size();
+    }
+    void Reserve(size_t capacity) {
+        if (capacity > bits.size()) {
+            bits.resize(capacity, false);
+        }
+    }
+
+private:
+    static size_t growCapacity(IdType id) {
+        return std::max(id + 1, id + id / 2);
+    }
+
+private:
+    std::pmr::vector<bool> bits;
+    size_t count = 0;
+};
+
+// Mapping from dense IDs of instructions or basic blocks into values,
+// which are stored in a flat vector indexed by the IDs.
+template <typename T>
+class IdMap final {
+public:
+    using IdType = IdSet::IdType;
+
+    explicit IdMap(std::pmr::memory_resource *memResource, size_t capacity = 0)
+        : values(capacity, memResource), present(memResource, capacity) {}
+    DEFAULT_COPY_SEMANTIC(IdMap);
+    DEFAULT_MOVE_SEMANTIC(IdMap);
+    DEFAULT_DTOR(IdMap);
+
+    // Returns true if the value was inserted, false if the ID was already present.
+    bool Insert(IdType id, const T &value) {
+        if (!present.Insert(id)) {
+            return false;
+        }
+        if (id >= values.size()) {
+            values.resize(present.GetCapacity());
+        }
+        values[id] = value;
+        return true;
+    }
+    bool Contains(IdType id) const {
+        return present.Contains(id);
+    }
+    T &At(IdType id) {
+        ASSERT(Contains(id));
+        return values[id];
+    }
+    const T &At(IdType id) const {
+        ASSERT(Contains(id));
+        return values[id];
+    }
+    // Returns nullptr if the ID is not present.
+    T *Find(IdType id) {
+        return Contains(id) ? &values[id] : nullptr;
+    }
+    const T *Find(IdType id) const {
+        return Contains(id) ? &values[id] : nullptr;
+    }
+    bool Erase(IdType id) {
+        if (!present.Erase(id)) {
+            return false;
+        }
+        values[id] = T();
+        return true;
+    }
+    void Clear() {
+        present.Clear();
+        values.assign(values.size(), T());
+    }
+
+    size_t Size() const {
+        return present.Size();
+    }
+    bool IsEmpty() const {
+        return present.IsEmpty();
+    }
+    void Reserve(size_t capacity) {
+        present.Reserve(capacity);
+        if (capacity > values.size()) {
+            values.resize(capacity);
+        }
+    }
+
+private:
+    std::pmr::vector<T> values;
+    IdSet present;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_ID_MAP_H_
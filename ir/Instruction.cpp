@@ -9,8 +9,8 @@ void CompareInstruction::Inverse() {
     std::tie(GetInput(0), GetInput(1)) = std::make_tuple(GetInput(1), GetInput(0));
 }
 
-void PhiInstruction::dumpImpl(log4cpp::CategoryStream &stream) const {
-    InstructionBase::dumpImpl(stream);
+void PhiInstruction::DumpImpl(log4cpp::CategoryStream &stream) const {
+    InstructionBase::DumpImpl(stream);
     for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
         ASSERT((GetInput(i).GetInstruction()) && (GetSourceBasicBlock(i)));
         stream << " <#" << GetInput(i)->GetId() << ", BB #" << GetSourceBasicBlock(i)->GetId() << '>';
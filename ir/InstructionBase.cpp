@@ -1,8 +1,23 @@
 #include <array>
 #include "BasicBlock.h"
+#include "Graph.h"
 
 
 namespace ir {
+log4cpp::CategoryStream InstructionBase::Dump(log4cpp::Category &logger) const {
+    auto stream = logger << utils::LogPriority::INFO;
+    VisitInstruction(this, [&stream](const auto *typed) { typed->DumpImpl(stream); });
+    // dump users
+    if (HasUsers()) {
+        stream << "\t(";
+        for (const auto *use = GetFirstUse(); use != nullptr; use = use->GetNextUse()) {
+            ASSERT(use->GetUser());
+            stream << use->GetUser()->GetId() << (use->GetNextUse() ? ", " : ")");
+        }
+    }
+    return stream;
+}
+
 Input InstructionBase::ToInput() {
     return {this};
 }
@@ -51,16 +66,7 @@ bool InstructionBase::Dominates(const InstructionBase *other) const {
 
 bool InstructionBase::isEarlierInBasicBlock(const InstructionBase *other) const {
     ASSERT((other) && (GetBasicBlock()) && other->GetBasicBlock() == GetBasicBlock());
-    for (auto *instr : *GetBasicBlock()) {
-        if (instr == this) {
-            return true;
-        }
-        if (instr == other) {
-            return false;
-        }
-    }
-    UNREACHABLE("must have encountered either this or other instruction");
-    return false;
+    return GetBasicBlock()->IsEarlier(this, other);
 }
 
 void InstructionBase::UnlinkFromParent() {
@@ -79,11 +85,15 @@ void InstructionBase::InsertAfter(InstructionBase *after) {
 }
 
 void InstructionBase::ReplaceInputInUsers(InstructionBase *newInput) {
-    newInput->AddUsers(GetUsers());
-    for (auto &it : GetUsers()) {
-        ASSERT(it->HasInputs());
-        auto *typed = static_cast<InputsInstruction *>(it);
-        typed->ReplaceInput(this, newInput);
+    ASSERT((newInput) && newInput != this);
+    // the users may reference memory through other bases
+    if (auto *bblock = GetBasicBlock()) {
+        bblock->GetGraph()->SetAnalysisValid<AnalysisFlag::ALIAS_ANALYSIS>(false);
+    }
+    // every retargeted use moves itself into the new input's users
+    while (auto *use = GetFirstUse()) {
+        ASSERT(use->GetUser() && use->GetUser()->HasInputs());
+        use->SetInstruction(newInput);
     }
 }
 }   // namespace ir
@@ -2,9 +2,12 @@
 #define JIT_AOT_COMPILERS_COURSE_INSTRUCTION_BUILDER_H_
 
 #include "Concepts.h"
+#include "FreeLists.h"
 #include "Graph.h"
 #include "instructions/Instruction.h"
 #include "macros.h"
+#include <memory>
+#include <utility>
 #include <vector>
 
 
@@ -15,7 +18,8 @@ namespace ir {
 // in order to prevent dangling pointers.
 class InstructionBuilder {
 public:
-    explicit InstructionBuilder(std::pmr::memory_resource *memResource) : allocator(memResource)
+    explicit InstructionBuilder(std::pmr::memory_resource *memResource)
+        : allocator(memResource), freeLists(memResource)
     {
         ASSERT(memResource);
     }
@@ -23,6 +27,35 @@ public:
     NO_MOVE_SEMANTIC(InstructionBuilder);
     virtual DEFAULT_DTOR(InstructionBuilder);
 
+    std::pmr::memory_resource *GetMemoryResource() const {
+        return allocator.resource();
+    }
+
+    // IDs of all instructions created by the builder are less than the returned value.
+    InstructionBase::IdType GetNextId() const {
+        return currentId;
+    }
+
+    // Must be used only after all instructions created by the builder were renumbered
+    // below the given value or destroyed.
+    void ResetNextId(InstructionBase::IdType nextId) {
+        ASSERT(nextId <= currentId);
+        currentId = nextId;
+    }
+
+    // Destroys instruction, which must be unlinked from its basic block and have no users.
+    // Its memory is reused for new instructions.
+    void DestroyInstruction(InstructionBase *inst) {
+        ASSERT((inst) && inst->GetBasicBlock() == nullptr && !inst->HasUsers());
+        VisitInstruction(inst, [this]<typename T>(T *typed) {
+            std::destroy_at(typed);
+            freeLists.Free(typed, sizeof(T));
+        });
+    }
+    const utils::FreeListsStats &GetRecyclingStats() const {
+        return freeLists.GetStats();
+    }
+
     void AttachInstruction(InstructionBase *inst) {
         ASSERT((inst) && (inst->GetId() == InstructionBase::INVALID_ID));
         inst->SetId(currentId++);
@@ -56,70 +89,36 @@ public:
         PushForwardInstruction(bblock, reminder...);
     }
 
-#define CREATE_FIXED_INST(name)                                                 \
-    auto *inst = utils::template New<name>(allocator, allocator.resource());    \
-    inst->SetId(currentId++);                                                   \
+#define CREATE_FIXED_INST(name)                                 \
+    auto *inst = newInstruction<name>(allocator.resource());    \
+    inst->SetId(currentId++);                                   \
     return inst
 
-#define CREATE_INST(name, ...)                                                              \
-    auto *inst = utils::template New<name>(allocator, __VA_ARGS__, allocator.resource());   \
-    inst->SetId(currentId++);                                                               \
+#define CREATE_INST(name, ...)                                              \
+    auto *inst = newInstruction<name>(__VA_ARGS__, allocator.resource());   \
+    inst->SetId(currentId++);                                               \
     return inst
 
-#define CREATE_INST_WITH_PROP(name, prop, ...)                                              \
-    auto *inst = utils::template New<name>(allocator, __VA_ARGS__, allocator.resource());   \
-    inst->SetId(currentId++);                                                               \
-    inst->SetProperty(prop);                                                                \
-    return inst
-
-#define CREATE_ARITHM(opcode)                                                                   \
-    BinaryRegInstruction *Create##opcode(OperandType type, Input in1, Input in2) {              \
-        CREATE_INST_WITH_PROP(BinaryRegInstruction, ARITHM, Opcode::opcode, type, in1, in2);    \
-    }
-
-#define CREATE_COMMUTABLE_ARITHM(opcode)                                                    \
-    BinaryRegInstruction *Create##opcode(OperandType type, Input in1, Input in2) {          \
-        auto prop = ARITHM | utils::to_underlying(InstrProp::COMMUTABLE);                   \
-        CREATE_INST_WITH_PROP(BinaryRegInstruction, prop, Opcode::opcode, type, in1, in2);  \
+#define CREATE_ARITHM(opcode)                                                       \
+    BinaryRegInstruction *Create##opcode(OperandType type, Input in1, Input in2) {  \
+        CREATE_INST(BinaryRegInstruction, Opcode::opcode, type, in1, in2);          \
     }
 
-#define CREATE_IMM_INST(opcode)                                                                 \
-    template <ValidOpType T>                                                                    \
-    BinaryImmInstruction *Create##opcode(OperandType type, Input input, T imm) {                \
-        CREATE_INST_WITH_PROP(BinaryImmInstruction, ARITHM, Opcode::opcode, type, input, imm);  \
+#define CREATE_IMM_INST(opcode)                                                     \
+    template <ValidOpType T>                                                        \
+    BinaryImmInstruction *Create##opcode(OperandType type, Input input, T imm) {    \
+        CREATE_INST(BinaryImmInstruction, Opcode::opcode, type, input, imm);        \
     }
 
-#define CREATE_IMM_INST_WITH_PROP(opcode, prop)                                                 \
-    template <ValidOpType T>                                                                    \
-    BinaryImmInstruction *Create##opcode(OperandType type, Input input, T imm) {                \
-        CREATE_INST_WITH_PROP(BinaryImmInstruction, prop, Opcode::opcode, type, input, imm);    \
-    }
-
-    CREATE_COMMUTABLE_ARITHM(AND)
-    CREATE_COMMUTABLE_ARITHM(OR)
-    CREATE_COMMUTABLE_ARITHM(XOR)
-    CREATE_COMMUTABLE_ARITHM(ADD)
-    CREATE_COMMUTABLE_ARITHM(MUL)
+    CREATE_ARITHM(AND)
+    CREATE_ARITHM(OR)
+    CREATE_ARITHM(XOR)
+    CREATE_ARITHM(ADD)
+    CREATE_ARITHM(MUL)
 
     CREATE_ARITHM(SUB)
-    BinaryRegInstruction *CreateDIV(OperandType type, Input in1, Input in2) {
-        CREATE_INST_WITH_PROP(
-            BinaryRegInstruction,
-            SIDE_EFFECTS_ARITHM,
-            Opcode::DIV,
-            type,
-            in1,
-            in2);
-    }
-    BinaryRegInstruction *CreateMOD(OperandType type, Input in1, Input in2) {
-        CREATE_INST_WITH_PROP(
-            BinaryRegInstruction,
-            SIDE_EFFECTS_ARITHM,
-            Opcode::MOD,
-            type,
-            in1,
-            in2);
-    }
+    CREATE_ARITHM(DIV)
+    CREATE_ARITHM(MOD)
     CREATE_ARITHM(SRA)
     CREATE_ARITHM(SLA)
     CREATE_ARITHM(SLL)
@@ -130,34 +129,27 @@ public:
     CREATE_IMM_INST(ADDI)
     CREATE_IMM_INST(SUBI)
     CREATE_IMM_INST(MULI)
-    CREATE_IMM_INST_WITH_PROP(DIVI, SIDE_EFFECTS_ARITHM)
-    CREATE_IMM_INST_WITH_PROP(MODI, SIDE_EFFECTS_ARITHM)
+    CREATE_IMM_INST(DIVI)
+    CREATE_IMM_INST(MODI)
     CREATE_IMM_INST(SRAI)
     CREATE_IMM_INST(SLAI)
     CREATE_IMM_INST(SLLI)
 
     UnaryRegInstruction *CreateNOT(OperandType type, Input input) {
-        CREATE_INST_WITH_PROP(UnaryRegInstruction, ARITHM, Opcode::NOT, type, input);
+        CREATE_INST(UnaryRegInstruction, Opcode::NOT, type, input);
     }
     UnaryRegInstruction *CreateNEG(OperandType type, Input input) {
-        CREATE_INST_WITH_PROP(UnaryRegInstruction, ARITHM, Opcode::NEG, type, input);
+        CREATE_INST(UnaryRegInstruction, Opcode::NEG, type, input);
     }
     template <ValidOpType T>
     ConstantInstruction *CreateCONST(OperandType type, T imm) {
         CREATE_INST(ConstantInstruction, Opcode::CONST, type, imm);
     }
     CastInstruction *CreateCAST(OperandType fromType, OperandType toType, Input input) {
-        CREATE_INST_WITH_PROP(CastInstruction, InstrProp::INPUT, fromType, toType, input);
+        CREATE_INST(CastInstruction, fromType, toType, input);
     }
     CompareInstruction *CreateCMP(OperandType type, CondCode ccode, Input in1, Input in2) {
-        CREATE_INST_WITH_PROP(
-            CompareInstruction,
-            INPUT_SIDE_EFFECTS,
-            Opcode::CMP,
-            type,
-            ccode,
-            in1,
-            in2);
+        CREATE_INST(CompareInstruction, Opcode::CMP, type, ccode, in1, in2);
     }
     CondJumpInstruction *CreateJCMP() {
         CREATE_FIXED_INST(CondJumpInstruction);
@@ -166,118 +158,69 @@ public:
         CREATE_INST(JumpInstruction, Opcode::JMP);
     }
     RetInstruction *CreateRET(OperandType type, Input input) {
-        CREATE_INST_WITH_PROP(
-            RetInstruction,
-            utils::underlying_logic_or(InstrProp::CF, InstrProp::INPUT, InstrProp::SIDE_EFFECTS),
-            type,
-            input);
+        CREATE_INST(RetInstruction, type, input);
     }
     RetVoidInstruction *CreateRETVOID() {
         CREATE_FIXED_INST(RetVoidInstruction);
     }
 
     CallInstruction *CreateCALL(OperandType type, FunctionId target) {
-        CREATE_INST_WITH_PROP(CallInstruction, INPUT_SIDE_EFFECTS, type, target);
+        CREATE_INST(CallInstruction, type, target);
     }
     template <AllowedInputType Ins>
     CallInstruction *CreateCALL(OperandType type, FunctionId target,
                                 std::initializer_list<Ins> arguments) {
-        CREATE_INST_WITH_PROP(CallInstruction, INPUT_SIDE_EFFECTS, type, target, arguments);
+        CREATE_INST(CallInstruction, type, target, arguments);
     }
     template <AllowedInputType Ins, typename AllocatorT>
     CallInstruction *CreateCALL(OperandType type, FunctionId target,
                                 std::vector<Ins, AllocatorT> arguments) {
-        CREATE_INST_WITH_PROP(CallInstruction, INPUT_SIDE_EFFECTS, type, target, arguments);
+        CREATE_INST(CallInstruction, type, target, arguments);
     }
 
     LengthInstruction *CreateLEN(Input array) {
-        CREATE_INST_WITH_PROP(LengthInstruction, INPUT_MEM, array);
+        CREATE_INST(LengthInstruction, array);
     }
 
     NewArrayInstruction *CreateNEW_ARRAY(Input length, TypeId typeId) {
-        CREATE_INST_WITH_PROP(
-            NewArrayInstruction,
-            INPUT_MEM,
-            length,
-            typeId);
+        CREATE_INST(NewArrayInstruction, length, typeId);
     }
     NewArrayImmInstruction *CreateNEW_ARRAY_IMM(uint64_t length, TypeId typeId) {
-        CREATE_INST_WITH_PROP(
-            NewArrayImmInstruction,
-            utils::underlying_logic_or(InstrProp::MEM, InstrProp::SIDE_EFFECTS),
-            length,
-            typeId);
+        CREATE_INST(NewArrayImmInstruction, length, typeId);
     }
     NewObjectInstruction *CreateNEW_OBJECT(TypeId typeId) {
-        CREATE_INST_WITH_PROP(
-            NewObjectInstruction,
-            utils::underlying_logic_or(InstrProp::MEM, InstrProp::SIDE_EFFECTS),
-            typeId);
+        CREATE_INST(NewObjectInstruction, typeId);
     }
 
     LoadArrayInstruction *CreateLOAD_ARRAY(OperandType type, Input array, Input idx) {
-        CREATE_INST_WITH_PROP(
-            LoadArrayInstruction,
-            INPUT_MEM,
-            type,
-            array,
-            idx);
+        CREATE_INST(LoadArrayInstruction, type, array, idx);
     }
     LoadImmInstruction *CreateLOAD_ARRAY_IMM(OperandType type, Input array, uint64_t idx) {
-        CREATE_INST_WITH_PROP(
-            LoadImmInstruction,
-            INPUT_MEM,
-            Opcode::LOAD_ARRAY_IMM,
-            type,
-            array,
-            idx);
+        CREATE_INST(LoadImmInstruction, Opcode::LOAD_ARRAY_IMM, type, array, idx);
     }
     LoadImmInstruction *CreateLOAD_OBJECT(OperandType type, Input obj, uint64_t offset) {
-        CREATE_INST_WITH_PROP(
-            LoadImmInstruction,
-            INPUT_MEM,
-            Opcode::LOAD_OBJECT,
-            type,
-            obj,
-            offset);
+        CREATE_INST(LoadImmInstruction, Opcode::LOAD_OBJECT, type, obj, offset);
     }
 
     StoreArrayInstruction *CreateSTORE_ARRAY(Input array, Input storedValue, Input idx) {
-        CREATE_INST_WITH_PROP(
-            StoreArrayInstruction,
-            INPUT_MEM,
-            array,
-            storedValue,
-            idx);
+        CREATE_INST(StoreArrayInstruction, array, storedValue, idx);
     }
     StoreImmInstruction *CreateSTORE_ARRAY_IMM(Input array, Input storedValue, uint64_t idx) {
-        CREATE_INST_WITH_PROP(
-            StoreImmInstruction,
-            INPUT_MEM,
-            Opcode::STORE_ARRAY_IMM,
-            array,
-            storedValue,
-            idx);
+        CREATE_INST(StoreImmInstruction, Opcode::STORE_ARRAY_IMM, array, storedValue, idx);
     }
     StoreImmInstruction *CreateSTORE_OBJECT(Input obj, Input storedValue, uint64_t offset) {
-        CREATE_INST_WITH_PROP(
-            StoreImmInstruction,
-            INPUT_MEM,
-            Opcode::STORE_OBJECT,
-            obj,
-            storedValue,
-            offset);
+        CREATE_INST(StoreImmInstruction, Opcode::STORE_OBJECT, obj, storedValue, offset);
     }
 
     PhiInstruction *CreatePHI(OperandType type) {
-        CREATE_INST_WITH_PROP(PhiInstruction, InstrProp::INPUT, type);
+        CREATE_INST(PhiInstruction, type);
     }
     template <typename Ins, typename Sources>
     PhiInstruction *CreatePHI(OperandType type, Ins inputs, Sources sources)
     requires std::is_same_v<std::remove_cv_t<typename Sources::value_type>, BasicBlock *>
              && AllowedInputType<typename Ins::value_type>
     {
-        CREATE_INST_WITH_PROP(PhiInstruction, InstrProp::INPUT, type, inputs, sources);
+        CREATE_INST(PhiInstruction, type, inputs, sources);
     }
     template <typename Sources>
     PhiInstruction *CreatePHI(
@@ -286,7 +229,7 @@ public:
         std::initializer_list<Sources> sources)
     requires std::is_same_v<std::remove_cv_t<Sources>, BasicBlock *>
     {
-        CREATE_INST_WITH_PROP(PhiInstruction, InstrProp::INPUT, type, inputs, sources);
+        CREATE_INST(PhiInstruction, type, inputs, sources);
     }
 
     InputArgumentInstruction *CreateARG(OperandType type) {
@@ -294,62 +237,36 @@ public:
     }
 
     UnaryRegInstruction *CreateNULL_CHECK(Input input) {
-        CREATE_INST_WITH_PROP(
-            UnaryRegInstruction,
-            INPUT_SIDE_EFFECTS,
-            Opcode::NULL_CHECK,
-            OperandType::INVALID,
-            input);
+        CREATE_INST(UnaryRegInstruction, Opcode::NULL_CHECK, OperandType::INVALID, input);
     }
     UnaryRegInstruction *CreateZERO_CHECK(Input input) {
-        CREATE_INST_WITH_PROP(
-            UnaryRegInstruction,
-            INPUT_SIDE_EFFECTS,
-            Opcode::ZERO_CHECK,
-            OperandType::INVALID,
-            input);
+        CREATE_INST(UnaryRegInstruction, Opcode::ZERO_CHECK, OperandType::INVALID, input);
     }
     UnaryRegInstruction *CreateNEGATIVE_CHECK(Input input) {
-        CREATE_INST_WITH_PROP(
-            UnaryRegInstruction,
-            INPUT_SIDE_EFFECTS,
-            Opcode::NEGATIVE_CHECK,
-            OperandType::INVALID,
-            input);
+        CREATE_INST(UnaryRegInstruction, Opcode::NEGATIVE_CHECK, OperandType::INVALID, input);
     }
     BoundsCheckInstruction *CreateBOUNDS_CHECK(Input arr, Input idx) {
-        CREATE_INST_WITH_PROP(BoundsCheckInstruction, INPUT_SIDE_EFFECTS, arr, idx);
+        CREATE_INST(BoundsCheckInstruction, arr, idx);
     }
     // Utility instruction to fix PHIs data flow before codegen.
     UnaryRegInstruction *CreateMOVE(Input input) {
-        CREATE_INST_WITH_PROP(
-            UnaryRegInstruction,
-            InstrProp::INPUT,
-            Opcode::MOVE,
-            input->GetType(),
-            input);
+        CREATE_INST(UnaryRegInstruction, Opcode::MOVE, input->GetType(), input);
     }
 
 #undef CREATE_FIXED_INST
 #undef CREATE_INST
-#undef CREATE_INST_WITH_PROP
 #undef CREATE_ARITHM
-#undef CREATE_COMMUTABLE_ARITHM
 #undef CREATE_IMM_INST
-#undef CREATE_IMM_INST_WITH_PROP
 
 private:
-    static constexpr InstructionPropT ARITHM =
-        utils::underlying_logic_or(InstrProp::ARITH, InstrProp::INPUT);
-    static constexpr InstructionPropT SIDE_EFFECTS_ARITHM =
-        utils::underlying_logic_or(InstrProp::ARITH, InstrProp::INPUT, InstrProp::SIDE_EFFECTS);
-    static constexpr InstructionPropT INPUT_SIDE_EFFECTS =
-        utils::underlying_logic_or(InstrProp::INPUT, InstrProp::SIDE_EFFECTS);
-    static constexpr InstructionPropT INPUT_MEM =
-        utils::underlying_logic_or(InstrProp::INPUT, InstrProp::MEM, InstrProp::SIDE_EFFECTS);
+    template <typename T, typename... ArgsT>
+    T *newInstruction(ArgsT&&... args) {
+        return new (freeLists.Allocate(sizeof(T))) T(std::forward<ArgsT>(args)...);
+    }
 
 private:
     std::pmr::polymorphic_allocator<> allocator;
+    utils::FreeLists freeLists;
 
     InstructionBase::IdType currentId = 0;
 };
@@ -2,13 +2,18 @@
 
 
 namespace ir {
-// implement Copy overrided methods for general classes
+InstructionBase *InstructionBase::Copy(BasicBlock *targetBBlock) const {
+    return VisitInstruction(this, [targetBBlock](const auto *typed) -> InstructionBase * {
+        return typed->Copy(targetBBlock);
+    });
+}
+
+// implement Copy methods for general classes
 #define OVERRIDE_GENERAL_CLASS_COPY(name, ...)                                          \
 name *name::Copy(BasicBlock *targetBBlock) const {                                      \
     auto *graph = targetBBlock->GetGraph();                                             \
     auto *instr = graph->template New<name>(__VA_ARGS__, graph->GetMemoryResource());   \
     graph->GetInstructionBuilder()->AttachInstruction(instr);                           \
-    instr->SetProperty(GetProperties());                                                \
     return instr;                                                                       \
 }
 
@@ -1,10 +1,13 @@
 #include "Graph.h"
 #include "LiveAnalysisStructs.h"
+#include <algorithm>
+#include <memory>
 
 
 namespace ir {
 LiveInterval::LiveInterval(std::initializer_list<LiveRange> init, InstructionBase *in)
     : ranges(init, in->GetBasicBlock()->GetGraph()->GetMemoryResource()),
+      uses(in->GetBasicBlock()->GetGraph()->GetMemoryResource()),
       liveNumber(init.begin()->GetBegin()),
       instr(in)
 {}
@@ -21,24 +24,205 @@ void LiveInterval::SetBegin(LiveRange::RangeType begin) {
 void LiveInterval::AddRange(const LiveRange &rng) {
     if (ranges.empty()) {
         ranges.push_back(rng);
-    } else {
-        auto &earliest = ranges.back();
-        if (rng.LeftAdjacent(earliest)) {
-            earliest.SetBegin(rng.GetBegin());
-        } else if (rng < earliest) {
-            ranges.push_back(rng);
+        return;
+    }
+    if (rng.LeftAdjacent(ranges.back())) {
+        ranges.back().SetBegin(rng.GetBegin());
+        return;
+    }
+    if (rng < ranges.back()) {
+        ranges.push_back(rng);
+        return;
+    }
+    // ranges overlapping or adjacent to the new one (e.g. the range of a whole loop) form
+    // a contiguous sequence, which is merged into a single range
+    auto first = std::ranges::partition_point(ranges, [&rng](const LiveRange &r) {
+        return r.GetBegin() > rng.GetEnd();
+    });
+    auto last = std::find_if(first, ranges.end(), [&rng](const LiveRange &r) {
+        return r.GetEnd() < rng.GetBegin();
+    });
+    if (first == last) {
+        ranges.insert(first, rng);
+        return;
+    }
+    *first = LiveRange(std::min(rng.GetBegin(), std::prev(last)->GetBegin()),
+                       std::max(rng.GetEnd(), first->GetEnd()));
+    ranges.erase(std::next(first), last);
+}
+
+bool LiveInterval::Covers(LiveRange::RangeType position) const {
+    auto iter = findRange(position);
+    return iter != end() && iter->GetBegin() <= position;
+}
+
+LiveRange::RangeType LiveInterval::NextIntersection(const LiveInterval &other, LiveRange::RangeType from) const {
+    auto lhs = findRange(from);
+    auto rhs = other.findRange(from);
+    while (lhs != end() && rhs != other.end()) {
+        auto begin = std::max({lhs->GetBegin(), rhs->GetBegin(), from});
+        if (begin < std::min(lhs->GetEnd(), rhs->GetEnd())) {
+            return begin;
+        }
+        if (lhs->GetEnd() <= rhs->GetEnd()) {
+            ++lhs;
         } else {
-            ASSERT(earliest.Includes(rng));
+            ++rhs;
         }
     }
+    return LiveRange::INVALID_RANGE;
+}
+
+void LiveInterval::AddUsePosition(LiveRange::RangeType position, bool requiresRegister) {
+    if (uses.empty() || uses.back().position > position) {
+        uses.push_back({position, requiresRegister});
+        return;
+    }
+    auto iter = std::ranges::partition_point(uses, [position](const UsePosition &use) {
+        return use.position > position;
+    });
+    if (iter != uses.end() && iter->position == position) {
+        // the same user may take the value several times
+        iter->requiresRegister |= requiresRegister;
+    } else {
+        uses.insert(iter, {position, requiresRegister});
+    }
+}
+
+LiveRange::RangeType LiveInterval::NextUsePosition(LiveRange::RangeType from) const {
+    auto iter = findUse(from);
+    return iter == uses.rend() ? LiveRange::INVALID_RANGE : iter->position;
+}
+
+LiveRange::RangeType LiveInterval::NextRegisterUsePosition(LiveRange::RangeType from) const {
+    auto iter = std::find_if(findUse(from), uses.rend(), [](const UsePosition &use) {
+        return use.requiresRegister;
+    });
+    return iter == uses.rend() ? LiveRange::INVALID_RANGE : iter->position;
+}
+
+LiveIntervals::~LiveIntervals() noexcept {
+    Clear();
+    auto *memResource = chunks.get_allocator().resource();
+    for (auto *chunk : chunks) {
+        memResource->deallocate(chunk, CHUNK_SIZE * sizeof(LiveInterval), alignof(LiveInterval));
+    }
 }
 
 LiveInterval *LiveIntervals::AddLiveInterval(LiveRange::RangeType liveNum, InstructionBase *instr) {
     ASSERT(instr);
-    instr->SetLinearNumber(liveIntervals.size());
-    auto *info = utils::template New<LiveInterval>(
-        instr->GetBasicBlock()->GetGraph()->GetMemoryResource(), liveNum, instr);
+    auto idx = liveIntervals.size();
+    instr->SetLinearNumber(idx);
+    auto *memResource = chunks.get_allocator().resource();
+    if (idx / CHUNK_SIZE == chunks.size()) {
+        chunks.push_back(static_cast<LiveInterval *>(
+            memResource->allocate(CHUNK_SIZE * sizeof(LiveInterval), alignof(LiveInterval))));
+    }
+    auto *info = new (chunks[idx / CHUNK_SIZE] + idx % CHUNK_SIZE) LiveInterval(liveNum, instr, memResource);
     liveIntervals.push_back(info);
     return info;
 }
+
+void LiveIntervals::Clear() {
+    // chunks are kept for the following intervals
+    std::ranges::for_each(liveIntervals, [](LiveInterval *info) { std::destroy_at(info); });
+    liveIntervals.clear();
+}
+
+void LiveSet::Add(size_t number) {
+    if (dense) {
+        reserveWords(number);
+        words[number / WORD_BITS] |= WordType(1) << (number % WORD_BITS);
+    } else if (std::ranges::find(numbers, number) == numbers.end()) {
+        numbers.push_back(number);
+        if (numbers.size() > SPARSE_LIMIT) {
+            makeDense();
+        }
+    }
+}
+
+bool LiveSet::Remove(size_t number) {
+    if (dense) {
+        if (!Contains(number)) {
+            return false;
+        }
+        words[number / WORD_BITS] &= ~(WordType(1) << (number % WORD_BITS));
+        return true;
+    }
+    auto it = std::ranges::find(numbers, number);
+    if (it == numbers.end()) {
+        return false;
+    }
+    *it = numbers.back();
+    numbers.pop_back();
+    return true;
+}
+
+bool LiveSet::Contains(size_t number) const {
+    if (dense) {
+        auto idx = number / WORD_BITS;
+        return idx < words.size() && (words[idx] & (WordType(1) << (number % WORD_BITS))) != 0;
+    }
+    return std::ranges::find(numbers, number) != numbers.end();
+}
+
+LiveSet &LiveSet::Union(const LiveSet &other) {
+    if (!other.dense) {
+        for (auto number : other.numbers) {
+            Add(number);
+        }
+        return *this;
+    }
+    if (!dense) {
+        makeDense();
+    }
+    if (words.size() < other.words.size()) {
+        words.resize(other.words.size(), 0);
+    }
+    auto *dst = words.data();
+    const auto *src = other.words.data();
+    for (size_t i = 0, end = other.words.size(); i < end; ++i) {
+        dst[i] |= src[i];
+    }
+    return *this;
+}
+
+LiveSet &LiveSet::Difference(const LiveSet &other) {
+    if (!dense) {
+        std::erase_if(numbers, [&other](size_t number) { return other.Contains(number); });
+        return *this;
+    }
+    if (!other.dense) {
+        for (auto number : other.numbers) {
+            Remove(number);
+        }
+        return *this;
+    }
+    auto *dst = words.data();
+    const auto *src = other.words.data();
+    for (size_t i = 0, end = std::min(words.size(), other.words.size()); i < end; ++i) {
+        dst[i] &= ~src[i];
+    }
+    return *this;
+}
+
+size_t LiveSet::Size() const {
+    if (!dense) {
+        return numbers.size();
+    }
+    size_t count = 0;
+    for (auto word : words) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+void LiveSet::makeDense() {
+    ASSERT(!dense);
+    dense = true;
+    for (auto number : numbers) {
+        Add(number);
+    }
+    numbers.clear();
+}
 }   // namespace ir
@@ -2,9 +2,12 @@
 #define JIT_AOT_COMPILERS_COURSE_LIVE_ANALYSIS_STRUCTS_H_
 
 #include <algorithm>
+#include <bit>
+#include "Concepts.h"
+#include <cstdint>
 #include "instructions/InstructionBase.h"
 #include <limits>
-#include <unordered_set>
+#include <ranges>
 #include "ValueLocation.h"
 
 
@@ -71,36 +74,49 @@ inline std::ostream &operator<<(std::ostream &os, const LiveRange &rng) {
     return os;
 }
 
+// Position, at which the value is used, with a hint whether the user
+// requires the value in a register.
+struct UsePosition {
+    LiveRange::RangeType position;
+    bool requiresRegister;
+
+    bool operator==(const UsePosition &other) const = default;
+};
+
 class LiveInterval {
 public:
     using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
-    explicit LiveInterval(const allocator_type &a) : ranges(a), liveNumber(0), instr(nullptr) {}
+    explicit LiveInterval(const allocator_type &a) : ranges(a), uses(a), liveNumber(0), instr(nullptr) {}
     LiveInterval(LiveRange::RangeType liveNum, InstructionBase *in, std::pmr::memory_resource *memResource)
-        : ranges(memResource), liveNumber(liveNum), instr(in) {}
+        : ranges(memResource), uses(memResource), liveNumber(liveNum), instr(in) {}
     LiveInterval(LiveRange::RangeType liveNum, InstructionBase *in, const allocator_type &a)
-        : ranges(a), liveNumber(liveNum), instr(in) {}
+        : ranges(a), uses(a), liveNumber(liveNum), instr(in) {}
 
     LiveInterval(std::initializer_list<LiveRange> init, InstructionBase *in);
     LiveInterval(std::initializer_list<LiveRange> init, InstructionBase *in, const allocator_type &a)
-        : ranges(init, a), liveNumber(init.begin()->GetBegin()), instr(in) {}
+        : ranges(init, a), uses(a), liveNumber(init.begin()->GetBegin()), instr(in) {}
     LiveInterval() = delete;
 
     NO_COPY_SEMANTIC(LiveInterval);
     LiveInterval(const LiveInterval &other, const allocator_type &a)
         : ranges(other.ranges, a),
+          uses(other.uses, a),
           liveNumber(other.liveNumber),
-          instr(other.instr)
+          instr(other.instr),
+          loc(other.loc)
     {}
 
     NO_MOVE_SEMANTIC(LiveInterval);
     LiveInterval(LiveInterval &&other, const allocator_type &a)
         : ranges(std::move(other.ranges), a),
+          uses(std::move(other.uses), a),
           liveNumber(other.liveNumber),
-          instr(other.instr)
+          instr(other.instr),
+          loc(other.loc)
     {}
 
-    virtual DEFAULT_DTOR(LiveInterval);
+    DEFAULT_DTOR(LiveInterval);
 
     LiveRange::RangeType GetLiveNumber() const {
         return liveNumber;
@@ -132,17 +148,12 @@ public:
     LiveRange::RangeType GetEnd() const {
         return GetUpperRange().GetEnd();
     }
+    size_t GetRangesCount() const {
+        return ranges.size();
+    }
 
     bool operator==(const LiveInterval &other) const {
-        if (ranges.size() != other.ranges.size()) {
-            return false;
-        }
-        for (size_t i = 0, end = ranges.size(); i < end; ++i) {
-            if (ranges[i] != other.ranges[i]) {
-                return false;
-            }
-        }
-        return true;
+        return ranges == other.ranges;
     }
 
     void SetBegin(LiveRange::RangeType begin);
@@ -150,9 +161,27 @@ public:
     void AddRange(LiveRange::RangeType begin, LiveRange::RangeType end) {
         AddRange({begin, end});
     }
-
     void AddRange(const LiveRange &rng);
 
+    // Queries below take O(log(number of ranges)) time.
+    bool Covers(LiveRange::RangeType position) const;
+    // Returns the first position not less than `from` covered by both intervals
+    // or INVALID_RANGE if there is no such position.
+    LiveRange::RangeType NextIntersection(const LiveInterval &other, LiveRange::RangeType from = 0) const;
+    bool Intersects(const LiveInterval &other) const {
+        return NextIntersection(other) != LiveRange::INVALID_RANGE;
+    }
+
+    // Use positions are expected to be added in descending order, as ranges are.
+    void AddUsePosition(LiveRange::RangeType position, bool requiresRegister);
+    // Returns uses in ascending order of positions.
+    auto GetUsePositions() const {
+        return std::ranges::subrange(uses.rbegin(), uses.rend());
+    }
+    // Both return the first suitable use at or after the position or INVALID_RANGE.
+    LiveRange::RangeType NextUsePosition(LiveRange::RangeType from) const;
+    LiveRange::RangeType NextRegisterUsePosition(LiveRange::RangeType from) const;
+
     auto begin() {
         return ranges.rbegin();
     }
@@ -170,21 +199,39 @@ public:
     static constexpr size_t LIVE_RANGE_STEP = 2;
 
 private:
-    // live ranges sorted in descending order
+    // first range ending after the position, in ascending order
+    auto findRange(LiveRange::RangeType position) const {
+        return std::ranges::partition_point(begin(), end(), [position](const LiveRange &rng) {
+            return rng.GetEnd() <= position;
+        });
+    }
+    auto findUse(LiveRange::RangeType from) const {
+        return std::ranges::partition_point(uses.rbegin(), uses.rend(), [from](const UsePosition &use) {
+            return use.position < from;
+        });
+    }
+
+private:
+    // disjoint live ranges sorted in descending order, as they are built backwards
     std::pmr::vector<LiveRange> ranges;
+    // sorted in descending order, as ranges
+    std::pmr::vector<UsePosition> uses;
     LiveRange::RangeType liveNumber;
     InstructionBase *instr;
     codegen::ValueLocation loc;
 };
 
+// Live intervals of the graph's instructions indexed by their linear numbers.
+// Intervals are placed into pooled chunks instead of being allocated one by one,
+// and the chunks are reused after the intervals are cleared.
 class LiveIntervals {
 public:
-    LiveIntervals(std::pmr::memory_resource *memResource) : liveIntervals(memResource) {}
+    LiveIntervals(std::pmr::memory_resource *memResource) : liveIntervals(memResource), chunks(memResource) {}
 
     LiveIntervals() = delete;
     NO_COPY_SEMANTIC(LiveIntervals);
     NO_MOVE_SEMANTIC(LiveIntervals);
-    virtual DEFAULT_DTOR(LiveIntervals);
+    virtual ~LiveIntervals() noexcept;
 
     LiveInterval *AddLiveInterval(LiveRange::RangeType liveNum, InstructionBase *instr);
 
@@ -205,15 +252,13 @@ public:
         return liveIntervals.size();
     }
 
-    void Clear() {
-        liveIntervals.clear();
-    }
+    void Clear();
 
 public:
-    LiveInterval *operator[](int idx) {
+    LiveInterval *operator[](size_t idx) {
         return liveIntervals[idx];
     }
-    const LiveInterval *operator[](int idx) const {
+    const LiveInterval *operator[](size_t idx) const {
         return liveIntervals[idx];
     }
 
@@ -230,8 +275,13 @@ public:
         return liveIntervals.rend();
     }
 
+public:
+    static constexpr size_t CHUNK_SIZE = 64;
+
 private:
     std::pmr::vector<LiveInterval *> liveIntervals;
+    // storage for CHUNK_SIZE intervals each
+    std::pmr::vector<LiveInterval *> chunks;
 };
 
 inline std::ostream &operator<<(std::ostream &os, const LiveInterval &intervals) {
@@ -243,58 +293,99 @@ inline std::ostream &operator<<(std::ostream &os, const LiveInterval &intervals)
     return os;
 }
 
+// Set of live values identified by linear numbers of their instructions.
+// Small sets are kept as arrays of numbers and are converted into bit-vectors
+// when they grow, so that unions and differences of big sets are computed
+// word by word, which compilers vectorize.
 class LiveSet {
 public:
     using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    using WordType = uint64_t;
 
-    explicit LiveSet(const allocator_type &a) : instructions(a) {}
-    explicit LiveSet(std::pmr::memory_resource *memResource) : instructions(memResource) {}
+    explicit LiveSet(const allocator_type &a) : words(a), numbers(a) {}
+    explicit LiveSet(std::pmr::memory_resource *memResource) : words(memResource), numbers(memResource) {}
 
     NO_COPY_SEMANTIC(LiveSet);
-    LiveSet(const LiveSet &other, const allocator_type &a) : instructions(other.instructions, a) {}
+    LiveSet(const LiveSet &other, const allocator_type &a)
+        : dense(other.dense),
+          words(other.words, a),
+          numbers(other.numbers, a)
+    {}
 
     NO_MOVE_SEMANTIC(LiveSet);
-    LiveSet(LiveSet &&other, const allocator_type &a) : instructions(std::move(other.instructions), a) {}
+    LiveSet(LiveSet &&other, const allocator_type &a)
+        : dense(other.dense),
+          words(std::move(other.words), a),
+          numbers(std::move(other.numbers), a)
+    {}
 
     virtual DEFAULT_DTOR(LiveSet);
 
-    void Add(InstructionBase *instr) {
+    void Add(const InstructionBase *instr) {
         ASSERT(instr);
-        instructions.emplace(instr);
+        Add(instr->GetLinearNumber());
     }
-    bool Remove(InstructionBase *instr) {
+    void Add(size_t number);
+    bool Remove(const InstructionBase *instr) {
         ASSERT(instr);
-        return instructions.erase(instr);
+        return Remove(instr->GetLinearNumber());
     }
+    // Returns true if the number was in the set.
+    bool Remove(size_t number);
+    bool Contains(size_t number) const;
 
-    LiveSet &Union(LiveSet &&other) {
-        instructions.merge(std::move(other.instructions));
-        return *this;
-    }
-    LiveSet &Union(const LiveSet &other) {
-        instructions.insert(other.instructions.begin(), other.instructions.end());
-        return *this;
-    }
+    LiveSet &Union(const LiveSet &other);
+    // Removes all numbers contained in the other set.
+    LiveSet &Difference(const LiveSet &other);
 
-    auto begin() {
-        return instructions.begin();
-    }
-    auto end() {
-        return instructions.end();
+    // O(size of the universe) complexity for dense sets.
+    size_t Size() const;
+    bool IsEmpty() const {
+        return Size() == 0;
     }
-    auto begin() const {
-        return instructions.begin();
+    bool IsDense() const {
+        return dense;
     }
-    auto end() const {
-        return instructions.end();
+
+    // Applies the function to each number in the set, in unspecified order.
+    template <typename FunctionType>
+    requires UnaryFunctionType<FunctionType, size_t, void>
+    void ForEach(FunctionType function) const {
+        if (!dense) {
+            std::ranges::for_each(numbers, function);
+            return;
+        }
+        for (size_t i = 0, end = words.size(); i < end; ++i) {
+            for (auto word = words[i]; word != 0; word &= word - 1) {
+                function(i * WORD_BITS + std::countr_zero(word));
+            }
+        }
     }
 
     allocator_type get_allocator() const noexcept {
-        return instructions.get_allocator();
+        return words.get_allocator();
+    }
+
+public:
+    // sets with more numbers are kept as bit-vectors
+    static constexpr size_t SPARSE_LIMIT = 16;
+
+private:
+    static constexpr size_t WORD_BITS = std::numeric_limits<WordType>::digits;
+
+    void makeDense();
+    void reserveWords(size_t number) {
+        if (number / WORD_BITS >= words.size()) {
+            words.resize(number / WORD_BITS + 1, 0);
+        }
     }
 
 private:
-    std::pmr::unordered_set<InstructionBase *> instructions;
+    bool dense = false;
+    // bit-vector of dense sets
+    std::pmr::vector<WordType> words;
+    // unique numbers of sparse sets
+    std::pmr::vector<size_t> numbers;
 };
 
 class BlockInfo {
@@ -7,6 +7,35 @@
 
 
 namespace ir {
+// Integer value changing by a constant step on each iteration of a loop.
+// A basic variable is a PHI in the loop's header, while a derived one is computed
+// in the loop's blocks as `scale * basic + offset` with constant scale and offset.
+struct InductionVariable {
+    InstructionBase *value;
+    PhiInstruction *basic;
+    int64_t scale;
+    int64_t offset;
+    // value of the basic variable on the first iteration and its increment per iteration
+    InstructionBase *init;
+    int64_t step;
+
+    bool IsBasic() const {
+        return value == basic;
+    }
+    // Increment of the variable itself per iteration.
+    int64_t GetIncrement() const {
+        return scale * step;
+    }
+};
+
+// Comparison of an induction variable against a loop invariant, which controls
+// the only exit of the loop: the loop continues while `var ccode bound` holds.
+struct LoopExitTest {
+    InstructionBase *var;
+    InstructionBase *bound;
+    CondCode ccode;
+};
+
 class Loop final {
 public:
     Loop(size_t id,
@@ -20,6 +49,9 @@ public:
           basicBlocks(memResource),
           outerLoop(nullptr),
           innerLoops(memResource),
+          exitingBlocks(memResource),
+          exitBlocks(memResource),
+          inductionVariables(memResource),
           isIrreducible(isIrreducible),
           isRoot(isRoot)
     {
@@ -50,6 +82,26 @@ public:
     size_t GetBackEdgesCount() const {
         return backEdges.size();
     }
+    // Returns the only source of back edges or nullptr if there are several ones.
+    BasicBlock *GetLatch() {
+        return backEdges.size() == 1 ? backEdges[0] : nullptr;
+    }
+    const BasicBlock *GetLatch() const {
+        return backEdges.size() == 1 ? backEdges[0] : nullptr;
+    }
+
+    // Returns the only predecessor of the header outside the loop if it has
+    // no other successors, nullptr otherwise.
+    BasicBlock *GetPreHeader() {
+        return preHeader;
+    }
+    const BasicBlock *GetPreHeader() const {
+        return preHeader;
+    }
+    void SetPreHeader(BasicBlock *bblock) {
+        ASSERT(!isRoot);
+        preHeader = bblock;
+    }
 
     std::pmr::vector<BasicBlock *> GetBasicBlocks() {
         return basicBlocks;
@@ -82,6 +134,65 @@ public:
         innerLoops.push_back(loop);
     }
 
+    // Blocks of the loop and of its inner loops, which have successors outside the loop.
+    const std::pmr::vector<BasicBlock *> &GetExitingBlocks() const {
+        return exitingBlocks;
+    }
+    // Blocks outside the loop, which are successors of the exiting ones.
+    const std::pmr::vector<BasicBlock *> &GetExitBlocks() const {
+        return exitBlocks;
+    }
+    void AddExit(BasicBlock *exiting, BasicBlock *exit) {
+        ASSERT((exiting) && (exit) && !isRoot);
+        // edges from the same block are added consecutively
+        if (exitingBlocks.empty() || exitingBlocks.back() != exiting) {
+            exitingBlocks.push_back(exiting);
+        }
+        if (std::find(exitBlocks.begin(), exitBlocks.end(), exit) == exitBlocks.end()) {
+            exitBlocks.push_back(exit);
+        }
+    }
+
+    // Induction variables and the trip count are valid after InductionVariablesAnalysis.
+    const std::pmr::vector<InductionVariable> &GetInductionVariables() const {
+        return inductionVariables;
+    }
+    const InductionVariable *FindInductionVariable(const InstructionBase *instr) const {
+        auto it = std::find_if(inductionVariables.begin(), inductionVariables.end(),
+                               [instr](const InductionVariable &var) { return var.value == instr; });
+        return it == inductionVariables.end() ? nullptr : &(*it);
+    }
+    void AddInductionVariable(const InductionVariable &var) {
+        ASSERT((var.value) && FindInductionVariable(var.value) == nullptr);
+        inductionVariables.push_back(var);
+    }
+    const LoopExitTest *GetExitTest() const {
+        return exitTest.var ? &exitTest : nullptr;
+    }
+    void SetExitTest(const LoopExitTest &test) {
+        exitTest = test;
+    }
+    // Number of executions of the header per entry into the loop, zero if unknown.
+    uint64_t GetTripCount() const {
+        return tripCount;
+    }
+    void SetTripCount(uint64_t count) {
+        tripCount = count;
+    }
+    void ClearInductionVariables() {
+        inductionVariables.clear();
+        exitTest = {nullptr, nullptr, CondCode::NUM_CODES};
+        tripCount = 0;
+    }
+
+    // Number of loops the loop is nested in, the root loop has zero depth.
+    size_t GetDepth() const {
+        return depth;
+    }
+    void SetDepth(size_t newDepth) {
+        depth = newDepth;
+    }
+
     void SetIrreducibility(bool isIrr) {
         isIrreducible = isIrr;
     }
@@ -118,6 +229,16 @@ private:
     Loop *outerLoop;
     std::pmr::vector<Loop *> innerLoops;
 
+    BasicBlock *preHeader = nullptr;
+    std::pmr::vector<BasicBlock *> exitingBlocks;
+    std::pmr::vector<BasicBlock *> exitBlocks;
+
+    size_t depth = 0;
+
+    std::pmr::vector<InductionVariable> inductionVariables;
+    LoopExitTest exitTest{nullptr, nullptr, CondCode::NUM_CODES};
+    uint64_t tripCount = 0;
+
     bool isIrreducible;
 
     // TODO: can replace with `outerLoop == nullptr`
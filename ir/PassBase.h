@@ -1,6 +1,7 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_PASS_BASE_H_
 #define JIT_AOT_COMPILERS_COURSE_PASS_BASE_H_
 
+#include "Arena.h"
 #include "Graph.h"
 #include <log4cpp/Category.hh>
 
@@ -24,17 +25,30 @@ public:
             if (graph->IsAnalysisValid(PassT::SET_FLAG)) {
                 return true;
             }
-            auto res = PassT(graph, args...).Run();
+            auto res = runPass<PassT>(graph, args...);
             graph->SetAnalysisValid<PassT::SET_FLAG>(true);
             return res;
         }
-        return PassT(graph, args...).Run();
+        return runPass<PassT>(graph, args...);
     }
 
     template <AnalysisFlag... Flags>
     static void SetInvalid(Graph *graph) {
         utils::expand_t{(graph->SetAnalysisValid<Flags>(false), void(), 0)...};
     }
+
+private:
+    template <typename PassT, typename... ArgsT>
+    static bool runPass(Graph *graph, ArgsT... args) {
+        auto *tracker = graph->GetMemoryTracker();
+        auto checkpoint = tracker->StartMeasurement();
+        PassT pass(graph, args...);
+        auto res = pass.Run();
+        auto stats = tracker->FinishMeasurement(checkpoint);
+        stats.scratchBytes = pass.GetScratchResource()->GetAllocatedBytes();
+        graph->AddPassMemoryStats(typeid(PassT), stats);
+        return res;
+    }
 };
 
 class PassBase {
@@ -48,8 +62,17 @@ public:
 
     virtual bool Run() = 0;
 
+    // Memory for the pass's temporary data, which is released when the pass finishes.
+    // Results, which outlive the pass, must be allocated in the graph's memory.
+    utils::Arena *GetScratchResource() const {
+        return scratch.GetArena();
+    }
+
 protected:
     Graph *graph;
+
+private:
+    utils::ScratchScope scratch;
 };
 }   // namespace ir
 
@@ -1,16 +1,35 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_INPUT_H_
 #define JIT_AOT_COMPILERS_COURSE_INPUT_H_
 
+#include "macros.h"
+
+
 namespace ir {
 class InstructionBase;
+class Users;
 
+// Use of an instruction's value.
+// Inputs owned by instructions are attached to them: such inputs are nodes of
+// the intrusive users list of their definition, and assigning to them moves
+// the use from the old definition to the new one in O(1).
+// Copies of inputs are always detached, i.e. plain values.
 class Input final {
 public:
-    Input() : instr(nullptr) {}
+    Input() = default;
     Input(InstructionBase *instr) : instr(instr) {}
-    DEFAULT_COPY_SEMANTIC(Input);
-    DEFAULT_MOVE_SEMANTIC(Input);
-    DEFAULT_DTOR(Input);
+    Input(const Input &other) : instr(other.instr) {}
+    Input(Input &&other) noexcept : instr(other.instr) {}
+    Input &operator=(const Input &other) {
+        SetInstruction(other.instr);
+        return *this;
+    }
+    Input &operator=(Input &&other) noexcept {
+        SetInstruction(other.instr);
+        return *this;
+    }
+    ~Input() noexcept {
+        unlink();
+    }
 
     InstructionBase *GetInstruction() {
         return instr;
@@ -18,9 +37,39 @@ public:
     const InstructionBase *GetInstruction() const {
         return instr;
     }
+    // Returns the instruction owning this input, nullptr for detached inputs.
+    InstructionBase *GetUser() const {
+        return user;
+    }
+    bool IsAttached() const {
+        return user != nullptr;
+    }
+    // Returns the next use of the same definition.
+    Input *GetNextUse() {
+        return nextUse;
+    }
+    const Input *GetNextUse() const {
+        return nextUse;
+    }
 
     void SetInstruction(InstructionBase *newInstr) {
+        if (newInstr == instr) {
+            return;
+        }
+        unlink();
         instr = newInstr;
+        link();
+    }
+    void Attach(InstructionBase *owner) {
+        ASSERT((owner) && (user == nullptr || user == owner));
+        if (user == nullptr) {
+            user = owner;
+            link();
+        }
+    }
+    void Detach() {
+        unlink();
+        user = nullptr;
     }
 
     InstructionBase *operator->() {
@@ -31,7 +80,19 @@ public:
     }
 
 private:
-    InstructionBase *instr;
+    // defined in InstructionBase.h
+    inline void link();
+    inline void unlink();
+
+private:
+    InstructionBase *instr = nullptr;
+    InstructionBase *user = nullptr;
+
+    // the first use in a list points to the last one
+    Input *prevUse = nullptr;
+    Input *nextUse = nullptr;
+
+    friend class Users;
 };
 
 inline bool operator ==(const Input& lhs, const Input &rhs) {
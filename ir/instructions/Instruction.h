@@ -1,9 +1,11 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_INSTRUCTION_H_
 #define JIT_AOT_COMPILERS_COURSE_INSTRUCTION_H_
 
+#include <algorithm>
 #include "AllocatorUtils.h"
 #include <array>
 #include "CompilerBase.h"
+#include <concepts>
 #include "Concepts.h"
 #include <cstdint>
 #include <functional>
@@ -41,6 +43,32 @@ constexpr inline CondCode inverseCondCode(CondCode cc) {
     return inversedCodes[static_cast<size_t>(cc)];
 }
 
+// Returns the condition code, which holds if and only if the given one does not.
+constexpr inline CondCode negateCondCode(CondCode cc) {
+    std::array<CondCode, static_cast<size_t>(CondCode::NUM_CODES)> negatedCodes{
+        CondCode::NE,
+        CondCode::EQ,
+        CondCode::GE,
+        CondCode::GT,
+        CondCode::LT,
+        CondCode::LE
+    };
+    return negatedCodes[static_cast<size_t>(cc)];
+}
+
+// Returns the condition code of the same comparison with swapped operands.
+constexpr inline CondCode mirrorCondCode(CondCode cc) {
+    std::array<CondCode, static_cast<size_t>(CondCode::NUM_CODES)> mirroredCodes{
+        CondCode::EQ,
+        CondCode::NE,
+        CondCode::GT,
+        CondCode::GE,
+        CondCode::LE,
+        CondCode::LT
+    };
+    return mirroredCodes[static_cast<size_t>(cc)];
+}
+
 constexpr inline const char *getCondCodeName(CondCode cc) {
     std::array<const char *, static_cast<size_t>(CondCode::NUM_CODES)> names{
         "EQ",
@@ -62,102 +90,115 @@ constexpr inline bool compare(CondCode cc, T &&lhs, V &&rhs) {
         return lhs != rhs;
     case CondCode::LT:
         return lhs < rhs;
+    case CondCode::LE:
+        return lhs <= rhs;
     case CondCode::GE:
         return lhs >= rhs;
+    case CondCode::GT:
+        return lhs > rhs;
     default:
         UNREACHABLE("");
         return false;
     }
 }
 
+// Inputs of every instruction are stored contiguously, so that they are
+// accessed without dispatching on the instruction's class.
 class InputsInstruction: public InstructionBase {
 public:
     InputsInstruction(Opcode opcode, OperandType type, std::pmr::memory_resource *memResource)
         : InstructionBase(opcode, type, memResource) {}
-    virtual DEFAULT_DTOR(InputsInstruction);
-
-    virtual size_t GetInputsCount() const = 0;
-    virtual Input &GetInput(size_t idx) = 0;
-    virtual const Input &GetInput(size_t idx) const = 0;
-    virtual void SetInput(Input newInput, size_t idx) = 0;
-    virtual void ReplaceInput(const Input &oldInput, Input newInput) = 0;
-    virtual void RemoveUserFromInputs() {
-        for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
-            GetInput(i)->RemoveUser(this);
+    DEFAULT_DTOR(InputsInstruction);
+
+    size_t GetInputsCount() const {
+        return inputsCount;
+    }
+    Input &GetInput(size_t idx) {
+        ASSERT(idx < inputsCount);
+        return inputsData[idx];
+    }
+    const Input &GetInput(size_t idx) const {
+        ASSERT(idx < inputsCount);
+        return inputsData[idx];
+    }
+    std::span<Input> GetInputs() {
+        return {inputsData, inputsCount};
+    }
+    std::span<const Input> GetInputs() const {
+        return {inputsData, inputsCount};
+    }
+    void SetInput(Input newInput, size_t idx) {
+        auto &input = GetInput(idx);
+        input.Attach(this);
+        input = newInput;
+    }
+    void ReplaceInput(const Input &oldInput, Input newInput) {
+        auto inputs = GetInputs();
+        auto iter = std::ranges::find(inputs, oldInput);
+        ASSERT(iter != inputs.end());
+        *iter = newInput;
+    }
+    // Removes the instruction from its inputs' users, must be called before
+    // the instruction is thrown away. Values of inputs are kept.
+    void RemoveUserFromInputs() {
+        for (auto &input : GetInputs()) {
+            input.Detach();
         }
     }
-    virtual void ForEachInput(std::function<void(Input&)> function) {
-        for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
-            std::invoke(function, GetInput(i));
+    template <std::invocable<Input &> FunctionT>
+    void ForEachInput(FunctionT &&function) {
+        for (auto &input : GetInputs()) {
+            std::invoke(function, input);
         }
     }
-    virtual void ForEachInput(std::function<void(const Input&)> function) const {
-        for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
-            std::invoke(function, GetInput(i));
+    template <std::invocable<const Input &> FunctionT>
+    void ForEachInput(FunctionT &&function) const {
+        for (const auto &input : GetInputs()) {
+            std::invoke(function, input);
         }
     }
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InstructionBase::dumpImpl(stream);
-        for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
-            ASSERT(GetInput(i).GetInstruction());
-            stream << " #" << GetInput(i)->GetId();
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InstructionBase::DumpImpl(stream);
+        for (const auto &input : GetInputs()) {
+            ASSERT(input.GetInstruction());
+            stream << " #" << input->GetId();
         }
     }
+
+protected:
+    // Must be called by derived classes whenever their inputs' storage changes.
+    void setInputsStorage(Input *data, size_t count) {
+        ASSERT(GetTraits().HasVariableInputs() || GetTraits().inputsCount == count);
+        inputsData = data;
+        inputsCount = count;
+    }
+
+private:
+    Input *inputsData = nullptr;
+    size_t inputsCount = 0;
 };
 
 template <int InputsNum>
 class FixedInputsInstruction: public InputsInstruction {
 public:
     FixedInputsInstruction(Opcode opcode, OperandType type, std::pmr::memory_resource *memResource)
-        : InputsInstruction(opcode, type, memResource) {}
+        : InputsInstruction(opcode, type, memResource)
+    {
+        setInputsStorage(inputs.data(), InputsNum);
+    }
 
     template <IsSameType<Input>... T>
     FixedInputsInstruction(Opcode opcode, OperandType type, std::pmr::memory_resource *memResource,
                            T... ins)
         : InputsInstruction(opcode, type, memResource), inputs{ins...}
     {
+        setInputsStorage(inputs.data(), InputsNum);
         for (auto &it : inputs) {
-            if (it.GetInstruction()) {
-                it->AddUser(this);
-            }
+            it.Attach(this);
         }
     }
 
-    size_t GetInputsCount() const override {
-        return InputsNum;
-    }
-    Input &GetInput(size_t idx) override {
-        ASSERT(idx < inputs.size());
-        return inputs[idx];
-    }
-    const Input &GetInput(size_t idx) const override {
-        ASSERT(idx < inputs.size());
-        return inputs[idx];
-    }
-    void SetInput(Input newInput, size_t idx) override {
-        ASSERT(idx < inputs.size());
-        inputs[idx] = newInput;
-        if (newInput.GetInstruction()) {
-            newInput->AddUser(this);
-        }
-    }
-    void ReplaceInput(const Input &oldInput, Input newInput) override {
-        auto iter = std::find(inputs.begin(), inputs.end(), oldInput);
-        ASSERT(iter != inputs.end());
-        *iter = newInput;
-    }
-
-    std::array<Input, InputsNum> &GetInputs() {
-        // TODO: return span?
-        return inputs;
-    }
-    auto GetInputs() const {
-        // TODO: return array?
-        return std::span{inputs};
-    }
-
 private:
     std::array<Input, InputsNum> inputs;
 };
@@ -166,49 +207,24 @@ template <>
 class FixedInputsInstruction<1>: public InputsInstruction {
 public:
     FixedInputsInstruction(Opcode opcode, OperandType type, std::pmr::memory_resource *memResource)
-        : InputsInstruction(opcode, type, memResource) {}
+        : InputsInstruction(opcode, type, memResource)
+    {
+        setInputsStorage(&input, 1);
+    }
     FixedInputsInstruction(Opcode opcode, OperandType type, Input input, std::pmr::memory_resource *memResource)
         : InputsInstruction(opcode, type, memResource), input(input)
     {
-        if (input.GetInstruction()) {
-            input->AddUser(this);
-        }
+        setInputsStorage(&this->input, 1);
+        this->input.Attach(this);
     }
 
-    size_t GetInputsCount() const override {
-        return 1;
-    }
+    using InputsInstruction::GetInput;
     Input &GetInput() {
         return input;
     }
     const Input &GetInput() const {
         return input;
     }
-    Input &GetInput(size_t idx) override {
-        ASSERT(idx == 0);
-        return input;
-    }
-    const Input &GetInput(size_t idx) const override {
-        ASSERT(idx == 0);
-        return input;
-    }
-    void SetInput(Input newInput, size_t idx) override {
-        ASSERT(idx == 0);
-        input = newInput;
-        if (input.GetInstruction()) {
-            input->AddUser(this);
-        }
-    }
-    void ReplaceInput(const Input &oldInput, Input newInput) override {
-        ASSERT(input == oldInput);
-        input = newInput;
-    }
-    void ForEachInput(std::function<void(Input&)> function) override {
-        std::invoke(function, input);
-    }
-    void ForEachInput(std::function<void(const Input&)> function) const override {
-        std::invoke(function, input);
-    }
 
 private:
     Input input;
@@ -234,11 +250,7 @@ public:
         : InputsInstruction(opcode, type, memResource),
           inputs(ins.begin(), ins.end(), memResource)
     {
-        for (auto &it : inputs) {
-            if (it.GetInstruction()) {
-                it->AddUser(this);
-            }
-        }
+        attachInputs();
     }
 
     // TODO: try generalizing constructor in respect to `ins` argument (with type-hints)
@@ -249,11 +261,7 @@ public:
         : InputsInstruction(opcode, type, memResource),
           inputs(ins.begin(), ins.end(), memResource)
     {
-        for (auto &it : inputs) {
-            if (it.GetInstruction()) {
-                it->AddUser(this);
-            }
-        }
+        attachInputs();
     }
 
     template <typename Ins, typename AllocatorT>
@@ -263,51 +271,34 @@ public:
         : InputsInstruction(opcode, type, memResource),
           inputs(ins.begin(), ins.end(), memResource)
     {
-        for (auto &it : inputs) {
-            if (it.GetInstruction()) {
-                it->AddUser(this);
-            }
-        }
+        attachInputs();
     }
 
     DEFAULT_DTOR(VariableInputsInstruction);
 
-    size_t GetInputsCount() const override {
-        return inputs.size();
-    }
-    Input &GetInput(size_t idx) override {
-        ASSERT(idx < inputs.size());
-        return inputs[idx];
-    }
-    const Input &GetInput(size_t idx) const override {
-        ASSERT(idx < inputs.size());
-        return inputs[idx];
-    }
-    void SetInput(Input newInput, size_t idx) override {
-        ASSERT(idx < inputs.size());
-        inputs[idx] = newInput;
-        if (newInput.GetInstruction()) {
-            newInput->AddUser(this);
+    void AddInput(Input newInput) {
+        const auto *oldData = inputs.data();
+        inputs.push_back(newInput);
+        setInputsStorage(inputs.data(), inputs.size());
+        if (inputs.data() != oldData) {
+            // reallocated inputs are detached copies
+            attachInputs();
+        } else {
+            inputs.back().Attach(this);
         }
     }
-    void ReplaceInput(const Input &oldInput, Input newInput) override {
-        auto iter = std::find(inputs.begin(), inputs.end(), oldInput);
-        ASSERT(iter != inputs.end());
-        *iter = newInput;
-    }
 
-    std::pmr::vector<Input> &GetInputs() {
-        return inputs;
-    }
-    const std::pmr::vector<Input> &GetInputs() const {
-        return inputs;
-    }
-    void AddInput(Input newInput) {
-        inputs.push_back(newInput);
-        if (newInput.GetInstruction()) {
-            newInput->AddUser(this);
+protected:
+    void attachInputs() {
+        setInputsStorage(inputs.data(), inputs.size());
+        for (auto &it : inputs) {
+            it.Attach(this);
         }
     }
+    void popBackInput() {
+        inputs.pop_back();
+        setInputsStorage(inputs.data(), inputs.size());
+    }
 
 protected:
     std::pmr::vector<Input> inputs;
@@ -370,7 +361,7 @@ public:
     UnaryRegInstruction(Opcode opcode, OperandType type, Input input, std::pmr::memory_resource *memResource)
         : FixedInputsInstruction(opcode, type, input, memResource) {}
 
-    UnaryRegInstruction *Copy(BasicBlock *targetBBlock) const override;
+    UnaryRegInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class BinaryRegInstruction : public FixedInputsInstruction<2> {
@@ -379,7 +370,7 @@ public:
                          std::pmr::memory_resource *memResource)
         : FixedInputsInstruction(opcode, type, memResource, in1, in2) {}
 
-    BinaryRegInstruction *Copy(BasicBlock *targetBBlock) const override;
+    BinaryRegInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class ConstantInstruction : public InstructionBase, public ImmediateMixin<uint64_t> {
@@ -389,11 +380,10 @@ public:
     ConstantInstruction(Opcode opcode, OperandType type, uint64_t value, std::pmr::memory_resource *memResource)
         : InstructionBase(opcode, type, memResource), ImmediateMixin<uint64_t>(value) {}
 
-    ConstantInstruction *Copy(BasicBlock *targetBBlock) const override;
+    ConstantInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InstructionBase::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InstructionBase::DumpImpl(stream);
         stream << ' ' << GetValue();
     }
 };
@@ -408,11 +398,10 @@ public:
           ImmediateMixin<Type>(imm)
     {}
 
-    BinaryImmInstruction *Copy(BasicBlock *targetBBlock) const override;
+    BinaryImmInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InputsInstruction::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InputsInstruction::DumpImpl(stream);
         stream << ' ' << GetValue();
     }
 };
@@ -425,15 +414,14 @@ public:
           ConditionMixin(ccode)
     {}
 
-    CompareInstruction *Copy(BasicBlock *targetBBlock) const override;
+    CompareInstruction *Copy(BasicBlock *targetBBlock) const;
     void Inverse();
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
         stream << '#' << GetId() << '.' << getTypeName(GetType()) << "\t\t" << GetOpcodeName() << '.';
         stream << getCondCodeName(GetCondCode()) << '\t';
-        for (size_t i = 0, end = GetInputsCount(); i < end; ++i) {
-            stream << " #" << GetInput(i)->GetId();
+        for (const auto &input : GetInputs()) {
+            stream << " #" << input->GetId();
         }
     }
 };
@@ -453,7 +441,7 @@ public:
         toType = newType;
     }
 
-    CastInstruction *Copy(BasicBlock *targetBBlock) const override;
+    CastInstruction *Copy(BasicBlock *targetBBlock) const;
 
 private:
     OperandType toType;
@@ -462,28 +450,18 @@ private:
 class JumpInstruction : public InstructionBase {
 public:
     JumpInstruction(Opcode opcode, std::pmr::memory_resource *memResource)
-        : InstructionBase(
-            opcode,
-            OperandType::I64,
-            memResource,
-            InstructionBase::INVALID_ID,
-            utils::underlying_logic_or(InstrProp::CF, InstrProp::SIDE_EFFECTS))
+        : InstructionBase(opcode, OperandType::I64, memResource)
     {}
 
     BasicBlock *GetDestination();
 
-    JumpInstruction *Copy(BasicBlock *targetBBlock) const override;
+    JumpInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class CondJumpInstruction : public InstructionBase {
 public:
     CondJumpInstruction(std::pmr::memory_resource *memResource)
-        : InstructionBase(
-            Opcode::JCMP,
-            OperandType::I64,
-            memResource,
-            InstructionBase::INVALID_ID,
-            utils::underlying_logic_or(InstrProp::CF, InstrProp::SIDE_EFFECTS))
+        : InstructionBase(Opcode::JCMP, OperandType::I64, memResource)
     {}
 
     BasicBlock *GetDestination(bool cmpRes) {
@@ -492,7 +470,7 @@ public:
     BasicBlock *GetTrueDestination();
     BasicBlock *GetFalseDestination();
 
-    CondJumpInstruction *Copy(BasicBlock *targetBBlock) const override;
+    CondJumpInstruction *Copy(BasicBlock *targetBBlock) const;
 
 private:
     // true branch must always be the first successor, false branch - the second
@@ -505,21 +483,16 @@ public:
     RetInstruction(OperandType type, Input input, std::pmr::memory_resource *memResource)
         : FixedInputsInstruction<1>(Opcode::RET, type, input, memResource) {}
 
-    RetInstruction *Copy(BasicBlock *targetBBlock) const override;
+    RetInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class RetVoidInstruction : public InstructionBase {
 public:
     RetVoidInstruction(std::pmr::memory_resource *memResource)
-        : InstructionBase(
-            Opcode::RETVOID,
-            OperandType::VOID,
-            memResource,
-            InstructionBase::INVALID_ID,
-            utils::underlying_logic_or(InstrProp::CF, InstrProp::SIDE_EFFECTS))
+        : InstructionBase(Opcode::RETVOID, OperandType::VOID, memResource)
     {}
 
-    RetVoidInstruction *Copy(BasicBlock *targetBBlock) const override;
+    RetVoidInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class PhiInstruction : public VariableInputsInstruction {
@@ -591,13 +564,12 @@ public:
         sourceBBlocks[idx] = sourceBBlocks.back();
         sourceBBlocks.pop_back();
         inputs[idx] = inputs.back();
-        inputs.pop_back();
+        popBackInput();
     }
 
-    PhiInstruction *Copy(BasicBlock *targetBBlock) const override;
+    PhiInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override;
+    void DumpImpl(log4cpp::CategoryStream &stream) const;
 
 private:
     std::pmr::vector<BasicBlock *> sourceBBlocks;
@@ -608,7 +580,7 @@ public:
     InputArgumentInstruction(OperandType type, std::pmr::memory_resource *memResource)
         : InstructionBase(Opcode::ARG, type, memResource) {}
 
-    InputArgumentInstruction *Copy(BasicBlock *targetBBlock) const override;
+    InputArgumentInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class CallInstruction : public VariableInputsInstruction {
@@ -630,11 +602,10 @@ public:
         callTarget = newTarget;
     }
 
-    CallInstruction *Copy(BasicBlock *targetBBlock) const override;
+    CallInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InputsInstruction::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InputsInstruction::DumpImpl(stream);
         stream << " (to " << GetCallTarget() << ')';
     }
 
@@ -651,7 +622,7 @@ public:
         ASSERT(!array.GetInstruction() || array->GetType() == OperandType::REF);
     }
 
-    LengthInstruction *Copy(BasicBlock *targetBBlock) const override;
+    LengthInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class NewArrayInstruction : public FixedInputsInstruction<1>,
@@ -665,11 +636,10 @@ public:
         ASSERT(!length.GetInstruction() || IsIntegerType(length->GetType()));
     }
 
-    NewArrayInstruction *Copy(BasicBlock *targetBBlock) const override;
+    NewArrayInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InstructionBase::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InstructionBase::DumpImpl(stream);
         ASSERT(GetInput(0).GetInstruction());
         stream << ' ' << GetTypeId() << " len(#" << GetInput(0)->GetId() << ')';
     }
@@ -688,11 +658,10 @@ public:
         ASSERT(length > 0);
     }
 
-    NewArrayImmInstruction *Copy(BasicBlock *targetBBlock) const override;
+    NewArrayImmInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InstructionBase::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InstructionBase::DumpImpl(stream);
         stream << ' ' << GetTypeId() << " len(" << GetValue() << ')';
     }
 };
@@ -702,11 +671,10 @@ public:
     NewObjectInstruction(TypeId typeId, std::pmr::memory_resource *memResource)
         : InstructionBase(Opcode::NEW_OBJECT, OperandType::REF, memResource), TypeIdMixin(typeId) {}
 
-    NewObjectInstruction *Copy(BasicBlock *targetBBlock) const override;
+    NewObjectInstruction *Copy(BasicBlock *targetBBlock) const;
 
-protected:
-    void dumpImpl(log4cpp::CategoryStream &stream) const override {
-        InstructionBase::dumpImpl(stream);
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        InstructionBase::DumpImpl(stream);
         stream << ' ' << GetTypeId();
     }
 };
@@ -721,7 +689,7 @@ public:
         ASSERT(!idx.GetInstruction() || IsIntegerType(idx->GetType()));
     }
 
-    LoadArrayInstruction *Copy(BasicBlock *targetBBlock) const override;
+    LoadArrayInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class LoadImmInstruction : public BinaryImmInstruction {
@@ -737,7 +705,7 @@ public:
         ASSERT(!obj.GetInstruction() || obj->GetType() == OperandType::REF);
     }
 
-    LoadImmInstruction *Copy(BasicBlock *targetBBlock) const override;
+    LoadImmInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class StoreArrayInstruction : public FixedInputsInstruction<3> {
@@ -749,7 +717,7 @@ public:
         ASSERT(!idx.GetInstruction() || IsIntegerType(idx->GetType()));
     }
 
-    StoreArrayInstruction *Copy(BasicBlock *targetBBlock) const override;
+    StoreArrayInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class StoreImmInstruction : public FixedInputsInstruction<2>, public ImmediateMixin<uint64_t> {
@@ -766,7 +734,7 @@ public:
         ASSERT(!obj.GetInstruction() || obj->GetType() == OperandType::REF);
     }
 
-    StoreImmInstruction *Copy(BasicBlock *targetBBlock) const override;
+    StoreImmInstruction *Copy(BasicBlock *targetBBlock) const;
 };
 
 class BoundsCheckInstruction : public FixedInputsInstruction<2> {
@@ -783,8 +751,26 @@ public:
         ASSERT(!idx.GetInstruction() || IsIntegerType(idx->GetType()));
     }
 
-    BoundsCheckInstruction *Copy(BasicBlock *targetBBlock) const override;
+    BoundsCheckInstruction *Copy(BasicBlock *targetBBlock) const;
 };
+
+// Calls the visitor with the instruction cast to the class corresponding to its opcode.
+template <typename InstructionT, typename VisitorT>
+requires std::is_same_v<std::remove_const_t<InstructionT>, InstructionBase>
+constexpr decltype(auto) VisitInstruction(InstructionT *instr, VisitorT &&visitor) {
+    ASSERT(instr);
+    switch (instr->GetOpcode()) {
+#define VISIT_OPCODE(name, type, ...)                                                       \
+    case Opcode::name:                                                                      \
+        return std::invoke(std::forward<VisitorT>(visitor),                                 \
+                           static_cast<utils::copy_const_t<InstructionT, type> *>(instr));
+    INSTS_LIST(VISIT_OPCODE)
+#undef VISIT_OPCODE
+    default:
+        UNREACHABLE("unknown opcode");
+        __builtin_unreachable();
+    }
+}
 }   // namespace ir
 
 #endif  // JIT_AOT_COMPILERS_COURSE_INSTRUCTION_H_
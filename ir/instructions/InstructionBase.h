@@ -1,12 +1,15 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_INSTRUCTION_BASE_H_
 #define JIT_AOT_COMPILERS_COURSE_INSTRUCTION_BASE_H_
 
+#include <array>
 #include "Concepts.h"
 #include <cstdint>
 #include "helpers.h"
+#include <initializer_list>
 #include <log4cpp/Category.hh>
 #include "macros.h"
 #include "marker/marker.h"
+#include <memory_resource>
 #include "Types.h"
 #include "Users.h"
 
@@ -14,61 +17,61 @@
 namespace ir {
 class BasicBlock;
 class ConstantInstruction;
-class Input;
 class InputsInstruction;
 class PhiInstruction;
 
 // Opcodes & Conditional Codes
-#define INSTS_LIST(DEF)     \
-    DEF(DIV)                \
-    DEF(DIVI)               \
-    DEF(MOD)                \
-    DEF(MODI)               \
-    DEF(CALL)               \
-    DEF(CMP)                \
-    DEF(JCMP)               \
-    DEF(JMP)                \
-    DEF(RET)                \
-    DEF(RETVOID)            \
-    DEF(CONST)              \
-    DEF(NOT)                \
-    DEF(AND)                \
-    DEF(OR)                 \
-    DEF(XOR)                \
-    DEF(NEG)                \
-    DEF(ADD)                \
-    DEF(SUB)                \
-    DEF(MUL)                \
-    DEF(SRA)                \
-    DEF(SLA)                \
-    DEF(SLL)                \
-    DEF(ANDI)               \
-    DEF(ORI)                \
-    DEF(XORI)               \
-    DEF(ADDI)               \
-    DEF(SUBI)               \
-    DEF(MULI)               \
-    DEF(SRAI)               \
-    DEF(SLAI)               \
-    DEF(SLLI)               \
-    DEF(CAST)               \
-    DEF(PHI)                \
-    DEF(ARG)                \
-    DEF(LEN)                \
-    DEF(NEW_ARRAY)          \
-    DEF(NEW_ARRAY_IMM)      \
-    DEF(NEW_OBJECT)         \
-    DEF(LOAD_ARRAY)         \
-    DEF(LOAD_ARRAY_IMM)     \
-    DEF(LOAD_OBJECT)        \
-    DEF(STORE_ARRAY)        \
-    DEF(STORE_ARRAY_IMM)    \
-    DEF(STORE_OBJECT)       \
-    DEF(NULL_CHECK)         \
-    DEF(ZERO_CHECK)         \
-    DEF(NEGATIVE_CHECK)     \
-    DEF(BOUNDS_CHECK)       \
-    DEF(MOVE)
+// Every instruction is described by its opcode, class, number of inputs and properties.
+#define INSTS_LIST(DEF)                                                                             \
+    DEF(DIV,            BinaryRegInstruction,       2,                  ARITH, INPUT, SIDE_EFFECTS) \
+    DEF(DIVI,           BinaryImmInstruction,       1,                  ARITH, INPUT, SIDE_EFFECTS) \
+    DEF(MOD,            BinaryRegInstruction,       2,                  ARITH, INPUT, SIDE_EFFECTS) \
+    DEF(MODI,           BinaryImmInstruction,       1,                  ARITH, INPUT, SIDE_EFFECTS) \
+    DEF(CALL,           CallInstruction,            VARIABLE_INPUTS,    INPUT, SIDE_EFFECTS)        \
+    DEF(CMP,            CompareInstruction,         2,                  INPUT, SIDE_EFFECTS)        \
+    DEF(JCMP,           CondJumpInstruction,        0,                  CF, SIDE_EFFECTS)           \
+    DEF(JMP,            JumpInstruction,            0,                  CF, SIDE_EFFECTS)           \
+    DEF(RET,            RetInstruction,             1,                  CF, INPUT, SIDE_EFFECTS)    \
+    DEF(RETVOID,        RetVoidInstruction,         0,                  CF, SIDE_EFFECTS)           \
+    DEF(CONST,          ConstantInstruction,        0)                                              \
+    DEF(NOT,            UnaryRegInstruction,        1,                  ARITH, INPUT)               \
+    DEF(AND,            BinaryRegInstruction,       2,                  ARITH, INPUT, COMMUTABLE)   \
+    DEF(OR,             BinaryRegInstruction,       2,                  ARITH, INPUT, COMMUTABLE)   \
+    DEF(XOR,            BinaryRegInstruction,       2,                  ARITH, INPUT, COMMUTABLE)   \
+    DEF(NEG,            UnaryRegInstruction,        1,                  ARITH, INPUT)               \
+    DEF(ADD,            BinaryRegInstruction,       2,                  ARITH, INPUT, COMMUTABLE)   \
+    DEF(SUB,            BinaryRegInstruction,       2,                  ARITH, INPUT)               \
+    DEF(MUL,            BinaryRegInstruction,       2,                  ARITH, INPUT, COMMUTABLE)   \
+    DEF(SRA,            BinaryRegInstruction,       2,                  ARITH, INPUT)               \
+    DEF(SLA,            BinaryRegInstruction,       2,                  ARITH, INPUT)               \
+    DEF(SLL,            BinaryRegInstruction,       2,                  ARITH, INPUT)               \
+    DEF(ANDI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(ORI,            BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(XORI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(ADDI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(SUBI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(MULI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(SRAI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(SLAI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(SLLI,           BinaryImmInstruction,       1,                  ARITH, INPUT)               \
+    DEF(CAST,           CastInstruction,            1,                  INPUT)                      \
+    DEF(PHI,            PhiInstruction,             VARIABLE_INPUTS,    INPUT)                      \
+    DEF(ARG,            InputArgumentInstruction,   0)                                              \
+    DEF(LEN,            LengthInstruction,          1,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(NEW_ARRAY,      NewArrayInstruction,        1,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(NEW_ARRAY_IMM,  NewArrayImmInstruction,     0,                  MEM, SIDE_EFFECTS)          \
+    DEF(NEW_OBJECT,     NewObjectInstruction,       0,                  MEM, SIDE_EFFECTS)          \
+    DEF(LOAD_ARRAY,     LoadArrayInstruction,       2,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(LOAD_ARRAY_IMM, LoadImmInstruction,         1,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(LOAD_OBJECT,    LoadImmInstruction,         1,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(STORE_ARRAY,    StoreArrayInstruction,      3,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(STORE_ARRAY_IMM, StoreImmInstruction,       2,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(STORE_OBJECT,   StoreImmInstruction,        2,                  INPUT, MEM, SIDE_EFFECTS)   \
+    DEF(NULL_CHECK,     UnaryRegInstruction,        1,                  INPUT, SIDE_EFFECTS)        \
+    DEF(ZERO_CHECK,     UnaryRegInstruction,        1,                  INPUT, SIDE_EFFECTS)        \
+    DEF(NEGATIVE_CHECK, UnaryRegInstruction,        1,                  INPUT, SIDE_EFFECTS)        \
+    DEF(BOUNDS_CHECK,   BoundsCheckInstruction,     2,                  INPUT, SIDE_EFFECTS)        \
+    DEF(MOVE,           UnaryRegInstruction,        1,                  INPUT)
 
 enum class Opcode {
 #define OPCODE_DEF(name, ...) name,
@@ -117,6 +120,44 @@ constexpr inline InstructionPropT &operator|=(InstructionPropT &lhs, T rhs) {
     return lhs;
 }
 
+// Static description of instructions with the given opcode.
+struct InstructionTraits {
+    static constexpr size_t VARIABLE_INPUTS = static_cast<size_t>(-1);
+
+    size_t inputsCount;
+    InstructionPropT properties;
+
+    constexpr bool HasVariableInputs() const {
+        return inputsCount == VARIABLE_INPUTS;
+    }
+    constexpr bool SatisfiesProperty(InstrProp prop) const {
+        return properties & utils::to_underlying(prop);
+    }
+};
+
+inline constexpr auto INSTRUCTIONS_TRAITS = []() {
+    using enum InstrProp;
+    constexpr auto VARIABLE_INPUTS = InstructionTraits::VARIABLE_INPUTS;
+    constexpr auto makeProperties = [](std::initializer_list<InstrProp> props) {
+        InstructionPropT result = 0;
+        for (auto prop : props) {
+            result |= prop;
+        }
+        return result;
+    };
+    return std::array<InstructionTraits, static_cast<size_t>(Opcode::NUM_OPCODES)>{
+#define INSTRUCTION_TRAITS(name, type, inputsCount, ...) \
+        InstructionTraits{inputsCount, makeProperties({__VA_ARGS__})},
+        INSTS_LIST(INSTRUCTION_TRAITS)
+#undef INSTRUCTION_TRAITS
+    };
+}();
+
+constexpr inline const InstructionTraits &getInstructionTraits(Opcode opcode) {
+    ASSERT(opcode < Opcode::NUM_OPCODES);
+    return INSTRUCTIONS_TRAITS[static_cast<size_t>(opcode)];
+}
+
 // Instructions
 class InstructionBase : public Markable, public Users {
 public:
@@ -124,18 +165,15 @@ public:
 
     InstructionBase(Opcode opcode,
                     OperandType type,
-                    std::pmr::memory_resource *memResource,
-                    size_t id = INVALID_ID,
-                    InstructionPropT prop = 0)
-        : Users(memResource),
-          id(id),
+                    [[maybe_unused]] std::pmr::memory_resource *memResource,
+                    size_t id = INVALID_ID)
+        : id(id),
           opcode(opcode),
-          type(type),
-          properties(prop)
+          type(type)
     {}
     NO_COPY_SEMANTIC(InstructionBase);
     NO_MOVE_SEMANTIC(InstructionBase);
-    virtual DEFAULT_DTOR(InstructionBase);
+    DEFAULT_DTOR(InstructionBase);
 
     InstructionBase *GetPrevInstruction() {
         return prev;
@@ -164,25 +202,15 @@ public:
     const char *GetOpcodeName() const {
         return getOpcodeName(GetOpcode());
     }
-    log4cpp::CategoryStream Dump(log4cpp::Category &logger) const {
-        auto stream = logger << utils::LogPriority::INFO;
-        dumpImpl(stream);
-        // dump users
-        if (!users.empty()) {
-            stream << "\t(";
-            for (size_t i = 0, end = users.size() - 1; i < end; ++i) {
-                ASSERT(users[i]);
-                stream << users[i]->GetId() << ", ";
-            }
-            stream << users.back()->GetId() << ")";
-        }
-        return stream;
-    }
+    log4cpp::CategoryStream Dump(log4cpp::Category &logger) const;
     size_t GetId() const {
         return id;
     }
+    const InstructionTraits &GetTraits() const {
+        return getInstructionTraits(GetOpcode());
+    }
     InstructionPropT GetProperties() const {
-        return properties;
+        return GetTraits().properties;
     }
     bool SatisfiesProperty(InstrProp prop) const {
         return GetProperties() & utils::to_underlying(prop);
@@ -190,6 +218,10 @@ public:
     size_t GetLinearNumber() const {
         return linearNumber;
     }
+    // Position in the basic block, which is maintained by the block.
+    size_t GetOrderNumber() const {
+        return orderNumber;
+    }
 
     bool IsInputArgument() const {
         return GetOpcode() == Opcode::ARG;
@@ -241,16 +273,23 @@ public:
     void SetLinearNumber(size_t number) {
         linearNumber = number;
     }
-    template <typename T>
-    constexpr inline void SetProperty(T prop) {
-        properties |= prop;
+    void SetOrderNumber(size_t number) {
+        orderNumber = number;
     }
     void UnlinkFromParent();
     void InsertBefore(InstructionBase *before);
     void InsertAfter(InstructionBase *after);
     void ReplaceInputInUsers(InstructionBase *newInput);
 
-    virtual InstructionBase *Copy(BasicBlock *targetBBlock) const = 0;
+    // Creates an instruction of the same class with the same properties but without inputs.
+    InstructionBase *Copy(BasicBlock *targetBBlock) const;
+
+    // Dumps the instruction without its users; classes hide it with their own implementations,
+    // which are selected by the opcode in Dump.
+    void DumpImpl(log4cpp::CategoryStream &stream) const {
+        stream << '#' << GetId() << '.' << getTypeName(GetType())
+               << "\t\t" << GetOpcodeName() << "\t\t";
+    }
 
     NO_NEW_DELETE;
 
@@ -258,11 +297,6 @@ public:
     static constexpr size_t INVALID_ID = static_cast<size_t>(0) - 1;
 
 protected:
-    virtual void dumpImpl(log4cpp::CategoryStream &stream) const {
-        stream << '#' << GetId() << '.' << getTypeName(GetType())
-               << "\t\t" << GetOpcodeName() << "\t\t";
-    }
-
     bool isEarlierInBasicBlock(const InstructionBase *other) const;
 
 private:
@@ -276,11 +310,22 @@ private:
 
     BasicBlock *parent = nullptr;
 
-    InstructionPropT properties = 0;
-
     size_t linearNumber = 0;
+    size_t orderNumber = 0;
 };
 
+inline void Input::link() {
+    if (user != nullptr && instr != nullptr) {
+        static_cast<Users *>(instr)->addUse(this);
+    }
+}
+
+inline void Input::unlink() {
+    if (user != nullptr && instr != nullptr) {
+        static_cast<Users *>(instr)->removeUse(this);
+    }
+}
+
 template <typename T>
 concept InstructionPointerType =
     std::is_base_of_v<InstructionBase, std::remove_pointer_t<std::remove_cv_t<T>>>;
@@ -17,7 +17,7 @@ public:
     TypeId(TypeIdType id) : id(id) {}
     DEFAULT_COPY_SEMANTIC(TypeId);
     DEFAULT_MOVE_CTOR(TypeId);
-    virtual DEFAULT_DTOR(TypeId);
+    DEFAULT_DTOR(TypeId);
 
     operator TypeIdType() const {
         return id;
@@ -110,6 +110,17 @@ constexpr inline int64_t ToSigned(uint64_t value, OperandType type) {
     }
 }
 
+// Sign-extends the value from the type's size regardless of the type's signedness.
+constexpr inline int64_t SignExtend(uint64_t value, OperandType type) {
+    auto shift = 64 - GetTypeBitSize(type);
+    return static_cast<int64_t>(value << shift) >> shift;
+}
+
+constexpr inline bool IsSignedType(OperandType type) {
+    return type == OperandType::I8 || type == OperandType::I16
+        || type == OperandType::I32 || type == OperandType::I64;
+}
+
 constexpr inline uint64_t GetMaxValue(OperandType type) {
     ASSERT(type != OperandType::INVALID);
     return maxValues[static_cast<size_t>(type)];
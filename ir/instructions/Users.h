@@ -1,84 +1,110 @@
 #ifndef JIT_AOT_COMPILERS_COURSE_USERS_H_
 #define JIT_AOT_COMPILERS_COURSE_USERS_H_
 
-#include "AllocatorUtils.h"
+#include <cstddef>
+#include "Input.h"
+#include <iterator>
 #include "logger.h"
-#include <span>
+#include <ranges>
 
 
 namespace ir {
 class InstructionBase;
 
-class Users {
+// Iterates over instructions using a definition, one entry per use.
+class UsersIterator {
 public:
-    explicit Users(std::pmr::memory_resource *memResource)
-        : users(memResource)
-    {
-        ASSERT(memResource);
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = InstructionBase *;
+    using pointer = value_type *;
+    using reference = value_type;
+
+    UsersIterator() = default;
+    explicit UsersIterator(const Input *use) : use(use) {}
+
+    reference operator*() const {
+        ASSERT(use);
+        return use->GetUser();
     }
-    Users(std::span<InstructionBase *> instrs, std::pmr::memory_resource *memResource)
-        : users(instrs.begin(), instrs.end(), memResource)
-    {
-        ASSERT(memResource);
+    UsersIterator &operator++() {
+        ASSERT(use);
+        use = use->GetNextUse();
+        return *this;
     }
-    template <typename AllocatorT>
-    Users(const std::vector<InstructionBase *, AllocatorT> &instrs,
-          std::pmr::memory_resource *memResource)
-        : users(instrs.begin(), instrs.end(), memResource)
-    {
-        ASSERT(memResource);
+    UsersIterator operator++(int) {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
     }
+    bool operator==(const UsersIterator &other) const = default;
+
+private:
+    const Input *use = nullptr;
+};
+
+// Keeps the intrusive list of uses of an instruction, which consists of
+// inputs of other instructions. Inputs add and remove themselves.
+class Users {
+public:
+    Users() = default;
     NO_COPY_SEMANTIC(Users);
     NO_MOVE_SEMANTIC(Users);
-    virtual DEFAULT_DTOR(Users);
+    DEFAULT_DTOR(Users);
 
     size_t UsersCount() const {
-        return users.size();
+        return usersCount;
     }
-
-    const std::pmr::vector<InstructionBase *> &GetUsers() const {
-        return users;
-    }
-    auto GetUsers() {
-        return std::span(users);
+    bool HasUsers() const {
+        return firstUse != nullptr;
     }
 
-    void ReserveUsers(size_t usersCount) {
-        users.reserve(usersCount);
-    }
-    void AddUser(InstructionBase *instr) {
-        ASSERT(instr);
-        users.push_back(instr);
-    }
-    void AddUsers(std::span<InstructionBase *> instrs) {
-        users.reserve(users.size() + instrs.size());
-        for (auto &&it : instrs) {
-            users.push_back(it);
-        }
+    auto GetUsers() const {
+        return std::ranges::subrange(UsersIterator(firstUse), UsersIterator());
     }
 
-    void RemoveUser(InstructionBase *instr) {
-        auto iter = std::find(users.begin(), users.end(), instr);
-        ASSERT(iter != users.end());
-        *iter = users.back();
-        users.pop_back();
+    Input *GetFirstUse() {
+        return firstUse;
     }
-
-    void ReplaceUser(InstructionBase *oldInstr, InstructionBase *newInstr) {
-        auto iter = std::find(users.begin(), users.end(), oldInstr);
-        ASSERT(iter != users.end());
-        *iter = newInstr;
+    const Input *GetFirstUse() const {
+        return firstUse;
     }
 
-    void SetNewUsers(std::pmr::vector<InstructionBase *> &&newUsers) {
-        users = std::move(newUsers);
+private:
+    void addUse(Input *use) {
+        ASSERT((use) && use->prevUse == nullptr && use->nextUse == nullptr);
+        if (firstUse == nullptr) {
+            firstUse = use;
+        } else {
+            auto *lastUse = firstUse->prevUse;
+            lastUse->nextUse = use;
+            use->prevUse = lastUse;
+        }
+        firstUse->prevUse = use;
+        ++usersCount;
     }
-    void SetNewUsers(const std::pmr::vector<InstructionBase *> &newUsers) {
-        users = newUsers;
+    void removeUse(Input *use) {
+        ASSERT((use) && usersCount > 0);
+        auto *next = use->nextUse;
+        if (use == firstUse) {
+            firstUse = next;
+            if (next) {
+                next->prevUse = use->prevUse;
+            }
+        } else {
+            use->prevUse->nextUse = next;
+            (next ? next : firstUse)->prevUse = use->prevUse;
+        }
+        use->prevUse = nullptr;
+        use->nextUse = nullptr;
+        --usersCount;
     }
 
-protected:
-    std::pmr::vector<InstructionBase *> users;
+private:
+    Input *firstUse = nullptr;
+    size_t usersCount = 0;
+
+    friend class Input;
 };
 }   // namespace ir
 
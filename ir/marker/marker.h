@@ -9,11 +9,15 @@
 
 
 namespace ir {
+// Marker consists of a slot index and a generation number.
+// Every new marker gets a new generation, so values stored in the slot by
+// previous markers are not considered set, and clearing a marker
+// over the whole graph does not require visiting the graph.
 using Marker = uint32_t;
 
 enum class MarkersConstants : uint32_t {
     BIT_SIZE = sizeof(Marker) * 8,
-    BIT_LENGTH = 2,
+    BIT_LENGTH = 3,
     MAX_MARKERS = 1U << BIT_LENGTH,
     INDEX_MASK = MAX_MARKERS - 1U,
     MAX_VALUE = (1U << (BIT_SIZE - BIT_LENGTH)) - 1U,
@@ -27,25 +31,31 @@ public:
     NO_MOVE_SEMANTIC(MarkerManager);
     virtual DEFAULT_DTOR(MarkerManager);
 
-    // TODO: implement shared_ptr-like marker behavior
+    // Prefer MarkerHolder, which releases the marker automatically.
     Marker GetNewMarker() const {
-        ASSERT(currentIndex < utils::to_underlying(MarkersConstants::MAX_VALUE));
-        ++currentIndex;
         for (uint32_t i = 0; i < markersSlots.size(); ++i) {
             if (!markersSlots[i]) {
-                Marker mark =
-                    (currentIndex << utils::to_underlying(MarkersConstants::BIT_LENGTH)) | i;
                 markersSlots[i] = true;
-                return mark;
+                return makeMarker(i);
             }
         }
         UNREACHABLE("free marker slot not found");
         return 0;
     }
+    // Returns marker occupying the same slot, which is not set for any object.
+    Marker RenewMarker(Marker mark) const {
+        size_t index = mark & utils::to_underlying(MarkersConstants::INDEX_MASK);
+        ASSERT(markersSlots[index]);
+        return makeMarker(index);
+    }
     void ReleaseMarker(Marker mark) const {
         size_t index = mark & utils::to_underlying(MarkersConstants::INDEX_MASK);
+        ASSERT(markersSlots[index]);
         markersSlots[index] = false;
     }
+    size_t GetFreeMarkersCount() const {
+        return markersSlots.size() - markersSlots.count();
+    }
     size_t GetMarkerIndex() const {
         return currentIndex;
     }
@@ -54,17 +64,51 @@ public:
         currentIndex = std::max(currentIndex, newIndex);
     }
 
+private:
+    Marker makeMarker(size_t slotIndex) const {
+        ASSERT(currentIndex < utils::to_underlying(MarkersConstants::MAX_VALUE));
+        ++currentIndex;
+        return (currentIndex << utils::to_underlying(MarkersConstants::BIT_LENGTH)) | slotIndex;
+    }
+
 private:
     mutable size_t currentIndex = 0;
     mutable std::bitset<utils::to_underlying(MarkersConstants::MAX_MARKERS)> markersSlots{false};
 };
 
+// Owns a marker during its lifetime.
+class MarkerHolder final {
+public:
+    explicit MarkerHolder(const MarkerManager *manager)
+        : manager(manager), marker(manager->GetNewMarker()) {}
+    NO_COPY_SEMANTIC(MarkerHolder);
+    NO_MOVE_SEMANTIC(MarkerHolder);
+    ~MarkerHolder() noexcept {
+        manager->ReleaseMarker(marker);
+    }
+
+    Marker GetMarker() const {
+        return marker;
+    }
+    operator Marker() const {
+        return marker;
+    }
+    // Unsets the marker for all objects in O(1).
+    void Reset() {
+        marker = manager->RenewMarker(marker);
+    }
+
+private:
+    const MarkerManager *manager;
+    Marker marker;
+};
+
 class Markable {
 public:
     Markable() = default;
     NO_COPY_SEMANTIC(Markable);
     NO_MOVE_SEMANTIC(Markable);
-    virtual DEFAULT_DTOR(Markable);
+    DEFAULT_DTOR(Markable);
 
     bool SetMarker(Marker mark) const {
         auto value = mark >> utils::to_underlying(MarkersConstants::BIT_LENGTH);
@@ -1,40 +1,47 @@
 #include <algorithm>
 #include "BranchElimination.h"
 #include "GraphChecker.h"
+#include "InstructionBuilder.h"
 
 
 namespace ir {
 // TODO: can remove more branches,
-// e.g. falling under the same conditions as previously encountered
+// e.g. comparing unsigned values under the same conditions as previously encountered
 bool BranchElimination::Run() {
-    bool domTreeValid = graph->IsAnalysisValid(AnalysisFlag::DOM_TREE);
-
-    bool removed = propagateConstsInCond();
+    ValueRangeAnalysis rangeAnalysis(graph);
+    rangeAnalysis.Run();
+    bool removed = propagateConstsInCond(rangeAnalysis);
     if (!removed) {
         return false;
     }
 
-    auto liveMarker = doMarkPhase();
+    MarkerHolder live(graph);
+    auto liveMarker = live.GetMarker();
+    doMarkPhase(liveMarker);
 
     // remove not marked blocks
-    graph->ForEachBasicBlock([liveMarker, domTreeValid, this](BasicBlock *b) {
+    std::pmr::vector<BasicBlock *> removedBlocks(GetScratchResource());
+    graph->ForEachBasicBlock([liveMarker, &removedBlocks, this](BasicBlock *b) {
         if (!b->IsMarkerSet(liveMarker)) {
             GetLogger(utils::LogPriority::INFO) << "Removing block #" << b->GetId();
-            removeUnreachable(b, liveMarker, domTreeValid);
+            removeUnreachable(b, liveMarker);
+            removedBlocks.push_back(b);
         }
     });
 
-    postElimination(domTreeValid);
-    graph->ReleaseMarker(liveMarker);
+    postElimination();
+    destroyBlocks(removedBlocks);
     return true;
 }
 
-bool BranchElimination::propagateConstsInCond() {
+// Ranges computed before removal of edges remain valid, as values can only be
+// defined on fewer paths after that.
+bool BranchElimination::propagateConstsInCond(const ValueRangeAnalysis &rangeAnalysis) {
     bool removed = false;
-    graph->ForEachBasicBlock([this, &removed](BasicBlock *bblock) {
+    graph->ForEachBasicBlock([this, &removed, &rangeAnalysis](BasicBlock *bblock) {
         auto *cmp = bblock->EndsWithConditionalJump();
         if (cmp != nullptr) {
-            auto eval = evaluateComparison(cmp);
+            auto eval = evaluateComparison(cmp, rangeAnalysis);
             if (eval != CmpResult::UNDEFINED) {
                 removeEdge(cmp, static_cast<bool>(eval));
                 removed = true;
@@ -46,10 +53,9 @@ bool BranchElimination::propagateConstsInCond() {
     return removed;
 }
 
-Marker BranchElimination::doMarkPhase() {
+void BranchElimination::doMarkPhase(Marker liveMarker) {
     // do RPO and mark reachable blocks
-    auto liveMarker = graph->GetNewMarker();
-    std::pmr::vector<BasicBlock *> rpo(graph->GetMemoryResource());
+    std::pmr::vector<BasicBlock *> rpo(GetScratchResource());
     rpo.reserve(graph->GetBasicBlocksCount());
 
     auto callback = [&rpo, liveMarker](BasicBlock *bblock){
@@ -62,21 +68,35 @@ Marker BranchElimination::doMarkPhase() {
     // reset RPO
     std::reverse(rpo.begin(), rpo.end());
     graph->SetRPO(std::move(rpo));
-
-    return liveMarker;
 }
 
-CmpResult BranchElimination::evaluateComparison(CompareInstruction *instr) {
+/* static */
+CmpResult BranchElimination::evaluateComparison(CompareInstruction *instr,
+                                                const ValueRangeAnalysis &rangeAnalysis)
+{
     ASSERT(instr);
     auto condCode = instr->GetCondCode();
     auto input0 = instr->GetInput(0);
     auto input1 = instr->GetInput(1);
     if (input0 == input1) {
-        if (condCode == CondCode::GE || condCode == CondCode::EQ) {
+        if (condCode == CondCode::GE || condCode == CondCode::LE || condCode == CondCode::EQ) {
             return CmpResult::TRUE;
         }
         return CmpResult::FALSE;
     }
+    auto type = instr->GetType();
+    // ranges are ordered as signed values
+    if (IsSignedType(type)) {
+        auto *bblock = instr->GetBasicBlock();
+        auto lhs = rangeAnalysis.GetRange(input0.GetInstruction(), bblock);
+        auto rhs = rangeAnalysis.GetRange(input1.GetInstruction(), bblock);
+        if (ValueRange::AlwaysHolds(condCode, lhs, rhs)) {
+            return CmpResult::TRUE;
+        }
+        if (ValueRange::AlwaysHolds(negateCondCode(condCode), lhs, rhs)) {
+            return CmpResult::FALSE;
+        }
+    }
     if (input0->IsConst() && input1->IsConst()) {
         return compare(condCode, input0->AsConst()->GetValue(), input1->AsConst()->GetValue())
             ? CmpResult::TRUE : CmpResult::FALSE;
@@ -96,12 +116,16 @@ void BranchElimination::removeEdge(CompareInstruction *instr, bool cmpRes) {
     ASSERT(removeBlock->GetPredecessorsCount() > 0);
     bblock->UnlinkInstruction(jcmp);
     bblock->UnlinkInstruction(instr);
+    instr->RemoveUserFromInputs();
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    instrBuilder->DestroyInstruction(jcmp);
+    instrBuilder->DestroyInstruction(instr);
 
     graph->DisconnectBasicBlocks(bblock, removeBlock);
 }
 
 /* static */
-void BranchElimination::removeUnreachable(BasicBlock *bblock, Marker liveMarker, bool fixDomTree) {
+void BranchElimination::removeUnreachable(BasicBlock *bblock, Marker liveMarker) {
     ASSERT(bblock);
     // check unreachability conditions for blocks after mark stage
     ASSERT(std::all_of(
@@ -115,23 +139,31 @@ void BranchElimination::removeUnreachable(BasicBlock *bblock, Marker liveMarker,
             bblock->GetGraph()->DisconnectBasicBlocks(bblock, succ);
         }
     }
+    // the block has already been removed from the dominators tree by the graph
+    ASSERT(!bblock->GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE) || bblock->GetDominator() == nullptr);
 
-    if (fixDomTree) {
-        auto *dominator = bblock->GetDominator();
-        ASSERT(dominator);
-        if (dominator->IsMarkerSet(liveMarker)) {
-            dominator->RemoveDominatedBlock(bblock);
+    bblock->GetGraph()->UnlinkBasicBlockRaw(bblock);
+}
+
+void BranchElimination::destroyBlocks(const std::pmr::vector<BasicBlock *> &removedBlocks) {
+    // instructions of unreachable blocks can be used only in other unreachable blocks,
+    // so all uses are removed before any instruction is destroyed
+    for (auto *bblock : removedBlocks) {
+        for (auto *instr : *bblock) {
+            if (instr->HasInputs()) {
+                instr->AsInputsInstruction()->RemoveUserFromInputs();
+            }
         }
     }
-
-    bblock->GetGraph()->UnlinkBasicBlockRaw(bblock);
+    for (auto *bblock : removedBlocks) {
+        graph->DestroyBasicBlock(bblock);
+    }
 }
 
-void BranchElimination::postElimination(bool domTreeValid) {
+void BranchElimination::postElimination() {
     ASSERT(PassManager::Run<GraphChecker>(graph));
 
-    PassManager::SetInvalid<AnalysisFlag::LOOP_ANALYSIS>(graph);
-    graph->SetAnalysisValid<AnalysisFlag::DOM_TREE>(domTreeValid);
+    PassManager::SetInvalid<AnalysisFlag::LOOP_ANALYSIS, AnalysisFlag::BLOCK_FREQUENCY>(graph);
     graph->SetAnalysisValid<AnalysisFlag::RPO>(true);
 }
 }   // namespace ir
@@ -2,6 +2,7 @@
 #define JIT_AOT_COMPILERS_COURSE_BRANCH_ELIMINATION_H_
 
 #include "PassBase.h"
+#include "ValueRangeAnalysis.h"
 
 
 namespace ir {
@@ -26,15 +27,16 @@ public:
     }
 
 private:
-    static void removeUnreachable(BasicBlock *bblock, Marker liveMarker, bool fixDomTree);
+    static void removeUnreachable(BasicBlock *bblock, Marker liveMarker);
 
-    bool propagateConstsInCond();
-    CmpResult evaluateComparison(CompareInstruction *instr);
+    bool propagateConstsInCond(const ValueRangeAnalysis &rangeAnalysis);
+    static CmpResult evaluateComparison(CompareInstruction *instr, const ValueRangeAnalysis &rangeAnalysis);
     void removeEdge(CompareInstruction *instr, bool cmpRes);
 
-    Marker doMarkPhase();
+    void doMarkPhase(Marker liveMarker);
 
-    void postElimination(bool domTreeValid);
+    void postElimination();
+    void destroyBlocks(const std::pmr::vector<BasicBlock *> &removedBlocks);
 
 private:
     static constexpr const char *PASS_NAME = "branch_elimination";
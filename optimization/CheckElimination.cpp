@@ -8,13 +8,27 @@ namespace ir {
 bool CheckElimination::Run() {
     PassManager::Run<RPO>(graph);
     PassManager::Run<DomTreeBuilder>(graph);
+    ValueRangeAnalysis rangeAnalysis(graph);
+    rangeAnalysis.Run();
 
     bool removed = false;
+    std::pmr::vector<InstructionBase *> provenChecks(GetScratchResource());
     for (auto *bblock : graph->GetRPO()) {
         for (auto *current : bblock->IterateNonPhi()) {
-            removed |= tryRemoveCheck(current);
+            if (isCheckProven(current, rangeAnalysis)) {
+                provenChecks.push_back(current);
+            } else {
+                removed |= tryRemoveCheck(current);
+            }
         }
     }
+    for (auto *check : provenChecks) {
+        check->GetBasicBlock()->UnlinkInstruction(check);
+        GetLogger(utils::LogPriority::INFO) << "Removed "
+                                            << check->GetOpcodeName() << " #" << check->GetId()
+                                            << " proven by value ranges";
+        removed = true;
+    }
 
     if (removed) {
         ASSERT(PassManager::Run<GraphChecker>(graph));
@@ -22,6 +36,27 @@ bool CheckElimination::Run() {
     return removed;
 }
 
+/* static */
+bool CheckElimination::isCheckProven(const InstructionBase *instr, const ValueRangeAnalysis &rangeAnalysis) {
+    ASSERT(instr);
+    auto opcode = instr->GetOpcode();
+    if (opcode != Opcode::ZERO_CHECK && opcode != Opcode::NEGATIVE_CHECK && opcode != Opcode::BOUNDS_CHECK) {
+        return false;
+    }
+    const auto *inputsInstr = instr->AsInputsInstruction();
+    const auto *bblock = instr->GetBasicBlock();
+    if (opcode == Opcode::BOUNDS_CHECK) {
+        auto idx = rangeAnalysis.GetRange(inputsInstr->GetInput(1).GetInstruction(), bblock);
+        auto length = rangeAnalysis.GetArrayLength(inputsInstr->GetInput(0).GetInstruction());
+        return !idx.IsEmpty() && idx.min >= 0 && !length.IsEmpty() && idx.max < length.min;
+    }
+    auto range = rangeAnalysis.GetRange(inputsInstr->GetInput(0).GetInstruction(), bblock);
+    if (range.IsEmpty()) {
+        return false;
+    }
+    return opcode == Opcode::ZERO_CHECK ? !range.Contains(0) : range.min >= 0;
+}
+
 bool CheckElimination::tryRemoveCheck(InstructionBase *instr) {
     ASSERT(instr);
     auto opcode = instr->GetOpcode();
@@ -2,6 +2,7 @@
 #define JIT_AOT_COMPILERS_COURSE_CHECK_ELIMINATION_H_
 
 #include "PassBase.h"
+#include "ValueRangeAnalysis.h"
 
 
 namespace ir {
@@ -23,6 +24,8 @@ private:
     static constexpr const char *PASS_NAME = "check_elimination";
 
 private:
+    // Returns true if the check never fails for ranges of its inputs.
+    static bool isCheckProven(const InstructionBase *instr, const ValueRangeAnalysis &rangeAnalysis);
     bool tryRemoveCheck(InstructionBase *instr);
     bool singleInputCheckDominates(InputsInstruction *check, InstructionBase *checkedValue);
     bool boundsCheckDominates(InputsInstruction *check, InstructionBase *ref, InstructionBase *idx);
@@ -1,5 +1,4 @@
 #include "ConstantFolding.h"
-#include "InstructionBuilder.h"
 
 
 namespace ir {
@@ -9,10 +8,8 @@ bool ConstantFolding::ProcessAND(BinaryRegInstruction *instr) {
     auto input2 = instr->GetInput(1);
     if (input1->IsConst() && input2->IsConst()) {
         auto value = input1->AsConst()->GetValue() & input2->AsConst()->GetValue();
-        auto *newInstr = getInstructionBuilder(instr)->CreateCONST(instr->GetType(), value);
+        auto *newInstr = getGraph(instr)->FindOrCreateConstant(instr->GetType(), value);
 
-        input1->RemoveUser(instr);
-        input2->RemoveUser(instr);
         ReplaceWithConst(instr, newInstr);
 
         return true;
@@ -27,10 +24,8 @@ bool ConstantFolding::ProcessSRA(BinaryRegInstruction *instr) {
     if (input1->IsConst() && input2->IsConst()) {
         auto value = ToSigned(input1->AsConst()->GetValue(), instr->GetType()) >>\
             input2->AsConst()->GetValue();
-        auto *newInstr = getInstructionBuilder(instr)->CreateCONST(instr->GetType(), value);
+        auto *newInstr = getGraph(instr)->FindOrCreateConstant(instr->GetType(), value);
 
-        input1->RemoveUser(instr);
-        input2->RemoveUser(instr);
         ReplaceWithConst(instr, newInstr);
 
         return true;
@@ -44,10 +39,8 @@ bool ConstantFolding::ProcessSUB(BinaryRegInstruction *instr) {
     auto input2 = instr->GetInput(1);
     if (input1->IsConst() && input2->IsConst()) {
         auto value = input1->AsConst()->GetValue() - input2->AsConst()->GetValue();
-        auto *newInstr = getInstructionBuilder(instr)->CreateCONST(instr->GetType(), value);
+        auto *newInstr = getGraph(instr)->FindOrCreateConstant(instr->GetType(), value);
 
-        input1->RemoveUser(instr);
-        input2->RemoveUser(instr);
         ReplaceWithConst(instr, newInstr);
 
         return true;
@@ -59,14 +52,19 @@ bool ConstantFolding::ProcessSUB(BinaryRegInstruction *instr) {
 void ConstantFolding::ReplaceWithConst(InstructionBase *instr, ConstantInstruction *targetConst) {
     ASSERT((instr) && (targetConst));
     instr->ReplaceInputInUsers(targetConst);
+    if (instr->HasInputs()) {
+        instr->AsInputsInstruction()->RemoveUserFromInputs();
+    }
     auto *bblock = instr->GetBasicBlock();
     bblock->UnlinkInstruction(instr);
-    ASSERT(bblock->GetGraph()->GetFirstBasicBlock());
-    bblock->GetGraph()->GetFirstBasicBlock()->PushBackInstruction(targetConst);
+    if (targetConst->GetBasicBlock() == nullptr) {
+        ASSERT(bblock->GetGraph()->GetFirstBasicBlock());
+        bblock->GetGraph()->GetFirstBasicBlock()->PushBackInstruction(targetConst);
+    }
 }
 
 /* static */
-InstructionBuilder *ConstantFolding::getInstructionBuilder(InstructionBase *instr) {
-    return instr->GetBasicBlock()->GetGraph()->GetInstructionBuilder();
+Graph *ConstantFolding::getGraph(InstructionBase *instr) {
+    return instr->GetBasicBlock()->GetGraph();
 }
 }   // namespace ir
@@ -22,7 +22,7 @@ public:
     static void ReplaceWithConst(InstructionBase *instr, ConstantInstruction *targetConst);
 
 private:
-    static InstructionBuilder *getInstructionBuilder(InstructionBase *instr);
+    static Graph *getGraph(InstructionBase *instr);
 };
 }   // namespace ir
 
@@ -1,10 +1,12 @@
 #include "DCE.h"
+#include "InstructionBuilder.h"
 #include "Traversals.h"
 
 
 namespace ir {
 bool DCEPass::Run() {
-    aliveMarker = graph->GetNewMarker();
+    MarkerHolder alive(graph);
+    aliveMarker = alive.GetMarker();
 
     PassManager::Run<RPO>(graph);
     auto rpoTraversal = graph->GetRPO();
@@ -30,14 +32,18 @@ bool DCEPass::Run() {
 }
 
 void DCEPass::markAlive(InstructionBase *instr) {
-    ASSERT(instr);
-    GetLogger(utils::LogPriority::DEBUG)
-        << "Marking live instruction " << instr->GetId() << ' ' << instr->GetOpcodeName();
-    auto wasSet = instr->SetMarker(aliveMarker);
-    if (instr->HasInputs() && wasSet) {
-        auto *inputInstr = instr->AsInputsInstruction();
-        for (size_t i = 0, end = inputInstr->GetInputsCount(); i < end; ++i) {
-            markAlive(inputInstr->GetInput(i).GetInstruction());
+    ASSERT((instr) && worklist.empty());
+    worklist.push_back(instr);
+    while (!worklist.empty()) {
+        auto *current = worklist.back();
+        worklist.pop_back();
+        GetLogger(utils::LogPriority::DEBUG)
+            << "Marking live instruction " << current->GetId() << ' ' << current->GetOpcodeName();
+        auto wasSet = current->SetMarker(aliveMarker);
+        if (current->HasInputs() && wasSet) {
+            current->AsInputsInstruction()->ForEachInput([this](Input &input) {
+                worklist.push_back(input.GetInstruction());
+            });
         }
     }
 }
@@ -52,8 +58,16 @@ void DCEPass::markDead(InstructionBase *instr) {
 
 void DCEPass::removeDead() {
     for (auto *instr : deadInstrs) {
+        if (instr->HasInputs()) {
+            instr->AsInputsInstruction()->RemoveUserFromInputs();
+        }
         instr->GetBasicBlock()->UnlinkInstruction(instr);
     }
+    // dead instructions may use each other, so they are destroyed only after all are unlinked
+    auto *instrBuilder = graph->GetInstructionBuilder();
+    for (auto *instr : deadInstrs) {
+        instrBuilder->DestroyInstruction(instr);
+    }
     deadInstrs.clear();
 }
 }   // namespace ir
@@ -12,7 +12,8 @@ public:
     explicit DCEPass(Graph *graph)
         : PassBase(graph),
           utils::Logger(log4cpp::Category::getInstance(GetName())),
-          deadInstrs(graph->GetMemoryResource())
+          worklist(GetScratchResource()),
+          deadInstrs(GetScratchResource())
     {}
     ~DCEPass() noexcept override = default;
 
@@ -33,6 +34,9 @@ private:
 private:
     Marker aliveMarker;
 
+    // instructions to be marked alive, kept on an explicit stack for long def chains
+    std::pmr::vector<InstructionBase *> worklist;
+
     std::pmr::vector<InstructionBase *> deadInstrs;
 };
 }   // namespace ir
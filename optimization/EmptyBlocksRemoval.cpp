@@ -1,4 +1,5 @@
 #include "EmptyBlocksRemoval.h"
+#include "InstructionBuilder.h"
 #include "Traversals.h"
 
 
@@ -39,6 +40,10 @@ bool EmptyBlocksRemoval::RemoveIfEmpty(BasicBlock *bblock) {
                 ASSERT(cmp && cmp->GetOpcode() == Opcode::CMP);
                 pred->UnlinkInstruction(jcmp);
                 pred->UnlinkInstruction(cmp);
+                cmp->AsInputsInstruction()->RemoveUserFromInputs();
+                auto *instrBuilder = pred->GetGraph()->GetInstructionBuilder();
+                instrBuilder->DestroyInstruction(jcmp);
+                instrBuilder->DestroyInstruction(cmp);
             }
             pred->RemoveSuccessor(bblock);
         } else {
@@ -48,7 +53,9 @@ bool EmptyBlocksRemoval::RemoveIfEmpty(BasicBlock *bblock) {
     }
     bblock->GetPredecessors().clear();
     bblock->GetSuccessors().clear();
-    bblock->GetGraph()->UnlinkBasicBlock(bblock);
+    auto *graph = bblock->GetGraph();
+    graph->UnlinkBasicBlock(bblock);
+    graph->DestroyBasicBlock(bblock);
     return true;
 }
 
@@ -56,6 +63,7 @@ void EmptyBlocksRemoval::postRemoval() {
     PassManager::SetInvalid<
         AnalysisFlag::DOM_TREE,
         AnalysisFlag::LOOP_ANALYSIS,
-        AnalysisFlag::RPO>(graph);
+        AnalysisFlag::RPO,
+        AnalysisFlag::BLOCK_FREQUENCY>(graph);
 }
 }   // namespace ir
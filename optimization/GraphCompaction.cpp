@@ -0,0 +1,47 @@
+#include <algorithm>
+#include "GraphCompaction.h"
+#include "InstructionBuilder.h"
+#include "Traversals.h"
+
+
+namespace ir {
+bool GraphCompaction::Run() {
+    if (graph->IsEmpty()) {
+        return false;
+    }
+    renumberBlocks();
+    renumberInstructions();
+    return true;
+}
+
+void GraphCompaction::renumberBlocks() {
+    if (order == CompactionOrder::KEEP) {
+        graph->RemoveUnlinkedBlocks();
+        return;
+    }
+    if (graph->IsAnalysisValid(AnalysisFlag::RPO)) {
+        auto rpo = graph->GetRPO();
+        graph->RenumberBasicBlocks(rpo);
+        return;
+    }
+    // unreachable blocks are not visited, they are numbered after the reachable ones
+    std::pmr::vector<BasicBlock *> rpo(GetScratchResource());
+    auto callback = [&rpo](BasicBlock *bblock) { rpo.push_back(bblock); };
+    DFO::Traverse<Graph, decltype(callback), false>(graph, callback);
+    std::reverse(rpo.begin(), rpo.end());
+    graph->RenumberBasicBlocks(rpo);
+}
+
+void GraphCompaction::renumberInstructions() {
+    InstructionBase::IdType nextId = 0;
+    graph->ForEachBasicBlock([&nextId](BasicBlock *bblock) {
+        for (auto *instr : *bblock) {
+            instr->SetId(nextId++);
+        }
+    });
+    // so that tables sized by the next ID shrink as well
+    graph->GetInstructionBuilder()->ResetNextId(nextId);
+    // cached alias information is keyed by the old IDs
+    PassManager::SetInvalid<AnalysisFlag::ALIAS_ANALYSIS>(graph);
+}
+}   // namespace ir
@@ -0,0 +1,39 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_GRAPH_COMPACTION_H_
+#define JIT_AOT_COMPILERS_COURSE_GRAPH_COMPACTION_H_
+
+#include "PassBase.h"
+
+
+namespace ir {
+enum class CompactionOrder : uint8_t {
+    // keep relative order of blocks
+    KEEP = 0,
+    // number blocks in reverse post order
+    RPO
+};
+
+// Renumbers basic blocks and instructions of the graph into dense ranges
+// starting from zero, so that ID-indexed side tables are not larger than needed.
+// Instructions are numbered in the order of their blocks, and the builder's next ID
+// is reset to their count. Unreachable blocks are numbered after the reachable ones.
+// See Compiler::RelocateGraph to move the graph into a fresh arena as well.
+class GraphCompaction : public PassBase {
+public:
+    explicit GraphCompaction(Graph *graph, CompactionOrder order = CompactionOrder::RPO)
+        : PassBase(graph), order(order) {}
+    NO_COPY_SEMANTIC(GraphCompaction);
+    NO_MOVE_SEMANTIC(GraphCompaction);
+    ~GraphCompaction() noexcept override = default;
+
+    bool Run() override;
+
+private:
+    void renumberBlocks();
+    void renumberInstructions();
+
+private:
+    CompactionOrder order;
+};
+}   // namespace ir
+
+#endif  // JIT_AOT_COMPILERS_COURSE_GRAPH_COMPACTION_H_
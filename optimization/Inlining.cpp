@@ -29,8 +29,14 @@ bool InliningPass::Run() {
             auto *copyGraph = graph->GetCompiler()->CopyGraph(
                 calleeGraph,
                 graph->GetInstructionBuilder());
+            if (copyGraph == nullptr) {
+                GetLogger(utils::LogPriority::INFO) << "Failed to copy function #" << call->GetCallTarget();
+                continue;
+            }
 
             doInlining(call, copyGraph);
+            // copy's blocks and instructions now belong to the caller
+            graph->GetCompiler()->DeleteFunctionGraph(copyGraph->GetId());
             postInlining();
             // TODO: optimize instructions' counting
             instructions_count = graph->CountInstructions();
@@ -128,7 +134,7 @@ void InliningPass::propagateReturnValue(CallInstruction *call,
             auto *retInstr = static_cast<RetInstruction *>(instr);
             auto phiInput = retInstr->GetInput(0);
             phiReturnValue->AddPhiInput(phiInput, pred);
-            phiInput->RemoveUser(retInstr);
+            retInstr->RemoveUserFromInputs();
             pred->UnlinkInstruction(retInstr);
         }
         postCallBlock->PushForwardInstruction(phiReturnValue);
@@ -141,7 +147,7 @@ void InliningPass::propagateReturnValue(CallInstruction *call,
 
         auto *retInstr = static_cast<RetInstruction *>(instr);
         newInputForUsers = retInstr->GetInput(0).GetInstruction();
-        newInputForUsers->RemoveUser(retInstr);
+        retInstr->RemoveUserFromInputs();
         pred->UnlinkInstruction(retInstr);
     }
     call->ReplaceInputInUsers(newInputForUsers);
@@ -160,10 +166,18 @@ void InliningPass::moveConstants(Graph *callee) {
     ASSERT(callee && callee->GetFirstBasicBlock());
     auto *firstBlock = graph->GetFirstBasicBlock();
     ASSERT(firstBlock);
+    auto &pool = graph->GetConstantPool();
     auto *instr = callee->GetFirstBasicBlock()->GetLastInstruction();
     while (instr != nullptr && instr->IsConst()) {
         auto *prev = instr->GetPrevInstruction();
-        firstBlock->MoveConstantUnsafe(instr);
+        auto *constInstr = instr->AsConst();
+        // callee's constants equal to the caller's ones are merged into them
+        auto *existing = pool.Find(constInstr->GetType(), constInstr->GetValue());
+        if (existing != nullptr) {
+            constInstr->ReplaceInputInUsers(existing);
+        } else {
+            firstBlock->MoveConstantUnsafe(constInstr);
+        }
         instr = prev;
     }
 }
@@ -213,7 +227,8 @@ void InliningPass::postInlining() {
     PassManager::SetInvalid<
         AnalysisFlag::DOM_TREE,
         AnalysisFlag::LOOP_ANALYSIS,
-        AnalysisFlag::RPO>(graph);
+        AnalysisFlag::RPO,
+        AnalysisFlag::BLOCK_FREQUENCY>(graph);
 
     // TODO: may move post-pass routine into PassBase by providing type traits
     PassManager::Run<EmptyBlocksRemoval>(graph);
@@ -134,8 +134,8 @@ bool PeepholePass::tryANDAfterNOT(BinaryRegInstruction *instr) {
         auto not2Arg = static_cast<UnaryRegInstruction *>(input2.GetInstruction())->GetInput(0);
         auto *orInstr = graph->GetInstructionBuilder()->CreateOR(instr->GetType(), not1Arg, not2Arg);
 
-        not1Arg->ReplaceUser(input1.GetInstruction(), orInstr);
-        not2Arg->ReplaceUser(input2.GetInstruction(), orInstr);
+        input1->AsInputsInstruction()->RemoveUserFromInputs();
+        input2->AsInputsInstruction()->RemoveUserFromInputs();
         auto *bblock = instr->GetBasicBlock();
         bblock->UnlinkInstruction(input1.GetInstruction());
         bblock->UnlinkInstruction(input2.GetInstruction());
@@ -143,10 +143,7 @@ bool PeepholePass::tryANDAfterNOT(BinaryRegInstruction *instr) {
         instr->GetBasicBlock()->InsertBefore(instr, orInstr);
 
         auto *notInstr = graph->GetInstructionBuilder()->CreateNOT(instr->GetType(), orInstr);
-        orInstr->AddUser(notInstr);
-        // input1 and input2 instructions are later removed on DCE
-        input1->RemoveUser(instr);
-        input2->RemoveUser(instr);
+        instr->RemoveUserFromInputs();
         instr->GetBasicBlock()->ReplaceInstruction(instr, notInstr);
 
         GetLogger(utils::LogPriority::INFO) << "Applied AND: 'v2 = ~v0 & ~v1' -> 'v2 = ~(v0 | v1)' peephole";
@@ -184,15 +181,10 @@ bool PeepholePass::trySequencedSRA(BinaryRegInstruction *instr) {
         auto offset2 = typed->GetInput(1);
         auto *addInstr = graph->GetInstructionBuilder()->CreateADD(instr->GetType(), offset1,
                                                                    offset2);
-        offset1->ReplaceUser(instr, addInstr);
-        offset2->AddUser(addInstr);
         instr->GetBasicBlock()->InsertBefore(instr, addInstr);
 
-        base->RemoveUser(instr);
-        instr->ReplaceInput(instr->GetInput(0), base2);
-        instr->ReplaceInput(offset1, addInstr);
-        base2->AddUser(instr);
-        addInstr->AddUser(instr);
+        instr->SetInput(base2, 0);
+        instr->SetInput(addInstr, 1);
 
         GetLogger(utils::LogPriority::INFO) << "Applied SRA -> SRA peephole";
         return true;
@@ -204,14 +196,10 @@ bool PeepholePass::trySequencedSRA(BinaryRegInstruction *instr) {
         auto offset2 = typed->GetValue();
         auto *addInstr = graph->GetInstructionBuilder()->CreateADDI(instr->GetType(), offset1,
                                                                     offset2);
-        offset1->ReplaceUser(instr, addInstr);
         instr->GetBasicBlock()->InsertBefore(instr, addInstr);
 
-        base->RemoveUser(instr);
-        instr->ReplaceInput(instr->GetInput(0), base2);
-        instr->ReplaceInput(offset1, addInstr);
-        base2->AddUser(instr);
-        addInstr->AddUser(instr);
+        instr->SetInput(base2, 0);
+        instr->SetInput(addInstr, 1);
 
         GetLogger(utils::LogPriority::INFO) << "Applied SRAI -> SRA peephole";
         return true;
@@ -253,11 +241,9 @@ bool PeepholePass::trySUBAfterNEG(BinaryRegInstruction *instr, Input checked, In
         auto positiveValueInput = typedInput->GetInput();
         // TODO: replace according to IDs order
         auto *newInstr = graph->GetInstructionBuilder()->CreateADD(instr->GetType(), positiveValueInput, second);
-        positiveValueInput->AddUser(newInstr);
 
         instr->GetBasicBlock()->ReplaceInstruction(instr, newInstr);
-        checked->RemoveUser(instr);
-        second->ReplaceUser(instr, newInstr);
+        instr->RemoveUserFromInputs();
 
         GetLogger(utils::LogPriority::INFO) << "Applied NEG -> SUB peephole";
         return true;
@@ -293,8 +279,7 @@ bool PeepholePass::trySUBAfterADD(BinaryRegInstruction *instr) {
         auto *typed = static_cast<BinaryImmInstruction *>(instrInput1.GetInstruction());
         auto input1 = typed->GetInput(0);
         if (input1 == instrInput2) {
-            auto *constInstr = graph->GetInstructionBuilder()->CreateCONST(instr->GetType(), typed->GetValue());
-            typed->RemoveUser(instr);
+            auto *constInstr = graph->FindOrCreateConstant(instr->GetType(), typed->GetValue());
             ConstantFolding::ReplaceWithConst(instr, constInstr);
             GetLogger(utils::LogPriority::INFO) << "Applied ADDI -> SUB peephole";
             return true;
@@ -319,10 +304,8 @@ bool PeepholePass::trySUBAfterADD(BinaryRegInstruction *instr) {
         }
         if (userInstr) {
             auto *negInstr = graph->GetInstructionBuilder()->CreateNEG(instr->GetType(), userInstr);
-            userInstr->AddUser(negInstr);
 
-            instrInput1->RemoveUser(instr);
-            instrInput2->RemoveUser(instr);
+            instr->RemoveUserFromInputs();
             instr->GetBasicBlock()->ReplaceInstruction(instr, negInstr);
             GetLogger(utils::LogPriority::INFO) << "Applied ADD -> SUB peephole";
             return true;
@@ -331,8 +314,7 @@ bool PeepholePass::trySUBAfterADD(BinaryRegInstruction *instr) {
         auto *typed = static_cast<BinaryImmInstruction *>(instrInput2.GetInstruction());
         auto input1 = typed->GetInput(0);
         if (input1 == instrInput1) {
-            auto *constInstr = graph->GetInstructionBuilder()->CreateCONST(instr->GetType(), -(typed->GetValue()));
-            typed->RemoveUser(instr);
+            auto *constInstr = graph->FindOrCreateConstant(instr->GetType(), -(typed->GetValue()));
             ConstantFolding::ReplaceWithConst(instr, constInstr);
             GetLogger(utils::LogPriority::INFO) << "Applied ADDI -> SUB peephole";
             return true;
@@ -348,8 +330,7 @@ bool PeepholePass::trySUBZero(BinaryRegInstruction *instr) {
         auto *typed = input1->AsConst();
         if (typed->GetValue() == 0) {
             auto *negInstr = graph->GetInstructionBuilder()->CreateNEG(input2->GetType(), input2);
-            input1->RemoveUser(instr);
-            input2->ReplaceUser(instr, negInstr);
+            instr->RemoveUserFromInputs();
             instr->GetBasicBlock()->ReplaceInstruction(instr, negInstr);
             GetLogger(utils::LogPriority::INFO) << "Applied SUB: '0 - v' peephole";
             return true;
@@ -369,7 +350,7 @@ bool PeepholePass::trySUBZero(BinaryRegInstruction *instr) {
 bool PeepholePass::trySUBRepeatedArgs(BinaryRegInstruction *instr) {
     if (instr->GetInput(0) == instr->GetInput(1)) {
         // case: v1 = v0 - v0 -> v1 = 0
-        auto *constZero = graph->GetInstructionBuilder()->CreateCONST(instr->GetType(), 0);
+        auto *constZero = graph->FindOrCreateConstant(instr->GetType(), 0);
         ConstantFolding::ReplaceWithConst(instr, constZero);
         GetLogger(utils::LogPriority::INFO) << "Applied SUB: 'v1 = v0 - v0' -> 'v1 = 0' peephole";
         return true;
@@ -383,8 +364,7 @@ void PeepholePass::replaceWithoutNewInstr(BinaryRegInstruction *instr,
     instr->ReplaceInputInUsers(replacedInstr);
     instr->GetBasicBlock()->UnlinkInstruction(instr);
 
-    // these instructions may be deleted later by DCE
-    instr->GetInput(0)->RemoveUser(instr);
-    instr->GetInput(1)->RemoveUser(instr);
+    // inputs may be deleted later by DCE
+    instr->RemoveUserFromInputs();
 }
 }   // namespace ir
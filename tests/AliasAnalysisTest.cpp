@@ -0,0 +1,196 @@
+#include "AliasAnalysis.h"
+#include "TestGraphSamples.h"
+
+
+namespace ir::tests {
+class AliasAnalysisTest : public TestGraphSamples {
+public:
+    // Creates the first block with the arguments and constants, and the block following it.
+    BasicBlock *BuildGraph() {
+        auto *graph = GetGraph();
+        auto *instrBuilder = GetInstructionBuilder();
+        refArg0 = instrBuilder->CreateARG(OperandType::REF);
+        refArg1 = instrBuilder->CreateARG(OperandType::REF);
+        idxArg = instrBuilder->CreateARG(TYPE);
+        constOne = instrBuilder->CreateCONST(TYPE, 1);
+        constTwo = instrBuilder->CreateCONST(TYPE, 2);
+        auto *firstBlock = FillFirstBlock(graph, refArg0, refArg1, idxArg, constOne, constTwo);
+        auto *bblock = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(firstBlock, bblock);
+        return bblock;
+    }
+
+public:
+    static constexpr auto TYPE = OperandType::I32;
+
+    InputArgumentInstruction *refArg0 = nullptr;
+    InputArgumentInstruction *refArg1 = nullptr;
+    InputArgumentInstruction *idxArg = nullptr;
+    ConstantInstruction *constOne = nullptr;
+    ConstantInstruction *constTwo = nullptr;
+};
+
+TEST_F(AliasAnalysisTest, TestObjects) {
+    auto *bblock = BuildGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *obj1 = instrBuilder->CreateNEW_OBJECT(1);
+    auto *obj2 = instrBuilder->CreateNEW_OBJECT(1);
+    auto *move = instrBuilder->CreateMOVE(obj1);
+    auto *store = instrBuilder->CreateSTORE_OBJECT(obj1, constOne, 0);
+    auto *loadOther = instrBuilder->CreateLOAD_OBJECT(TYPE, obj2, 0);
+    auto *loadArg0 = instrBuilder->CreateLOAD_OBJECT(TYPE, refArg0, 0);
+    auto *loadArg1 = instrBuilder->CreateLOAD_OBJECT(TYPE, refArg1, 0);
+    auto *loadField = instrBuilder->CreateLOAD_OBJECT(TYPE, move, 8);
+    auto *loadSame = instrBuilder->CreateLOAD_OBJECT(TYPE, move, 0);
+    instrBuilder->PushBackInstruction(
+        bblock,
+        obj1, obj2, move, store, loadOther, loadArg0, loadArg1, loadField, loadSame,
+        instrBuilder->CreateRETVOID());
+
+    auto *graph = GetGraph();
+    PassManager::Run<AliasAnalysis>(graph);
+
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, obj1, move), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadOther), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadArg0), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, loadArg0, loadArg1), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadField), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadSame), AliasResult::MUST_ALIAS);
+}
+
+TEST_F(AliasAnalysisTest, TestStoredCast) {
+    auto *bblock = BuildGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *cast = instrBuilder->CreateCAST(TYPE, OperandType::I64, idxArg);
+    auto *store = instrBuilder->CreateSTORE_OBJECT(refArg0, cast, 8);
+    auto *load = instrBuilder->CreateLOAD_OBJECT(OperandType::I64, refArg0, 8);
+    auto *loadSource = instrBuilder->CreateLOAD_OBJECT(TYPE, refArg0, 8);
+    instrBuilder->PushBackInstruction(bblock, cast, store, load, loadSource, instrBuilder->CreateRETVOID());
+
+    auto *graph = GetGraph();
+    PassManager::Run<AliasAnalysis>(graph);
+
+    // the stored value has the cast's target type
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, load), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadSource), AliasResult::NO_ALIAS);
+}
+
+TEST_F(AliasAnalysisTest, TestArrays) {
+    auto *bblock = BuildGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *store = instrBuilder->CreateSTORE_ARRAY_IMM(refArg0, constOne, 1);
+    auto *loadSame = instrBuilder->CreateLOAD_ARRAY(TYPE, refArg0, constOne);
+    auto *loadOther = instrBuilder->CreateLOAD_ARRAY(TYPE, refArg0, constTwo);
+    auto *loadUnknown1 = instrBuilder->CreateLOAD_ARRAY(TYPE, refArg0, idxArg);
+    auto *loadUnknown2 = instrBuilder->CreateLOAD_ARRAY(TYPE, refArg0, idxArg);
+    auto *loadOtherType = instrBuilder->CreateLOAD_ARRAY_IMM(OperandType::I64, refArg0, 1);
+    auto *loadOtherArray = instrBuilder->CreateLOAD_ARRAY_IMM(TYPE, refArg1, 1);
+    auto *loadObject = instrBuilder->CreateLOAD_OBJECT(TYPE, refArg0, 1);
+    instrBuilder->PushBackInstruction(
+        bblock,
+        store, loadSame, loadOther, loadUnknown1, loadUnknown2, loadOtherType, loadOtherArray, loadObject,
+        instrBuilder->CreateRETVOID());
+
+    auto *graph = GetGraph();
+    PassManager::Run<AliasAnalysis>(graph);
+
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadSame), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadOther), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadUnknown1), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, loadUnknown1, loadUnknown2), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadOtherType), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadOtherArray), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, loadObject), AliasResult::NO_ALIAS);
+}
+
+TEST_F(AliasAnalysisTest, TestEscapes) {
+    auto *bblock = BuildGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *obj = instrBuilder->CreateNEW_OBJECT(1);
+    auto *loaded = instrBuilder->CreateLOAD_OBJECT(OperandType::REF, refArg0, 0);
+    auto *store = instrBuilder->CreateSTORE_OBJECT(obj, constOne, 0);
+    auto *storeLoaded = instrBuilder->CreateSTORE_OBJECT(loaded, constTwo, 0);
+    auto *ret = instrBuilder->CreateRETVOID();
+    instrBuilder->PushBackInstruction(bblock, obj, loaded, store, storeLoaded, ret);
+
+    auto *graph = GetGraph();
+    PassManager::Run<AliasAnalysis>(graph);
+    // the object is not stored anywhere, so it cannot be loaded
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, storeLoaded), AliasResult::NO_ALIAS);
+
+    // the object may be saved by the callee and loaded then
+    auto *call = instrBuilder->CreateCALL(OperandType::VOID, 1, {obj});
+    bblock->InsertBefore(ret, call);
+    ASSERT_FALSE(graph->IsAnalysisValid(AnalysisFlag::ALIAS_ANALYSIS));
+    PassManager::Run<AliasAnalysis>(graph);
+    ASSERT_EQ(AliasAnalysis::CheckAlias(graph, store, storeLoaded), AliasResult::MAY_ALIAS);
+}
+
+TEST_F(AliasAnalysisTest, TestCachedResults) {
+    auto *bblock = BuildGraph();
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *obj1 = instrBuilder->CreateNEW_OBJECT(1);
+    auto *obj2 = instrBuilder->CreateNEW_OBJECT(1);
+    auto *move = instrBuilder->CreateMOVE(obj1);
+    instrBuilder->PushBackInstruction(bblock, obj1, obj2, move, instrBuilder->CreateRETVOID());
+
+    PassManager::Run<AliasAnalysis>(graph);
+    ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::ALIAS_ANALYSIS));
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, move, obj1), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, move, obj2), AliasResult::NO_ALIAS);
+
+    // the reference gets another base
+    obj1->ReplaceInputInUsers(obj2);
+    ASSERT_FALSE(graph->IsAnalysisValid(AnalysisFlag::ALIAS_ANALYSIS));
+    PassManager::Run<AliasAnalysis>(graph);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, move, obj2), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, move, obj1), AliasResult::NO_ALIAS);
+}
+
+TEST_F(AliasAnalysisTest, TestPhi) {
+    /*
+       A
+       |
+       B
+      / \
+     /   \
+    C     D
+     \   /
+      \ /
+       E
+       |
+       F
+    */
+    auto [graph, bblocks] = BuildCase0();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(TYPE);
+    auto *refArg = instrBuilder->CreateARG(OperandType::REF);
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    instrBuilder->PushBackInstruction(bblocks[0], arg, refArg, constZero);
+
+    auto *obj1 = instrBuilder->CreateNEW_OBJECT(1);
+    auto *obj2 = instrBuilder->CreateNEW_OBJECT(2);
+    instrBuilder->PushBackInstruction(
+        bblocks[1],
+        obj1, obj2,
+        instrBuilder->CreateCMP(TYPE, CondCode::EQ, arg, constZero),
+        instrBuilder->CreateJCMP());
+    auto *obj3 = instrBuilder->CreateNEW_OBJECT(2);
+    instrBuilder->PushBackInstruction(bblocks[2], obj3);
+
+    auto *phiSame = instrBuilder->CreatePHI(OperandType::REF, {obj1, obj1}, {bblocks[2], bblocks[3]});
+    auto *phiTyped = instrBuilder->CreatePHI(OperandType::REF, {obj3, obj2}, {bblocks[2], bblocks[3]});
+    auto *phiMixed = instrBuilder->CreatePHI(OperandType::REF, {obj1, refArg}, {bblocks[2], bblocks[3]});
+    instrBuilder->PushBackInstruction(bblocks[4], phiSame, phiTyped, phiMixed);
+
+    PassManager::Run<AliasAnalysis>(graph);
+
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, phiSame, obj1), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, phiTyped, obj2), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, phiTyped, phiMixed), AliasResult::MAY_ALIAS);
+    // both PHIs reference only objects of different types
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, phiTyped, phiSame), AliasResult::NO_ALIAS);
+    ASSERT_EQ(AliasAnalysis::CheckRefAlias(graph, phiMixed, refArg), AliasResult::MAY_ALIAS);
+}
+}   // namespace ir::tests
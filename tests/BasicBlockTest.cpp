@@ -145,4 +145,44 @@ TEST_F(BasicBlockTest, TestSplitAfterInstruction) {
     ASSERT_EQ(jcmp->GetPrevInstruction(), cmp);
     ASSERT_EQ(jcmp->GetNextInstruction(), nullptr);
 }
+
+TEST_F(BasicBlockTest, TestInstructionsOrder) {
+    auto *bblock = GetGraph()->CreateEmptyBasicBlock();
+    auto opType = OperandType::I32;
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *phi = instrBuilder->CreatePHI(opType);
+    auto *first = instrBuilder->CreateADDI(opType, nullptr, 1);
+    auto *last = instrBuilder->CreateADDI(opType, nullptr, 2);
+    instrBuilder->PushBackInstruction(bblock, first, last, phi);
+
+    // exhaust gaps between instructions to force renumbering
+    constexpr size_t INSERTIONS_COUNT = 64;
+    for (size_t i = 0; i < INSERTIONS_COUNT; ++i) {
+        auto *instr = instrBuilder->CreateADDI(opType, nullptr, i);
+        if (i % 2 == 0) {
+            bblock->InsertBefore(last, instr);
+        } else {
+            bblock->InsertAfter(first, instr);
+        }
+        ASSERT_TRUE(first->Dominates(instr));
+        ASSERT_TRUE(instr->Dominates(last));
+        ASSERT_FALSE(last->Dominates(instr));
+    }
+    auto *forward = instrBuilder->CreateADDI(opType, nullptr, 3);
+    bblock->PushForwardInstruction(forward);
+    ASSERT_EQ(phi->GetNextInstruction(), forward);
+    ASSERT_EQ(forward->GetPrevInstruction(), phi);
+    ASSERT_EQ(bblock->GetSize(), INSERTIONS_COUNT + 4);
+
+    std::vector<InstructionBase *> instrs;
+    for (auto *instr : *bblock) {
+        instrs.push_back(instr);
+    }
+    ASSERT_EQ(instrs.size(), bblock->GetSize());
+    for (size_t i = 0; i < instrs.size(); ++i) {
+        for (size_t j = 0; j < instrs.size(); ++j) {
+            ASSERT_EQ(bblock->IsEarlier(instrs[i], instrs[j]), i <= j);
+        }
+    }
+}
 }   // namespace ir::tests
@@ -0,0 +1,130 @@
+#include "BlockFrequencyAnalysis.h"
+#include "TestGraphSamples.h"
+
+
+namespace ir::tests {
+class BlockFrequencyTest : public TestGraphSamples {
+public:
+    void RunPass() {
+        PassManager::Run<BlockFrequencyAnalysis>(GetGraph());
+        ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::BLOCK_FREQUENCY));
+    }
+
+    std::vector<BasicBlock *> CreateBlocks(size_t count) {
+        std::vector<BasicBlock *> bblocks{GetGraph()->GetFirstBasicBlock()};
+        for (size_t i = 1; i < count; ++i) {
+            bblocks.push_back(GetGraph()->CreateEmptyBasicBlock());
+        }
+        return bblocks;
+    }
+    // Ends the block with a comparison of the arguments, which no heuristic applies to.
+    void AddBranch(BasicBlock *bblock, InstructionBase *lhs, InstructionBase *rhs,
+                   CondCode ccode = CondCode::GE) {
+        auto *instrBuilder = GetInstructionBuilder();
+        instrBuilder->PushBackInstruction(
+            bblock, instrBuilder->CreateCMP(OperandType::I32, ccode, lhs, rhs), instrBuilder->CreateJCMP());
+    }
+
+public:
+    static constexpr double EPS = 1e-6;
+};
+
+TEST_F(BlockFrequencyTest, TestBranchHeuristics) {
+    /*
+       B0
+      /  \
+     B1  B2
+      \  /
+       B3
+    */
+    auto *instrBuilder = GetInstructionBuilder();
+    auto type = OperandType::I32;
+    auto *arg = instrBuilder->CreateARG(type);
+    auto *constZero = instrBuilder->CreateCONST(type, 0);
+    FillFirstBlock(GetGraph(), arg, constZero);
+    auto bblocks = CreateBlocks(4);
+    AddBranch(bblocks[0], arg, constZero, CondCode::EQ);
+    instrBuilder->PushBackInstruction(bblocks[1], instrBuilder->CreateADD(type, arg, constZero));
+    instrBuilder->PushBackInstruction(bblocks[2], instrBuilder->CreateSUB(type, arg, constZero));
+    instrBuilder->PushBackInstruction(bblocks[3], instrBuilder->CreateRETVOID());
+    GetGraph()->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    GetGraph()->ConnectBasicBlocks(bblocks[0], bblocks[2]);
+    GetGraph()->ConnectBasicBlocks(bblocks[1], bblocks[3]);
+    GetGraph()->ConnectBasicBlocks(bblocks[2], bblocks[3]);
+
+    RunPass();
+
+    // comparison for equality with a constant usually fails
+    auto probability = 1.0 - BlockFrequencyAnalysis::OPCODE_PROBABILITY;
+    ASSERT_NEAR(bblocks[0]->GetSuccessorProbability(0), probability, EPS);
+    ASSERT_NEAR(bblocks[0]->GetEdgeProbability(bblocks[2]), 1.0 - probability, EPS);
+    ASSERT_NEAR(bblocks[0]->GetFrequency(), 1.0, EPS);
+    ASSERT_NEAR(bblocks[1]->GetFrequency(), probability, EPS);
+    ASSERT_NEAR(bblocks[2]->GetFrequency(), 1.0 - probability, EPS);
+    ASSERT_NEAR(bblocks[3]->GetFrequency(), 1.0, EPS);
+
+    bblocks[0]->InverseConditionalBranch();
+    ASSERT_NEAR(bblocks[0]->GetSuccessorProbability(0), 1.0 - probability, EPS);
+    ASSERT_NEAR(bblocks[0]->GetEdgeProbability(bblocks[1]), probability, EPS);
+
+    // returning branch is unlikely
+    GetGraph()->DisconnectBasicBlocks(bblocks[2], bblocks[3]);
+    instrBuilder->PushBackInstruction(bblocks[2], instrBuilder->CreateRETVOID());
+    ASSERT_FALSE(GetGraph()->IsAnalysisValid(AnalysisFlag::BLOCK_FREQUENCY));
+    RunPass();
+    ASSERT_NEAR(bblocks[0]->GetEdgeProbability(bblocks[2]),
+                BlockFrequencyAnalysis::OPCODE_PROBABILITY * (1.0 - BlockFrequencyAnalysis::RETURN_PROBABILITY)
+                / (BlockFrequencyAnalysis::OPCODE_PROBABILITY * (1.0 - BlockFrequencyAnalysis::RETURN_PROBABILITY)
+                   + (1.0 - BlockFrequencyAnalysis::OPCODE_PROBABILITY) * BlockFrequencyAnalysis::RETURN_PROBABILITY),
+                EPS);
+}
+
+TEST_F(BlockFrequencyTest, TestNestedLoops) {
+    /*
+         B0
+         |
+    ---->B1---->B5--->B6
+    |    |
+    |    B2<--
+    |   / \   |
+    |  B4  B3--
+    |  |
+    ----
+    */
+    auto *instrBuilder = GetInstructionBuilder();
+    auto type = OperandType::I32;
+    auto *arg0 = instrBuilder->CreateARG(type);
+    auto *arg1 = instrBuilder->CreateARG(type);
+    FillFirstBlock(GetGraph(), arg0, arg1);
+    auto bblocks = CreateBlocks(7);
+    AddBranch(bblocks[1], arg0, arg1);
+    AddBranch(bblocks[2], arg0, arg1);
+    instrBuilder->PushBackInstruction(bblocks[5], instrBuilder->CreateADD(type, arg0, arg1));
+    instrBuilder->PushBackInstruction(bblocks[6], instrBuilder->CreateRETVOID());
+    auto *graph = GetGraph();
+    graph->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[2]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[5]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[4]);
+    graph->ConnectBasicBlocks(bblocks[3], bblocks[2]);
+    graph->ConnectBasicBlocks(bblocks[4], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[5], bblocks[6]);
+
+    RunPass();
+
+    // branches staying in loops are likely
+    auto probability = BlockFrequencyAnalysis::LOOP_BRANCH_PROBABILITY;
+    ASSERT_NEAR(bblocks[1]->GetSuccessorProbability(0), probability, EPS);
+    ASSERT_NEAR(bblocks[2]->GetSuccessorProbability(0), probability, EPS);
+
+    auto iterations = 1.0 / (1.0 - probability);
+    ASSERT_NEAR(bblocks[0]->GetFrequency(), 1.0, EPS);
+    ASSERT_NEAR(bblocks[1]->GetFrequency(), iterations, EPS);
+    ASSERT_NEAR(bblocks[2]->GetFrequency(), iterations * probability * iterations, EPS);
+    ASSERT_NEAR(bblocks[3]->GetFrequency(), iterations * probability * iterations * probability, EPS);
+    ASSERT_NEAR(bblocks[4]->GetFrequency(), iterations * probability, EPS);
+    ASSERT_NEAR(bblocks[5]->GetFrequency(), 1.0, EPS);
+    ASSERT_NEAR(bblocks[6]->GetFrequency(), 1.0, EPS);
+}
+}   // namespace ir::tests
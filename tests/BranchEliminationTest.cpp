@@ -5,6 +5,12 @@
 
 namespace ir::tests {
 class BranchEliminationTest : public TestGraphSamples {
+public:
+    static bool ContainsBlock(const Graph *graph, const BasicBlock *bblock) {
+        bool found = false;
+        graph->ForEachBasicBlock([bblock, &found](const BasicBlock *b) { found |= b == bblock; });
+        return found;
+    }
 };
 
 TEST_F(BranchEliminationTest, TestSingleIf0) {
@@ -45,14 +51,17 @@ TEST_F(BranchEliminationTest, TestSingleIf0) {
         {bblocks[2], bblocks[3]});
     auto *ret = instrBuilder->CreateRET(type, phi);
     instrBuilder->PushBackInstruction(bblocks[4], phi, ret);
+    auto freedInstrs = instrBuilder->GetRecyclingStats().freedCount;
 
     PassManager::Run<BranchElimination>(graph);
 
     VerifyControlAndDataFlowGraphs(graph);
     ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::RPO));
-    ASSERT_EQ(bblocks[3]->GetGraph(), nullptr);
-    ASSERT_EQ(constCmp->GetBasicBlock(), nullptr);
-    ASSERT_EQ(constJcmp->GetBasicBlock(), nullptr);
+    ASSERT_FALSE(ContainsBlock(graph, bblocks[3]));
+    ASSERT_EQ(graph->GetBlocksRecyclingStats().freedCount, 1);
+    // comparison, jump and instruction of the removed block
+    ASSERT_EQ(instrBuilder->GetRecyclingStats().freedCount, freedInstrs + 3);
+    ASSERT_EQ(bblocks[1]->EndsWithConditionalJump(), nullptr);
     ASSERT_EQ(phi->GetBasicBlock(), nullptr);
     ASSERT_EQ(ret->GetInput(0), phiInput1);
 }
@@ -87,9 +96,69 @@ TEST_F(BranchEliminationTest, TestSingleIf1) {
 
     VerifyControlAndDataFlowGraphs(graph);
     ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::RPO));
-    ASSERT_EQ(eliminatedBlock->GetGraph(), nullptr);
-    ASSERT_EQ(constCmp->GetBasicBlock(), nullptr);
-    ASSERT_EQ(constJcmp->GetBasicBlock(), nullptr);
+    ASSERT_FALSE(ContainsBlock(graph, eliminatedBlock));
+    ASSERT_EQ(graph->GetBlocksRecyclingStats().freedCount, 1);
+    ASSERT_EQ(bblocks[1]->EndsWithConditionalJump(), nullptr);
+    ASSERT_EQ(phi->GetInputsCount(), 2);
+}
+TEST_F(BranchEliminationTest, TestDominatedCondition) {
+    /*
+       A
+       |
+       B
+      / \
+     C   \
+    / \   |
+   D   E  |
+    \ /   |
+     F<---
+    */
+    auto type = OperandType::I32;
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(type);
+    auto *constTen = instrBuilder->CreateCONST(type, 10);
+    auto *constTwenty = instrBuilder->CreateCONST(type, 20);
+    FillFirstBlock(graph, arg, constTen, constTwenty);
+    std::array<BasicBlock *, 6> bblocks{graph->GetFirstBasicBlock()};
+    for (size_t i = 1; i < bblocks.size(); ++i) {
+        bblocks[i] = graph->CreateEmptyBasicBlock();
+    }
+    graph->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[2]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[5]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[4]);
+    graph->ConnectBasicBlocks(bblocks[3], bblocks[5]);
+    graph->ConnectBasicBlocks(bblocks[4], bblocks[5]);
+
+    // if (arg < 10) { if (arg + 1 < 20) {...} else {...} }
+    instrBuilder->PushBackInstruction(
+        bblocks[1],
+        instrBuilder->CreateCMP(type, CondCode::LT, arg, constTen),
+        instrBuilder->CreateJCMP());
+    auto *add = instrBuilder->CreateADDI(type, arg, 1);
+    instrBuilder->PushBackInstruction(
+        bblocks[2],
+        add,
+        instrBuilder->CreateCMP(type, CondCode::LT, add, constTwenty),
+        instrBuilder->CreateJCMP());
+    auto *phiInput1 = instrBuilder->CreateADDI(type, arg, 1);
+    instrBuilder->PushBackInstruction(bblocks[3], phiInput1);
+    auto *phiInput2 = instrBuilder->CreateADDI(type, arg, 2);
+    instrBuilder->PushBackInstruction(bblocks[4], phiInput2);
+    auto *phi = instrBuilder->CreatePHI(
+        type,
+        {phiInput1, phiInput2, arg},
+        {bblocks[3], bblocks[4], bblocks[1]});
+    instrBuilder->PushBackInstruction(bblocks[5], phi, instrBuilder->CreateRET(type, phi));
+
+    PassManager::Run<BranchElimination>(graph);
+
+    VerifyControlAndDataFlowGraphs(graph);
+    ASSERT_NE(bblocks[1]->EndsWithConditionalJump(), nullptr);
+    ASSERT_FALSE(ContainsBlock(graph, bblocks[4]));
+    ASSERT_EQ(bblocks[2]->EndsWithConditionalJump(), nullptr);
     ASSERT_EQ(phi->GetInputsCount(), 2);
 }
 }   // namespace ir::tests
@@ -327,6 +327,57 @@ static void DifferentCheckNoEliminations(InputsInstruction *originalCheck)
     CompilerTestBase::compareInstructions(originalInstructions, bblock);
 }
 
+TEST_F(CheckEliminationTest, TestChecksProvenByRanges) {
+    /*
+        B0
+        |
+        B1
+        |
+        B2<--
+       / \  |
+      B4  B3-
+    */
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    auto *constLength = instrBuilder->CreateCONST(TYPE, 16);
+    FillFirstBlock(graph, constZero, constLength);
+    std::array<BasicBlock *, 5> bblocks{graph->GetFirstBasicBlock()};
+    for (size_t i = 1; i < bblocks.size(); ++i) {
+        bblocks[i] = graph->CreateEmptyBasicBlock();
+    }
+    graph->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[2]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[4]);
+    graph->ConnectBasicBlocks(bblocks[3], bblocks[2]);
+
+    // for (i = 0; i < 16; ++i) { array[i] = array[i + 1]; }
+    auto *array = instrBuilder->CreateNEW_ARRAY_IMM(16, 1);
+    instrBuilder->PushBackInstruction(bblocks[1], array);
+
+    auto *phi = instrBuilder->CreatePHI(TYPE);
+    auto *cmp = instrBuilder->CreateCMP(TYPE, CondCode::LT, phi, constLength);
+    instrBuilder->PushBackInstruction(bblocks[2], phi, cmp, instrBuilder->CreateJCMP());
+    auto *update = instrBuilder->CreateADDI(TYPE, phi, 1);
+    auto *notProven = instrBuilder->CreateBOUNDS_CHECK(array, update);
+    instrBuilder->PushBackInstruction(
+        bblocks[3],
+        instrBuilder->CreateBOUNDS_CHECK(array, phi),
+        instrBuilder->CreateNEGATIVE_CHECK(phi),
+        update,
+        instrBuilder->CreateZERO_CHECK(update),
+        notProven);
+    instrBuilder->PushBackInstruction(bblocks[4], instrBuilder->CreateRETVOID());
+    phi->AddPhiInput(constZero, bblocks[1]);
+    phi->AddPhiInput(update, bblocks[3]);
+
+    auto countBefore = graph->CountInstructions();
+    PassManager::Run<CheckElimination>(graph);
+    ASSERT_EQ(countBefore, graph->CountInstructions() + 3);
+    ASSERT_EQ(notProven->GetBasicBlock(), bblocks[3]);
+}
+
 #define TEST_DIFFERENT_INPUT(OPCODE_NAME)                                       \
 TEST_F(CheckEliminationTest, TestDifferentCheckNoEliminations##OPCODE_NAME) {   \
     DifferentCheckNoEliminations(FillGraphWithChecks(Opcode::OPCODE_NAME));     \
@@ -0,0 +1,186 @@
+#include "DomTree.h"
+#include "TestGraphSamples.h"
+#include "Traversals.h"
+
+
+namespace ir::tests {
+class CompilerTest : public TestGraphSamples {
+};
+
+TEST_F(CompilerTest, TestDeleteFunctionGraph) {
+    auto usedBefore = compiler.GetUsedMemory();
+    auto *first = compiler.CreateNewGraph();
+    auto *second = compiler.CreateNewGraph();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    auto firstId = first->GetId();
+    auto secondId = second->GetId();
+    ASSERT_EQ(compiler.GetFunction(firstId), first);
+    ASSERT_EQ(compiler.GetFunction(secondId), second);
+    ASSERT_GT(compiler.GetUsedMemory(), usedBefore);
+
+    // functions' IDs must not change after deletion
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(firstId));
+    ASSERT_EQ(compiler.GetFunction(firstId), nullptr);
+    ASSERT_EQ(compiler.GetFunction(secondId), second);
+    ASSERT_FALSE(compiler.DeleteFunctionGraph(firstId));
+
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(secondId));
+    ASSERT_EQ(compiler.GetUsedMemory(), usedBefore);
+}
+
+TEST_F(CompilerTest, TestRecreateFunctionGraph) {
+    auto *graph = BuildCase3().first;
+    auto id = graph->GetId();
+    auto reservedBefore = compiler.GetReservedMemory();
+
+    auto *newGraph = compiler.RecreateFunctionGraph(id);
+    ASSERT_NE(newGraph, nullptr);
+    ASSERT_EQ(newGraph->GetId(), id);
+    ASSERT_EQ(compiler.GetFunction(id), newGraph);
+    ASSERT_EQ(newGraph->GetBasicBlocksCount(), 0);
+    ASSERT_EQ(newGraph->GetInstructionBuilder()->CreateCONST(OperandType::I32, 1)->GetId(), 0);
+
+    // released memory must be reused instead of being requested again
+    this->graph = newGraph;
+    BuildCase3();
+    ASSERT_LE(compiler.GetReservedMemory(), reservedBefore);
+}
+
+TEST_F(CompilerTest, TestDeleteCopiedGraph) {
+    auto *original = BuildCase3().first;
+    auto *copy = compiler.CopyGraph(original, original->GetInstructionBuilder());
+    ASSERT_NE(copy, nullptr);
+    auto copyId = copy->GetId();
+    ASSERT_NE(copyId, original->GetId());
+    ASSERT_EQ(compiler.GetFunction(copyId), copy);
+
+    // the copy is allocated in the original function's memory
+    auto *other = compiler.CreateNewGraph();
+    auto *otherCopy = compiler.CopyGraph(original, other->GetInstructionBuilder());
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(original->GetId()));
+    ASSERT_EQ(compiler.GetFunction(copyId), nullptr);
+    ASSERT_EQ(compiler.GetFunction(otherCopy->GetId()), otherCopy);
+
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(other->GetId()));
+    ASSERT_EQ(compiler.GetFunction(otherCopy->GetId()), nullptr);
+
+    // builders of other compilers are not accepted
+    InstructionBuilder foreignBuilder(std::pmr::get_default_resource());
+    ASSERT_EQ(compiler.CreateNewGraph(&foreignBuilder), nullptr);
+    graph = compiler.CreateNewGraph();
+}
+
+TEST_F(CompilerTest, TestMemoryBudget) {
+    BuildCase3();
+    compiler.GetOptions().SetMemoryBudget(compiler.GetUsedMemory());
+    ASSERT_EQ(compiler.CreateNewGraph(), nullptr);
+    ASSERT_EQ(compiler.CopyGraph(GetGraph(), GetInstructionBuilder()), nullptr);
+
+    compiler.GetOptions().SetMemoryBudget(0);
+    auto *newGraph = compiler.CreateNewGraph();
+    ASSERT_NE(newGraph, nullptr);
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(newGraph->GetId()));
+}
+
+TEST_F(CompilerTest, TestMemoryTracking) {
+    auto *graph = BuildCase3().first;
+    auto stats = graph->GetMemoryStats();
+    ASSERT_GT(stats.allocationsCount, 0);
+    ASSERT_GT(stats.allocatedBytes, 0);
+    ASSERT_GE(stats.peakBytes, stats.currentBytes);
+    ASSERT_EQ(graph->GetPassMemoryStats<RPO>(), nullptr);
+
+    PassManager::Run<RPO>(graph);
+    PassManager::Run<DomTreeBuilder>(graph);
+    const auto *rpoStats = graph->GetPassMemoryStats<RPO>();
+    const auto *domTreeStats = graph->GetPassMemoryStats<DomTreeBuilder>();
+    ASSERT_NE(rpoStats, nullptr);
+    ASSERT_NE(domTreeStats, nullptr);
+    ASSERT_GT(rpoStats->allocationsCount, 0);
+    ASSERT_GT(domTreeStats->allocationsCount, 0);
+    ASSERT_GE(rpoStats->peakBytes, rpoStats->currentBytes);
+    ASSERT_GE(graph->GetMemoryStats().allocatedBytes,
+              stats.allocatedBytes + rpoStats->allocatedBytes + domTreeStats->allocatedBytes);
+
+    // statistics are accumulated over multiple runs
+    auto rpoScratchBytes = rpoStats->scratchBytes;
+    ASSERT_GT(rpoScratchBytes, 0);
+    PassManager::SetInvalid<AnalysisFlag::RPO>(graph);
+    PassManager::Run<RPO>(graph);
+    ASSERT_EQ(graph->GetPassMemoryStats<RPO>()->scratchBytes, 2 * rpoScratchBytes);
+}
+
+TEST_F(CompilerTest, TestOptimize) {
+    auto *graph = BuildCase3().first;
+    auto id = graph->GetId();
+    auto blocksCount = graph->GetBasicBlocksCount();
+    ASSERT_EQ(compiler.Optimize(graph), graph);
+
+    compiler.AddOptimizationPass<RPO>();
+    auto *optimized = compiler.Optimize(graph);
+    ASSERT_NE(optimized, graph);
+    ASSERT_EQ(optimized->GetId(), id);
+    ASSERT_EQ(compiler.GetFunction(id), optimized);
+    ASSERT_EQ(optimized->GetBasicBlocksCount(), blocksCount);
+    ASSERT_TRUE(optimized->IsAnalysisValid(AnalysisFlag::RPO));
+    ASSERT_NE(optimized->GetPassMemoryStats<RPO>(), nullptr);
+    VerifyControlAndDataFlowGraphs(optimized);
+
+    // slot of the replaced copy must be reused
+    optimized = compiler.Optimize(optimized);
+    ASSERT_EQ(compiler.GetFunction(id), optimized);
+    auto *next = compiler.CreateNewGraph();
+    ASSERT_EQ(next->GetId(), id + 1);
+    ASSERT_TRUE(compiler.DeleteFunctionGraph(next->GetId()));
+    this->graph = optimized;
+}
+
+TEST_F(CompilerTest, TestOptimizeAbort) {
+    auto *graph = BuildCase3().first;
+    auto id = graph->GetId();
+    compiler.AddOptimizationPass<RPO>();
+    compiler.GetOptions().SetMaxGraphMemory(1);
+
+    auto usedBefore = compiler.GetUsedMemory();
+    ASSERT_EQ(compiler.Optimize(graph), graph);
+    ASSERT_EQ(compiler.GetFunction(id), graph);
+    ASSERT_FALSE(graph->IsAnalysisValid(AnalysisFlag::RPO));
+    ASSERT_EQ(compiler.GetUsedMemory(), usedBefore);
+    ASSERT_EQ(compiler.CreateNewGraph()->GetId(), id + 1);
+}
+
+TEST_F(CompilerTest, TestOptimizeAbortOnBudget) {
+    auto *graph = BuildCase3().first;
+    auto id = graph->GetId();
+    compiler.AddOptimizationPass<RPO>();
+    // the copy can be created, but its arena exceeds the budget
+    auto usedBefore = compiler.GetUsedMemory();
+    compiler.GetOptions().SetMemoryBudget(usedBefore + 1);
+
+    ASSERT_EQ(compiler.Optimize(graph), graph);
+    ASSERT_EQ(compiler.GetFunction(id), graph);
+    ASSERT_EQ(compiler.GetUsedMemory(), usedBefore);
+    compiler.GetOptions().SetMemoryBudget(0);
+}
+
+TEST_F(CompilerTest, TestPassScratchMemory) {
+    auto *graph = BuildCase3().first;
+    PassManager::Run<RPO>(graph);
+    auto allocatedBefore = graph->GetMemoryStats().allocatedBytes;
+
+    // dominator tree builder's temporary data must not be kept in graph's memory
+    PassManager::Run<DomTreeBuilder>(graph);
+    const auto *domTreeStats = graph->GetPassMemoryStats<DomTreeBuilder>();
+    ASSERT_NE(domTreeStats, nullptr);
+    ASSERT_GT(domTreeStats->scratchBytes, 0);
+    auto allocatedByDomTree = graph->GetMemoryStats().allocatedBytes - allocatedBefore;
+    ASSERT_LT(allocatedByDomTree, domTreeStats->scratchBytes);
+
+    // repeated analyses reuse graph's memory
+    allocatedBefore = graph->GetMemoryStats().allocatedBytes;
+    PassManager::SetInvalid<AnalysisFlag::RPO>(graph);
+    PassManager::Run<RPO>(graph);
+    ASSERT_EQ(graph->GetMemoryStats().allocatedBytes, allocatedBefore);
+}
+}   // namespace ir::tests
@@ -32,8 +32,15 @@ TEST_F(DCETest, TestDCE1) {
     PassManager::Run<DCEPass>(GetGraph());
 
     CompilerTestBase::compareInstructions({v0, v2, ret}, bblock);
-    ASSERT_EQ(v1->GetBasicBlock(), nullptr);
     ASSERT_EQ(v0->GetNextInstruction(), v2);
+
+    // memory of the removed instruction must be reused
+    const auto &stats = instrBuilder->GetRecyclingStats();
+    ASSERT_EQ(stats.freedCount, 1);
+    auto reusedCount = stats.reusedCount;
+    auto *newInstr = instrBuilder->CreateMULI(type, arg, 3);
+    ASSERT_EQ(static_cast<InstructionBase *>(newInstr), v1);
+    ASSERT_EQ(stats.reusedCount, reusedCount + 1);
 }
 
 TEST_F(DCETest, TestDCE2) {
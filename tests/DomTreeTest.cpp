@@ -1,4 +1,5 @@
 #include "DomTree.h"
+#include "GraphChecker.h"
 #include "TestGraphSamples.h"
 
 
@@ -10,6 +11,34 @@ public:
         PassManager::Run<DomTreeBuilder>(GetGraph());
         ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE));
     }
+
+    // Compares the incrementally updated tree with the rebuilt one.
+    void CheckDomTree() {
+        ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE));
+        utils::ScratchScope scratch;
+        DomTreeBuilder builder(GetGraph());
+        auto expected = builder.Build(scratch.GetArena());
+        GetGraph()->ForEachBasicBlock([&expected](BasicBlock *bblock) {
+            const auto &info = expected[bblock->GetId()];
+            ASSERT_EQ(bblock->GetDominator(), info.GetDominator());
+            auto expectedDominated = info.GetDominatedBlocks();
+            auto actualDominated = bblock->GetDominatedBlocks();
+            std::ranges::sort(expectedDominated);
+            std::ranges::sort(actualDominated);
+            ASSERT_EQ(actualDominated, expectedDominated);
+        });
+        // updates renumber only the changed subtrees, so dominance checks do not renumber the tree
+        ASSERT_TRUE(GetGraph()->IsDomTreeNumbered());
+        GetGraph()->ForEachBasicBlock([this](BasicBlock *dominator) {
+            GetGraph()->ForEachBasicBlock([dominator](BasicBlock *bblock) {
+                bool expected = false;
+                for (auto *dom = bblock; dom != nullptr; dom = dom->GetDominator()) {
+                    expected |= dom == dominator;
+                }
+                ASSERT_EQ(dominator->Dominates(bblock), expected);
+            });
+        });
+    }
 };
 
 static void checkDominatedBlocks(BasicBlock *bblock,
@@ -103,4 +132,167 @@ TEST_F(DomTreeTest, TestBuilding3) {
         checkDominatedBlocks(bblocks[i], expectedDominatedBlocks[i]);
     }
 }
+
+TEST_F(DomTreeTest, TestAlgorithmsAgree) {
+    std::vector<CFGInfoPair (TestGraphSamples::*)()> cases{
+        &TestGraphSamples::BuildCase0, &TestGraphSamples::BuildCase1, &TestGraphSamples::BuildCase2,
+        &TestGraphSamples::BuildCase3, &TestGraphSamples::BuildCase4, &TestGraphSamples::BuildCase5};
+    for (auto buildCase : cases) {
+        graph = compiler.CreateNewGraph();
+        auto bblocks = (this->*buildCase)().second;
+
+        utils::ScratchScope scratch;
+        DomTreeBuilder lengauerTarjan(graph, DominatorsAlgorithm::LENGAUER_TARJAN);
+        auto expected = lengauerTarjan.Build(scratch.GetArena());
+        DomTreeBuilder semiNCA(graph, DominatorsAlgorithm::SEMI_NCA);
+        auto actual = semiNCA.Build(scratch.GetArena());
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (auto *bblock : bblocks) {
+            auto id = bblock->GetId();
+            ASSERT_EQ(actual[id].GetDominator(), expected[id].GetDominator());
+            auto expectedDominated = expected[id].GetDominatedBlocks();
+            auto actualDominated = actual[id].GetDominatedBlocks();
+            std::ranges::sort(expectedDominated);
+            std::ranges::sort(actualDominated);
+            ASSERT_EQ(actualDominated, expectedDominated);
+        }
+    }
+}
+
+TEST_F(DomTreeTest, TestAlgorithmOption) {
+    auto bblocks = BuildCase1().second;
+    compiler.GetOptions().SetDomTreeAlgorithm(DominatorsAlgorithm::LENGAUER_TARJAN);
+
+    RunPass();
+
+    ASSERT_EQ(bblocks[3]->GetDominator(), bblocks[1]);
+    ASSERT_EQ(bblocks[6]->GetDominator(), bblocks[5]);
+}
+
+TEST_F(DomTreeTest, TestDominance) {
+    auto bblocks = BuildCase2().second;
+    RunPass();
+
+    for (auto *dominator : bblocks) {
+        for (auto *bblock : bblocks) {
+            bool expected = false;
+            for (auto *dom = bblock; dom != nullptr; dom = dom->GetDominator()) {
+                expected |= dom == dominator;
+            }
+            ASSERT_EQ(dominator->Dominates(bblock), expected);
+        }
+    }
+    ASSERT_TRUE(bblocks[1]->Dominates(bblocks[10]));
+    ASSERT_FALSE(bblocks[9]->Dominates(bblocks[10]));
+    ASSERT_FALSE(bblocks[10]->Dominates(bblocks[1]));
+
+    // the tree is updated on CFG modifications
+    auto *newBlock = GetGraph()->CreateEmptyBasicBlock();
+    GetGraph()->ConnectBasicBlocks(bblocks[10], newBlock);
+    ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE));
+    ASSERT_EQ(newBlock->GetDominator(), bblocks[10]);
+    ASSERT_TRUE(bblocks[1]->Dominates(newBlock));
+    ASSERT_FALSE(bblocks[9]->Dominates(newBlock));
+
+    // dominance is still answered after the tree became invalid
+    PassManager::SetInvalid<AnalysisFlag::DOM_TREE>(GetGraph());
+    ASSERT_TRUE(bblocks[1]->Dominates(bblocks[10]));
+    ASSERT_FALSE(bblocks[9]->Dominates(bblocks[10]));
+}
+
+TEST_F(DomTreeTest, TestIncrementalUpdates) {
+    std::vector<CFGInfoPair (TestGraphSamples::*)()> cases{
+        &TestGraphSamples::BuildCase0, &TestGraphSamples::BuildCase1, &TestGraphSamples::BuildCase2,
+        &TestGraphSamples::BuildCase3, &TestGraphSamples::BuildCase4, &TestGraphSamples::BuildCase5};
+    for (auto buildCase : cases) {
+        graph = compiler.CreateNewGraph();
+        auto bblocks = (this->*buildCase)().second;
+        RunPass();
+
+        // insert and delete each possible edge
+        for (auto *from : bblocks) {
+            for (auto *to : bblocks) {
+                if (from->GetSuccessors().size() >= 2 || from->IsLastInGraph()
+                        || to->IsFirstInGraph() || to->GetFirstPhiInstruction() != nullptr
+                        || to->HasPredecessor(from)) {
+                    continue;
+                }
+                GetGraph()->ConnectBasicBlocks(from, to);
+                CheckDomTree();
+                GetGraph()->DisconnectBasicBlocks(from, to);
+                CheckDomTree();
+            }
+        }
+
+        // split each edge
+        for (auto *pred : bblocks) {
+            auto succs = pred->GetSuccessors();
+            for (auto *succ : succs) {
+                auto *newBlock = GetGraph()->CreateEmptyBasicBlock();
+                GetGraph()->InsertBetween(newBlock, pred, succ);
+                CheckDomTree();
+                ASSERT_EQ(newBlock->GetDominator(), pred);
+            }
+        }
+    }
+}
+
+TEST_F(DomTreeTest, TestIncrementalUpdatesUnreachable) {
+    auto bblocks = BuildCase1().second;
+    RunPass();
+
+    // blocks become reachable together with their successors
+    auto *newBlock1 = GetGraph()->CreateEmptyBasicBlock();
+    auto *newBlock2 = GetGraph()->CreateEmptyBasicBlock();
+    GetGraph()->ConnectBasicBlocks(newBlock1, newBlock2);
+    GetGraph()->ConnectBasicBlocks(newBlock2, bblocks[4]);
+    ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE));
+    ASSERT_EQ(newBlock1->GetDominator(), nullptr);
+    ASSERT_FALSE(bblocks[0]->Dominates(newBlock2));
+    GetGraph()->ConnectBasicBlocks(bblocks[2], newBlock1);
+    CheckDomTree();
+    ASSERT_EQ(newBlock2->GetDominator(), newBlock1);
+    ASSERT_EQ(bblocks[4]->GetDominator(), bblocks[1]);
+
+    // blocks reachable only through the deleted edge are removed from the tree
+    GetGraph()->DisconnectBasicBlocks(bblocks[2], newBlock1);
+    ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::DOM_TREE));
+    ASSERT_EQ(newBlock1->GetDominator(), nullptr);
+    ASSERT_EQ(newBlock2->GetDominator(), nullptr);
+    ASSERT_FALSE(bblocks[1]->Dominates(newBlock2));
+    GetGraph()->UnlinkBasicBlock(newBlock1);
+    GetGraph()->UnlinkBasicBlock(newBlock2);
+    CheckDomTree();
+}
+
+TEST_F(DomTreeTest, TestRepeatedSplits) {
+    auto bblocks = BuildCase0().second;
+    RunPass();
+
+    // intervals of the split edge's ends narrow until the whole tree has to be renumbered
+    auto *pred = bblocks[0];
+    auto *succ = bblocks[1];
+    for (size_t i = 0; i < 100; ++i) {
+        auto *newBlock = GetGraph()->CreateEmptyBasicBlock();
+        GetGraph()->InsertBetween(newBlock, pred, succ);
+        ASSERT_TRUE(pred->Dominates(newBlock));
+        ASSERT_TRUE(newBlock->Dominates(succ));
+        ASSERT_FALSE(succ->Dominates(newBlock));
+        ASSERT_TRUE(bblocks[0]->Dominates(bblocks.back()));
+        pred = newBlock;
+    }
+    CheckDomTree();
+}
+
+TEST_F(DomTreeTest, TestVerifyOption) {
+    BuildCase2();
+    RunPass();
+    compiler.GetOptions().SetVerifyDomTree(true);
+
+    auto *bblock = GetGraph()->FindBasicBlock(3);
+    auto *newBlock = GetGraph()->CreateEmptyBasicBlock();
+    GetGraph()->InsertBetween(newBlock, bblock->GetPredecessors()[0], bblock);
+    ASSERT_TRUE(PassManager::Run<GraphChecker>(GetGraph()));
+}
 }   // namespace ir::tests
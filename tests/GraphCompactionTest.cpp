@@ -0,0 +1,104 @@
+#include <algorithm>
+#include "BranchElimination.h"
+#include "DCE.h"
+#include "GraphCompaction.h"
+#include "LinearOrdering.h"
+#include "TestGraphSamples.h"
+#include "Traversals.h"
+
+
+namespace ir::tests {
+class GraphCompactionTest : public TestGraphSamples {
+public:
+    static std::vector<BasicBlock *> GetBlocks(Graph *graph) {
+        std::vector<BasicBlock *> bblocks;
+        graph->ForEachBasicBlock([&bblocks](BasicBlock *bblock) { bblocks.push_back(bblock); });
+        return bblocks;
+    }
+
+    static void VerifyDenseIds(Graph *graph) {
+        ASSERT_EQ(graph->GetMaximumBlockId() + 1, graph->GetBasicBlocksCount());
+        std::vector<bool> instrIds(graph->CountInstructions(), false);
+        BasicBlock::IdType expectedBlockId = 0;
+        graph->ForEachBasicBlock([&instrIds, &expectedBlockId](BasicBlock *bblock) {
+            ASSERT_EQ(bblock->GetId(), expectedBlockId++);
+            for (auto *instr : *bblock) {
+                ASSERT_LT(instr->GetId(), instrIds.size());
+                ASSERT_FALSE(instrIds[instr->GetId()]);
+                instrIds[instr->GetId()] = true;
+            }
+        });
+        ASSERT_TRUE(std::ranges::all_of(instrIds, [](bool set) { return set; }));
+    }
+};
+
+TEST_F(GraphCompactionTest, TestRPOOrder) {
+    auto *graph = std::get<0>(FillCase1());
+    PassManager::Run<BranchElimination>(graph);
+    PassManager::Run<DCEPass>(graph);
+    ASSERT_GT(graph->GetMaximumBlockId() + 1, graph->GetBasicBlocksCount());
+    auto rpo = RPO::DoRPO(graph, graph->GetMemoryResource());
+
+    ASSERT_TRUE(PassManager::Run<GraphCompaction>(graph));
+
+    VerifyDenseIds(graph);
+    for (size_t i = 0; i < rpo.size(); ++i) {
+        ASSERT_EQ(rpo[i]->GetId(), i);
+    }
+    ASSERT_EQ(graph->GetFirstBasicBlock()->GetId(), 0);
+    ASSERT_EQ(graph->GetInstructionBuilder()->GetNextId(), graph->CountInstructions());
+    VerifyControlAndDataFlowGraphs(graph);
+}
+
+TEST_F(GraphCompactionTest, TestUnreachableBlocks) {
+    auto *graph = std::get<0>(FillCase1());
+    PassManager::Run<LinearOrdering>(graph);
+    ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::LINEAR_ORDERING));
+    auto *unreachable = graph->CreateEmptyBasicBlock();
+
+    ASSERT_TRUE(PassManager::Run<GraphCompaction>(graph));
+
+    VerifyDenseIds(graph);
+    ASSERT_EQ(unreachable->GetId(), graph->GetBasicBlocksCount() - 1);
+    // blocks are not in the linear order anymore
+    ASSERT_FALSE(graph->IsAnalysisValid(AnalysisFlag::LINEAR_ORDERING));
+    ASSERT_FALSE(graph->IsAnalysisValid(AnalysisFlag::LOOP_ANALYSIS));
+}
+
+TEST_F(GraphCompactionTest, TestKeepOrder) {
+    auto *graph = std::get<0>(FillCase1());
+    PassManager::Run<BranchElimination>(graph);
+    auto bblocks = GetBlocks(graph);
+    ASSERT_LT(bblocks.size(), graph->GetMaximumBlockId() + 1);
+
+    ASSERT_TRUE(PassManager::Run<GraphCompaction>(graph, CompactionOrder::KEEP));
+
+    VerifyDenseIds(graph);
+    ASSERT_EQ(GetBlocks(graph), bblocks);
+    VerifyControlAndDataFlowGraphs(graph);
+}
+
+TEST_F(GraphCompactionTest, TestRelocateGraph) {
+    auto *graph = std::get<0>(FillCase1());
+    PassManager::Run<BranchElimination>(graph);
+    PassManager::Run<DCEPass>(graph);
+    auto id = graph->GetId();
+    auto blocksCount = graph->GetBasicBlocksCount();
+    auto instrsCount = graph->CountInstructions();
+
+    auto *relocated = compiler.RelocateGraph(graph);
+    ASSERT_NE(relocated, graph);
+    this->graph = relocated;
+    ASSERT_EQ(relocated->GetId(), id);
+    ASSERT_EQ(compiler.GetFunction(id), relocated);
+    ASSERT_EQ(relocated->GetBasicBlocksCount(), blocksCount);
+    ASSERT_EQ(relocated->CountInstructions(), instrsCount);
+    ASSERT_EQ(relocated->GetInstructionBuilder()->GetNextId(), instrsCount);
+    ASSERT_EQ(relocated->GetMaximumBlockId() + 1, blocksCount);
+    VerifyControlAndDataFlowGraphs(relocated);
+
+    // graphs sharing memory of another function are not relocated
+    auto *nested = compiler.CreateNewGraph(relocated->GetInstructionBuilder());
+    ASSERT_EQ(compiler.RelocateGraph(nested), nested);
+}
+}   // namespace ir::tests
@@ -1,3 +1,4 @@
+#include <memory>
 #include <ranges>
 #include "TestGraphSamples.h"
 #include "Traversals.h"
@@ -119,4 +120,114 @@ TEST_F(GraphTest, TestGraphCopy) {
         }
     }
 }
+
+TEST_F(GraphTest, TestMarkers) {
+    auto *graph = BuildCase3().first;
+    auto maxMarkers = utils::to_underlying(MarkersConstants::MAX_MARKERS);
+    ASSERT_EQ(graph->GetFreeMarkersCount(), maxMarkers);
+    {
+        // nested passes may hold more than four markers at once
+        std::vector<std::unique_ptr<MarkerHolder>> holders;
+        for (size_t i = 0; i < maxMarkers; ++i) {
+            holders.push_back(std::make_unique<MarkerHolder>(graph));
+        }
+        ASSERT_EQ(graph->GetFreeMarkersCount(), 0);
+
+        auto *first = graph->GetFirstBasicBlock();
+        for (auto &holder : holders) {
+            ASSERT_TRUE(first->SetMarker(*holder));
+            ASSERT_FALSE(first->SetMarker(*holder));
+        }
+        for (auto &holder : holders) {
+            ASSERT_TRUE(first->IsMarkerSet(*holder));
+        }
+
+        // resetting a marker unsets it for all objects, others are kept
+        holders.front()->Reset();
+        ASSERT_FALSE(first->IsMarkerSet(*holders.front()));
+        ASSERT_TRUE(first->IsMarkerSet(*holders.back()));
+    }
+    ASSERT_EQ(graph->GetFreeMarkersCount(), maxMarkers);
+
+    // markers set before releasing the slot are not visible for the following markers
+    MarkerHolder marker(graph);
+    graph->ForEachBasicBlock([&marker](BasicBlock *bblock) {
+        ASSERT_FALSE(bblock->IsMarkerSet(marker));
+    });
+}
+
+TEST_F(GraphTest, TestConstantPool) {
+    auto opType = OperandType::I32;
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(opType);
+    auto *constOne = instrBuilder->CreateCONST(opType, 1);
+    // constants of the first block are added into the pool when the block is set
+    auto *firstBlock = FillFirstBlock(graph, arg, constOne);
+    auto &pool = graph->GetConstantPool();
+    ASSERT_EQ(pool.Size(), 1);
+    ASSERT_EQ(pool.Find(opType, 1), constOne);
+    ASSERT_EQ(pool.Find(OperandType::I64, 1), nullptr);
+
+    ASSERT_EQ(graph->FindOrCreateConstant(opType, 1), constOne);
+    auto *constTwo = graph->FindOrCreateConstant(opType, 2);
+    ASSERT_NE(constTwo, nullptr);
+    ASSERT_EQ(constTwo->GetBasicBlock(), firstBlock);
+    ASSERT_EQ(graph->FindOrCreateConstant(opType, 2), constTwo);
+    auto *wideOne = graph->FindOrCreateConstant(OperandType::I64, 1);
+    ASSERT_NE(wideOne, constOne);
+    ASSERT_EQ(pool.Size(), 3);
+    ASSERT_EQ(firstBlock->GetSize(), 4);
+
+    // values are compared within their types' sizes
+    auto *minusOne = graph->FindOrCreateConstant(opType, static_cast<uint64_t>(-1));
+    ASSERT_EQ(graph->FindOrCreateConstant(opType, 0xFFFFFFFF), minusOne);
+    ASSERT_NE(graph->FindOrCreateConstant(OperandType::I64, 0xFFFFFFFF), minusOne);
+    ASSERT_EQ(pool.Size(), 5);
+    firstBlock->UnlinkInstruction(minusOne);
+    ASSERT_EQ(pool.Find(opType, 0xFFFFFFFF), nullptr);
+
+    // unlinked constants are removed from the pool
+    firstBlock->UnlinkInstruction(constTwo);
+    ASSERT_EQ(pool.Find(opType, 2), nullptr);
+    auto *newTwo = graph->FindOrCreateConstant(opType, 2);
+    ASSERT_NE(newTwo, constTwo);
+    ASSERT_EQ(firstBlock->GetLastInstruction(), newTwo);
+}
+
+TEST_F(GraphTest, TestBlocksRecycling) {
+    auto opType = OperandType::I32;
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(opType);
+    auto *firstBlock = FillFirstBlock(graph, arg);
+
+    auto *bblock = graph->CreateEmptyBasicBlock();
+    graph->ConnectBasicBlocks(firstBlock, bblock);
+    auto *addi = instrBuilder->CreateADDI(opType, arg, 1);
+    auto *muli = instrBuilder->CreateMULI(opType, addi, 2);
+    instrBuilder->PushBackInstruction(bblock, addi, muli);
+
+    graph->DisconnectBasicBlocks(firstBlock, bblock);
+    graph->UnlinkBasicBlockRaw(bblock);
+    muli->RemoveUserFromInputs();
+    addi->RemoveUserFromInputs();
+    ASSERT_FALSE(arg->HasUsers());
+    graph->DestroyBasicBlock(bblock);
+
+    const auto &blocksStats = graph->GetBlocksRecyclingStats();
+    ASSERT_EQ(blocksStats.freedCount, 1);
+    ASSERT_EQ(instrBuilder->GetRecyclingStats().freedCount, 2);
+
+    // both the block and its instructions are reused
+    auto *newBlock = graph->CreateEmptyBasicBlock();
+    ASSERT_EQ(newBlock, bblock);
+    ASSERT_EQ(newBlock->GetGraph(), graph);
+    ASSERT_TRUE(newBlock->IsEmpty());
+    ASSERT_EQ(blocksStats.reusedCount, 1);
+    auto *newInstr = instrBuilder->CreateSUBI(opType, arg, 1);
+    ASSERT_TRUE(static_cast<InstructionBase *>(newInstr) == addi
+                || static_cast<InstructionBase *>(newInstr) == muli);
+    ASSERT_EQ(instrBuilder->GetRecyclingStats().reusedCount, 1);
+}
 }   // namespace ir::tests
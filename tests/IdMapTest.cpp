@@ -0,0 +1,63 @@
+#include "CompilerTestBase.h"
+#include "IdMap.h"
+
+
+namespace ir::tests {
+class IdMapTest : public CompilerTestBase {
+};
+
+TEST_F(IdMapTest, TestIdSet) {
+    IdSet set(GetGraph()->GetMemoryResource());
+    ASSERT_TRUE(set.IsEmpty());
+    ASSERT_FALSE(set.Contains(0));
+
+    ASSERT_TRUE(set.Insert(5));
+    ASSERT_FALSE(set.Insert(5));
+    ASSERT_TRUE(set.Insert(0));
+    ASSERT_TRUE(set.Insert(1000));
+    ASSERT_EQ(set.Size(), 3);
+    ASSERT_TRUE(set.Contains(0));
+    ASSERT_TRUE(set.Contains(5));
+    ASSERT_TRUE(set.Contains(1000));
+    ASSERT_FALSE(set.Contains(4));
+    ASSERT_FALSE(set.Contains(100000));
+
+    ASSERT_TRUE(set.Erase(5));
+    ASSERT_FALSE(set.Erase(5));
+    ASSERT_FALSE(set.Contains(5));
+    ASSERT_EQ(set.Size(), 2);
+
+    set.Clear();
+    ASSERT_TRUE(set.IsEmpty());
+    ASSERT_FALSE(set.Contains(1000));
+}
+
+TEST_F(IdMapTest, TestIdMap) {
+    auto *arg = GetInstructionBuilder()->CreateARG(OperandType::I32);
+    auto *cnst = GetInstructionBuilder()->CreateCONST(OperandType::I32, 1);
+
+    IdMap<InstructionBase *> map(GetGraph()->GetMemoryResource(), 1);
+    ASSERT_TRUE(map.Insert(arg->GetId(), cnst));
+    ASSERT_TRUE(map.Insert(cnst->GetId(), arg));
+    ASSERT_FALSE(map.Insert(cnst->GetId(), cnst));
+    ASSERT_EQ(map.Size(), 2);
+    ASSERT_EQ(map.At(arg->GetId()), cnst);
+    ASSERT_EQ(map.At(cnst->GetId()), arg);
+
+    ASSERT_EQ(map.Find(100), nullptr);
+    auto *found = map.Find(arg->GetId());
+    ASSERT_NE(found, nullptr);
+    *found = arg;
+    ASSERT_EQ(map.At(arg->GetId()), arg);
+
+    ASSERT_TRUE(map.Erase(arg->GetId()));
+    ASSERT_FALSE(map.Contains(arg->GetId()));
+    ASSERT_EQ(map.Size(), 1);
+
+    // values are kept after growing
+    map.Reserve(10000);
+    ASSERT_EQ(map.At(cnst->GetId()), arg);
+    ASSERT_TRUE(map.Insert(9999, nullptr));
+    ASSERT_TRUE(map.Contains(9999));
+}
+}   // namespace ir::tests
@@ -0,0 +1,119 @@
+#include "InductionVariablesAnalysis.h"
+#include "TestGraphSamples.h"
+
+
+namespace ir::tests {
+class InductionVariablesTest : public TestGraphSamples {
+public:
+    static void RunPass(Graph *graph) {
+        PassManager::Run<InductionVariablesAnalysis>(graph);
+    }
+
+public:
+    static constexpr auto TYPE = OperandType::I32;
+};
+
+TEST_F(InductionVariablesTest, TestVariables) {
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    auto *constTen = instrBuilder->CreateCONST(TYPE, 10);
+    auto *constThree = instrBuilder->CreateCONST(TYPE, 3);
+    FillFirstBlock(GetGraph(), constZero, constTen, constThree);
+    auto [bblocks, phi] = BuildLoop(TYPE, constZero, constTen, CondCode::LT);
+
+    // for (i = 0; i < 10; i += 2) { j = 4 * i; k = j + 3; m = 3 - k; }
+    auto *mul = instrBuilder->CreateMULI(TYPE, phi, 4);
+    auto *add = instrBuilder->CreateADD(TYPE, mul, constThree);
+    auto *sub = instrBuilder->CreateSUB(TYPE, constThree, add);
+    auto *update = instrBuilder->CreateADDI(TYPE, phi, 2);
+    instrBuilder->PushBackInstruction(bblocks[3], mul, add, sub);
+    instrBuilder->PushBackInstruction(bblocks[4], update);
+    phi->AddPhiInput(update, bblocks[4]);
+
+    RunPass(GetGraph());
+
+    auto *loop = bblocks[2]->GetLoop();
+    ASSERT_EQ(loop->GetInductionVariables().size(), 5);
+    const auto *basic = loop->FindInductionVariable(phi);
+    ASSERT_NE(basic, nullptr);
+    ASSERT_TRUE(basic->IsBasic());
+    ASSERT_EQ(basic->init, constZero);
+    ASSERT_EQ(basic->step, 2);
+
+    auto checkDerived = [loop, phi](InstructionBase *instr, int64_t scale, int64_t offset) {
+        const auto *var = loop->FindInductionVariable(instr);
+        ASSERT_NE(var, nullptr);
+        ASSERT_FALSE(var->IsBasic());
+        ASSERT_EQ(var->basic, phi);
+        ASSERT_EQ(var->scale, scale);
+        ASSERT_EQ(var->offset, offset);
+        ASSERT_EQ(var->GetIncrement(), scale * 2);
+    };
+    checkDerived(mul, 4, 0);
+    checkDerived(add, 4, 3);
+    checkDerived(sub, -4, 0);
+    checkDerived(update, 1, 2);
+
+    const auto *test = loop->GetExitTest();
+    ASSERT_NE(test, nullptr);
+    ASSERT_EQ(test->var, phi);
+    ASSERT_EQ(test->bound, constTen);
+    ASSERT_EQ(test->ccode, CondCode::LT);
+    // the header is executed for 0, 2, 4, 6, 8 and 10
+    ASSERT_EQ(loop->GetTripCount(), 6);
+}
+
+TEST_F(InductionVariablesTest, TestUnknownTripCount) {
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(TYPE);
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    FillFirstBlock(GetGraph(), arg, constZero);
+    auto [bblocks, phi] = BuildLoop(TYPE, arg, constZero, CondCode::LE, true);
+
+    // for (i = n; !(i <= 0); i -= 3) { x = i * i; }
+    auto *mul = instrBuilder->CreateMUL(TYPE, phi, phi);
+    auto *update = instrBuilder->CreateSUBI(TYPE, phi, 3);
+    instrBuilder->PushBackInstruction(bblocks[3], mul);
+    instrBuilder->PushBackInstruction(bblocks[4], update);
+    phi->AddPhiInput(update, bblocks[4]);
+
+    RunPass(GetGraph());
+
+    auto *loop = bblocks[2]->GetLoop();
+    const auto *basic = loop->FindInductionVariable(phi);
+    ASSERT_NE(basic, nullptr);
+    ASSERT_EQ(basic->init, arg);
+    ASSERT_EQ(basic->step, -3);
+    // the product is not linear
+    ASSERT_EQ(loop->FindInductionVariable(mul), nullptr);
+
+    const auto *test = loop->GetExitTest();
+    ASSERT_NE(test, nullptr);
+    ASSERT_EQ(test->var, phi);
+    ASSERT_EQ(test->bound, constZero);
+    ASSERT_EQ(test->ccode, CondCode::GT);
+    ASSERT_EQ(loop->GetTripCount(), 0);
+}
+
+TEST_F(InductionVariablesTest, TestComputeTripCount) {
+    auto compute = InductionVariablesAnalysis::ComputeTripCount;
+    ASSERT_EQ(compute(0, 1, CondCode::LT, 10, TYPE), 11);
+    ASSERT_EQ(compute(0, 2, CondCode::LE, 9, TYPE), 6);
+    ASSERT_EQ(compute(0, 3, CondCode::LT, 9, TYPE), 4);
+    ASSERT_EQ(compute(10, -3, CondCode::GT, 0, TYPE), 5);
+    ASSERT_EQ(compute(10, -3, CondCode::NE, 1, TYPE), 4);
+    ASSERT_EQ(compute(7, 1, CondCode::EQ, 7, TYPE), 2);
+    // the first test fails
+    ASSERT_EQ(compute(5, 1, CondCode::LT, 0, TYPE), 1);
+    // the variable steps over the bound
+    ASSERT_EQ(compute(10, -3, CondCode::NE, 0, TYPE), 0);
+    // the variable moves away from the bound
+    ASSERT_EQ(compute(0, -1, CondCode::LT, 10, TYPE), 0);
+    ASSERT_EQ(compute(10, 1, CondCode::NE, 5, TYPE), 0);
+    ASSERT_EQ(compute(5, -1, CondCode::NE, 10, TYPE), 0);
+    // the variable wraps before failing the test
+    ASSERT_EQ(compute(100, 10, CondCode::LT, 127, OperandType::I8), 0);
+    ASSERT_EQ(compute(100, 10, CondCode::LT, 120, OperandType::I8), 3);
+    ASSERT_EQ(compute(0, 1, CondCode::LT, 200, OperandType::I8), 0);
+}
+}   // namespace ir::tests
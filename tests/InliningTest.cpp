@@ -234,6 +234,18 @@ TEST_F(InliningTest, TestInlineMultipleReturns) {
 
     ASSERT_EQ(callerGraph->GetBasicBlocksCount(),
               2 * callerBlocksCount + calleeBlocksCount);
+
+    // callee's zero constant must be merged into the caller's one
+    const auto &pool = callerGraph->GetConstantPool();
+    ASSERT_EQ(pool.Size(), 2);
+    size_t constantsCount = 0;
+    for (auto *instr : *callerGraph->GetFirstBasicBlock()) {
+        if (instr->IsConst()) {
+            ++constantsCount;
+            ASSERT_EQ(pool.Find(instr->GetType(), instr->AsConst()->GetValue()), instr);
+        }
+    }
+    ASSERT_EQ(constantsCount, pool.Size());
 }
 
 TEST_F(InliningTest, TestInlineVoidReturn) {
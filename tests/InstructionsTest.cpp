@@ -374,4 +374,137 @@ TEST_F(InstructionsTest, TestBoundsCheck) {
     ASSERT_EQ(instr->GetInput(0), arr);
     ASSERT_EQ(instr->GetInput(1), idx);
 }
+
+TEST_F(InstructionsTest, TestUsers) {
+    auto opType = OperandType::I32;
+    auto *arg1 = GetInstructionBuilder()->CreateARG(opType);
+    auto *arg2 = GetInstructionBuilder()->CreateARG(opType);
+    auto *add = GetInstructionBuilder()->CreateADD(opType, arg1, arg1);
+    auto *cmp = GetInstructionBuilder()->CreateCMP(opType, CondCode::EQ, arg1, arg2);
+    ASSERT_EQ(arg1->UsersCount(), 3);
+    ASSERT_EQ(arg2->UsersCount(), 1);
+    std::vector<InstructionBase *> users(arg1->GetUsers().begin(), arg1->GetUsers().end());
+    ASSERT_EQ(users, (std::vector<InstructionBase *>{add, add, cmp}));
+
+    // assigning to an input moves the use
+    add->SetInput(arg2, 1);
+    ASSERT_EQ(arg1->UsersCount(), 2);
+    ASSERT_EQ(arg2->UsersCount(), 2);
+    cmp->Inverse();
+    ASSERT_EQ(cmp->GetInput(0), arg2);
+    ASSERT_EQ(cmp->GetInput(1), arg1);
+    ASSERT_EQ(arg1->UsersCount(), 2);
+    ASSERT_EQ(arg2->UsersCount(), 2);
+
+    // copies of inputs are detached
+    Input copy = add->GetInput(0);
+    ASSERT_FALSE(copy.IsAttached());
+    ASSERT_EQ(add->GetInput(0).GetUser(), add);
+    ASSERT_EQ(arg1->UsersCount(), 2);
+
+    arg1->ReplaceInputInUsers(arg2);
+    ASSERT_EQ(arg1->UsersCount(), 0);
+    ASSERT_EQ(arg2->UsersCount(), 4);
+    ASSERT_EQ(add->GetInput(0), arg2);
+    ASSERT_EQ(cmp->GetInput(1), arg2);
+
+    add->RemoveUserFromInputs();
+    ASSERT_EQ(arg2->UsersCount(), 2);
+    ASSERT_EQ(add->GetInput(0), arg2);
+    for (auto *user : arg2->GetUsers()) {
+        ASSERT_EQ(user, cmp);
+    }
+}
+
+TEST_F(InstructionsTest, TestPhiUsers) {
+    auto opType = OperandType::I32;
+    auto *arg = GetInstructionBuilder()->CreateARG(opType);
+    auto *phi = GetInstructionBuilder()->CreatePHI(opType);
+    std::vector<BasicBlock *> bblocks;
+    for (size_t i = 0; i < 10; ++i) {
+        bblocks.push_back(GetGraph()->CreateEmptyBasicBlock());
+        // inputs must stay linked after reallocation
+        phi->AddPhiInput(arg, bblocks.back());
+        ASSERT_EQ(arg->UsersCount(), i + 1);
+    }
+    for (auto *user : arg->GetUsers()) {
+        ASSERT_EQ(user, phi);
+    }
+
+    phi->RemovePhiInput(bblocks[0]);
+    phi->RemovePhiInput(bblocks.back());
+    ASSERT_EQ(phi->GetInputsCount(), bblocks.size() - 2);
+    ASSERT_EQ(arg->UsersCount(), bblocks.size() - 2);
+}
+
+static_assert(!std::is_polymorphic_v<InstructionBase>);
+static_assert(!std::is_polymorphic_v<BinaryRegInstruction>);
+static_assert(!std::is_polymorphic_v<PhiInstruction>);
+static_assert(getInstructionTraits(Opcode::ADD).inputsCount == 2);
+static_assert(getInstructionTraits(Opcode::ADD).SatisfiesProperty(InstrProp::COMMUTABLE));
+static_assert(!getInstructionTraits(Opcode::SUB).SatisfiesProperty(InstrProp::COMMUTABLE));
+static_assert(getInstructionTraits(Opcode::CALL).HasVariableInputs());
+static_assert(getInstructionTraits(Opcode::CONST).inputsCount == 0);
+
+TEST_F(InstructionsTest, TestStaticDispatch) {
+    auto opType = OperandType::I32;
+    auto *arg = GetInstructionBuilder()->CreateARG(opType);
+    auto *cnst = GetInstructionBuilder()->CreateCONST(opType, 7);
+    InstructionBase *instr = GetInstructionBuilder()->CreateADD(opType, arg, cnst);
+    ASSERT_TRUE(instr->SatisfiesProperty(InstrProp::COMMUTABLE));
+    ASSERT_TRUE(instr->SatisfiesProperty(InstrProp::ARITH));
+    ASSERT_FALSE(instr->SatisfiesProperty(InstrProp::MEM));
+
+    auto inputsCount = VisitInstruction(instr, []<typename T>(T *typed) -> size_t {
+        if constexpr (std::is_same_v<T, BinaryRegInstruction>) {
+            return typed->GetInputsCount();
+        }
+        return 0;
+    });
+    ASSERT_EQ(inputsCount, 2);
+    auto constValue = VisitInstruction(static_cast<const InstructionBase *>(cnst),
+                                       []<typename T>(T *typed) -> uint64_t {
+        if constexpr (std::is_same_v<T, const ConstantInstruction>) {
+            return typed->GetValue();
+        }
+        return 0;
+    });
+    ASSERT_EQ(constValue, 7);
+
+    auto *bblock = GetGraph()->CreateEmptyBasicBlock();
+    auto *copy = instr->Copy(bblock);
+    ASSERT_NE(copy, instr);
+    ASSERT_EQ(copy->GetOpcode(), Opcode::ADD);
+    ASSERT_EQ(copy->GetProperties(), instr->GetProperties());
+    ASSERT_EQ(copy->GetBasicBlock(), nullptr);
+}
+
+TEST_F(InstructionsTest, TestInputsIteration) {
+    auto opType = OperandType::I32;
+    auto *arg1 = GetInstructionBuilder()->CreateARG(opType);
+    auto *arg2 = GetInstructionBuilder()->CreateARG(opType);
+    auto *add = GetInstructionBuilder()->CreateADD(opType, arg1, arg2);
+    auto *call = GetInstructionBuilder()->CreateCALL(opType, INVALID_FUNCTION_ID, {arg1, arg2});
+    call->AddInput(add);
+
+    for (auto *instr : std::array<InputsInstruction *, 2>{add, call}) {
+        auto inputs = instr->GetInputs();
+        ASSERT_EQ(inputs.size(), instr->GetInputsCount());
+        size_t idx = 0;
+        instr->ForEachInput([instr, &idx](Input &input) {
+            ASSERT_EQ(&input, &instr->GetInput(idx));
+            ++idx;
+        });
+        ASSERT_EQ(idx, inputs.size());
+    }
+    ASSERT_EQ(call->GetInputs().back(), add);
+
+    // inputs are modified in-place
+    call->ForEachInput([arg2](Input &input) {
+        input = arg2;
+    });
+    ASSERT_EQ(arg1->UsersCount(), 1);
+    ASSERT_EQ(arg2->UsersCount(), 4);
+    ASSERT_EQ(add->UsersCount(), 0);
+}
 }   // namespace ir::tests
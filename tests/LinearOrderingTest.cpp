@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "LinearOrdering.h"
+#include "Loop.h"
 #include <numeric>
 #include "TestGraphSamples.h"
 
@@ -186,4 +187,69 @@ TEST_F(LinearOrderingTest, TestAnalysis4) {
             bblocks[5],
             bblocks[9]});
 }
+
+TEST_F(LinearOrderingTest, TestManyLoops) {
+    // sequence of loops with inner loops and early exits into the last block
+    constexpr size_t LOOPS_COUNT = 20;
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto type = OperandType::I32;
+    auto *arg = instrBuilder->CreateARG(type);
+    auto *prevBlock = FillFirstBlock(graph, arg);
+    auto *lastBlock = graph->CreateEmptyBasicBlock(true);
+    instrBuilder->PushBackInstruction(lastBlock, instrBuilder->CreateRET(type, arg));
+    auto createCondBlock = [graph, instrBuilder, type, arg]() {
+        auto *bblock = graph->CreateEmptyBasicBlock();
+        instrBuilder->PushBackInstruction(
+            bblock, instrBuilder->CreateCMP(type, CondCode::EQ, arg, arg), instrBuilder->CreateJCMP());
+        return bblock;
+    };
+
+    for (size_t i = 0; i < LOOPS_COUNT; ++i) {
+        auto *header = createCondBlock();
+        auto *innerHeader = createCondBlock();
+        auto *innerBody = createCondBlock();
+        auto *latch = createCondBlock();
+        auto *exit = graph->CreateEmptyBasicBlock();
+        graph->ConnectBasicBlocks(prevBlock, header);
+        graph->ConnectBasicBlocks(header, innerHeader);
+        graph->ConnectBasicBlocks(header, exit);
+        graph->ConnectBasicBlocks(innerHeader, innerBody);
+        graph->ConnectBasicBlocks(innerHeader, latch);
+        graph->ConnectBasicBlocks(innerBody, innerHeader);
+        graph->ConnectBasicBlocks(innerBody, lastBlock);
+        graph->ConnectBasicBlocks(latch, header);
+        graph->ConnectBasicBlocks(latch, lastBlock);
+        prevBlock = exit;
+    }
+    graph->ConnectBasicBlocks(prevBlock, lastBlock);
+
+    PassManager::Run<LinearOrdering>(graph);
+
+    // predecessors come before blocks, except for back edges' sources
+    graph->ForEachBasicBlock([](const BasicBlock *bblock) {
+        for (const auto *pred : bblock->GetPredecessors()) {
+            if (!bblock->IsLoopHeader() || !bblock->Dominates(pred)) {
+                ASSERT_LT(pred->GetId(), bblock->GetId());
+            }
+        }
+    });
+    // blocks of loops are placed contiguously
+    graph->ForEachBasicBlock([](const BasicBlock *bblock) {
+        if (!bblock->IsLoopHeader()) {
+            return;
+        }
+        const auto *loop = bblock->GetLoop();
+        auto *graph = bblock->GetGraph();
+        size_t loopBlocksCount = 0;
+        auto end = bblock->GetId();
+        graph->ForEachBasicBlock([loop, &loopBlocksCount, &end](const BasicBlock *other) {
+            if (other->GetLoop() == loop || other->GetLoop()->IsIn(loop)) {
+                ++loopBlocksCount;
+                end = std::max(end, other->GetId());
+            }
+        });
+        ASSERT_EQ(end - bblock->GetId() + 1, loopBlocksCount);
+    });
+}
 }   // namespace ir::tests
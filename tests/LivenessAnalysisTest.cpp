@@ -1,4 +1,6 @@
 #include "LivenessAnalyzer.h"
+#include <random>
+#include <set>
 #include "TestGraphSamples.h"
 
 
@@ -84,4 +86,131 @@ TEST_F(LivenessAnalysisTest, TestAnalysis5) {
 
     checkLinearOrder(std::move(linearOrder), graph->GetLiveIntervals());
 }
+
+TEST_F(LivenessAnalysisTest, TestAddRange) {
+    auto *mem = GetGraph()->GetMemoryResource();
+    LiveInterval interval(0, nullptr, mem);
+    interval.AddRange(30, 32);
+    interval.AddRange(20, 24);
+    interval.AddRange(10, 12);
+    interval.AddRange(8, 10);
+    ASSERT_EQ(interval, LiveInterval({{30, 32}, {20, 24}, {8, 12}}, nullptr, mem));
+
+    // range of a loop covering some of the existing ranges
+    interval.AddRange(11, 30);
+    ASSERT_EQ(interval, LiveInterval({{8, 32}}, nullptr, mem));
+    interval.AddRange(40, 42);
+    interval.AddRange(34, 36);
+    ASSERT_EQ(interval, LiveInterval({{40, 42}, {34, 36}, {8, 32}}, nullptr, mem));
+}
+
+TEST_F(LivenessAnalysisTest, TestIntervalQueries) {
+    auto *mem = GetGraph()->GetMemoryResource();
+    LiveInterval lhs({{30, 40}, {10, 20}, {2, 6}}, nullptr, mem);
+    LiveInterval rhs({{36, 38}, {20, 30}, {4, 8}}, nullptr, mem);
+
+    ASSERT_TRUE(lhs.Covers(2));
+    ASSERT_TRUE(lhs.Covers(19));
+    ASSERT_FALSE(lhs.Covers(20));
+    ASSERT_FALSE(lhs.Covers(8));
+    ASSERT_FALSE(lhs.Covers(40));
+    ASSERT_EQ(lhs.GetRangesCount(), 3);
+
+    ASSERT_TRUE(lhs.Intersects(rhs));
+    ASSERT_EQ(lhs.NextIntersection(rhs), 4);
+    ASSERT_EQ(rhs.NextIntersection(lhs, 6), 36);
+    ASSERT_EQ(lhs.NextIntersection(rhs, 38), LiveRange::INVALID_RANGE);
+
+    LiveInterval disjoint({{20, 30}, {6, 10}}, nullptr, mem);
+    ASSERT_FALSE(lhs.Intersects(disjoint));
+}
+
+TEST_F(LivenessAnalysisTest, TestUsePositions) {
+    auto [graph, bblocks, expectedLinearOrder] = FillCase4();
+    PassManager::Run<LivenessAnalyzer>(graph);
+
+    // the constant is an input of PHI in B1 and is used in B1 and B2
+    const auto *constOne = graph->GetLiveIntervals()[0];
+    std::vector<UsePosition> expected{{8, false}, {10, true}, {18, true}};
+    ASSERT_TRUE(std::ranges::equal(constOne->GetUsePositions(), expected));
+    ASSERT_EQ(constOne->NextUsePosition(0), 8);
+    ASSERT_EQ(constOne->NextRegisterUsePosition(0), 10);
+    ASSERT_EQ(constOne->NextRegisterUsePosition(11), 18);
+    ASSERT_EQ(constOne->NextUsePosition(19), LiveRange::INVALID_RANGE);
+}
+
+static std::set<size_t> toSet(const LiveSet &liveSet) {
+    std::set<size_t> res;
+    liveSet.ForEach([&res](size_t number) { res.insert(number); });
+    return res;
+}
+
+TEST_F(LivenessAnalysisTest, TestLiveSet) {
+    auto *mem = GetGraph()->GetMemoryResource();
+    LiveSet sparse(mem);
+    sparse.Add(3);
+    sparse.Add(100);
+    sparse.Add(3);
+    ASSERT_FALSE(sparse.IsDense());
+    ASSERT_EQ(sparse.Size(), 2);
+    ASSERT_TRUE(sparse.Contains(100));
+    ASSERT_FALSE(sparse.Contains(4));
+
+    LiveSet dense(mem);
+    for (size_t i = 0; i <= LiveSet::SPARSE_LIMIT; ++i) {
+        dense.Add(i * 7);
+    }
+    ASSERT_TRUE(dense.IsDense());
+    ASSERT_EQ(dense.Size(), LiveSet::SPARSE_LIMIT + 1);
+    ASSERT_TRUE(dense.Remove(7));
+    ASSERT_FALSE(dense.Remove(7));
+    ASSERT_FALSE(dense.Contains(7));
+    ASSERT_FALSE(dense.Contains(100000));
+
+    dense.Union(sparse);
+    ASSERT_TRUE(dense.Contains(3));
+    ASSERT_TRUE(dense.Contains(100));
+    sparse.Union(dense);
+    ASSERT_TRUE(sparse.IsDense());
+    ASSERT_EQ(toSet(sparse), toSet(dense));
+
+    dense.Difference(sparse);
+    ASSERT_TRUE(dense.IsEmpty());
+}
+
+TEST_F(LivenessAnalysisTest, TestLiveSetRandom) {
+    auto *mem = GetGraph()->GetMemoryResource();
+    std::mt19937 gen(42);
+    for (size_t universe : {8, 64, 1000}) {
+        std::uniform_int_distribution<size_t> dist(0, universe - 1);
+        for (size_t count : {2, 20, 200}) {
+            LiveSet lhs(mem);
+            LiveSet rhs(mem);
+            std::set<size_t> expectedLhs;
+            std::set<size_t> expectedRhs;
+            for (size_t i = 0; i < count; ++i) {
+                auto number = dist(gen);
+                lhs.Add(number);
+                expectedLhs.insert(number);
+                number = dist(gen);
+                rhs.Add(number);
+                expectedRhs.insert(number);
+            }
+            ASSERT_EQ(toSet(lhs), expectedLhs);
+
+            lhs.Union(rhs);
+            expectedLhs.insert(expectedRhs.begin(), expectedRhs.end());
+            ASSERT_EQ(toSet(lhs), expectedLhs);
+            ASSERT_EQ(lhs.Size(), expectedLhs.size());
+
+            rhs.Remove(*expectedRhs.begin());
+            expectedRhs.erase(expectedRhs.begin());
+            lhs.Difference(rhs);
+            for (auto number : expectedRhs) {
+                expectedLhs.erase(number);
+            }
+            ASSERT_EQ(toSet(lhs), expectedLhs);
+        }
+    }
+}
 }   // namespace ir::tests
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include "DomTree.h"
 #include "LoopAnalyzer.h"
+#include "LoopCanonicalizer.h"
 #include "TestGraphSamples.h"
 
 
@@ -11,6 +13,12 @@ public:
         PassManager::Run<LoopAnalyzer>(GetGraph());
         ASSERT_TRUE(GetGraph()->IsAnalysisValid(AnalysisFlag::LOOP_ANALYSIS));
     }
+
+    static std::vector<BasicBlock *> Sorted(const std::pmr::vector<BasicBlock *> &bblocks) {
+        std::vector<BasicBlock *> result(bblocks.begin(), bblocks.end());
+        std::ranges::sort(result, [](auto *lhs, auto *rhs) { return lhs->GetId() < rhs->GetId(); });
+        return result;
+    }
 };
 
 TEST_F(LoopAnalysisTest, TestLoops1) {
@@ -239,4 +247,124 @@ TEST_F(LoopAnalysisTest, TestLoops6) {
     ASSERT_EQ(loop->GetBasicBlocks().size(), 5);
     ASSERT_FALSE(loop->IsIrreducible());
 }
+
+TEST_F(LoopAnalysisTest, TestLoopsInfo) {
+    auto [graph, bblocks] = BuildCase5();
+
+    RunPass();
+
+    auto *rootLoop = graph->GetLoopTree();
+    ASSERT_EQ(rootLoop->GetDepth(), 0);
+    auto *outerLoop = rootLoop->GetInnerLoops()[0];
+    ASSERT_EQ(outerLoop->GetDepth(), 1);
+    // the first block cannot be a preheader
+    ASSERT_EQ(outerLoop->GetPreHeader(), nullptr);
+    ASSERT_EQ(outerLoop->GetLatch(), bblocks[8]);
+    ASSERT_EQ(Sorted(outerLoop->GetExitingBlocks()), (std::vector{bblocks[3], bblocks[8]}));
+    ASSERT_EQ(Sorted(outerLoop->GetExitBlocks()), (std::vector{bblocks[5], bblocks[9]}));
+
+    auto *innerLoop = outerLoop->GetInnerLoops()[0];
+    ASSERT_EQ(innerLoop->GetDepth(), 2);
+    ASSERT_EQ(innerLoop->GetPreHeader(), bblocks[1]);
+    ASSERT_EQ(innerLoop->GetLatch(), bblocks[7]);
+    ASSERT_EQ(Sorted(innerLoop->GetExitingBlocks()), (std::vector{bblocks[3], bblocks[7]}));
+    ASSERT_EQ(Sorted(innerLoop->GetExitBlocks()), (std::vector{bblocks[5], bblocks[8]}));
+}
+
+TEST_F(LoopAnalysisTest, TestCanonicalization) {
+    /*
+         B0
+         |
+         B1
+        / |
+       B2 |
+        \ |
+         B3<---
+         |  | |
+         B4-- |
+         |    |
+         B5----
+         |
+         B6
+    */
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto type = OperandType::I32;
+    auto *arg0 = instrBuilder->CreateARG(type);
+    auto *arg1 = instrBuilder->CreateARG(type);
+    std::vector<BasicBlock *> bblocks{FillFirstBlock(graph, arg0, arg1)};
+    for (size_t i = 1; i < 7; ++i) {
+        bblocks.push_back(graph->CreateEmptyBasicBlock());
+    }
+    graph->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[2]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[3], bblocks[4]);
+    graph->ConnectBasicBlocks(bblocks[4], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[4], bblocks[5]);
+    graph->ConnectBasicBlocks(bblocks[5], bblocks[3]);
+    graph->ConnectBasicBlocks(bblocks[5], bblocks[6]);
+
+    auto *phi = instrBuilder->CreatePHI(type);
+    auto *add = instrBuilder->CreateADD(type, phi, arg1);
+    instrBuilder->PushBackInstruction(bblocks[3], phi);
+    instrBuilder->PushBackInstruction(bblocks[4], add);
+    phi->AddPhiInput(arg0, bblocks[1]);
+    phi->AddPhiInput(arg1, bblocks[2]);
+    phi->AddPhiInput(add, bblocks[4]);
+    phi->AddPhiInput(add, bblocks[5]);
+    instrBuilder->PushBackInstruction(bblocks[6], instrBuilder->CreateRET(type, phi));
+
+    PassManager::Run<DomTreeBuilder>(graph);
+    PassManager::Run<LoopCanonicalizer>(graph);
+    ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::LOOP_ANALYSIS));
+    ASSERT_TRUE(graph->IsAnalysisValid(AnalysisFlag::DOM_TREE));
+
+    auto *loop = bblocks[3]->GetLoop();
+    ASSERT_EQ(loop->GetHeader(), bblocks[3]);
+    ASSERT_EQ(loop->GetDepth(), 1);
+    ASSERT_EQ(loop->GetExitingBlocks(), std::pmr::vector<BasicBlock *>{bblocks[5]});
+    ASSERT_EQ(loop->GetExitBlocks(), std::pmr::vector<BasicBlock *>{bblocks[6]});
+
+    auto *preHeader = loop->GetPreHeader();
+    ASSERT_NE(preHeader, nullptr);
+    ASSERT_EQ(preHeader->GetLoop(), graph->GetLoopTree());
+    ASSERT_EQ(Sorted(preHeader->GetPredecessors()), (std::vector{bblocks[1], bblocks[2]}));
+    ASSERT_EQ(preHeader->GetSuccessors(), std::pmr::vector<BasicBlock *>{bblocks[3]});
+    // different inputs from the entering blocks are merged into a new PHI
+    auto *preHeaderPhi = preHeader->GetFirstPhiInstruction();
+    ASSERT_NE(preHeaderPhi, nullptr);
+    ASSERT_EQ(preHeaderPhi->ResolveInput(bblocks[1]).GetInstruction(), arg0);
+    ASSERT_EQ(preHeaderPhi->ResolveInput(bblocks[2]).GetInstruction(), arg1);
+
+    auto *latch = loop->GetLatch();
+    ASSERT_NE(latch, nullptr);
+    ASSERT_EQ(latch->GetLoop(), loop);
+    ASSERT_EQ(Sorted(latch->GetPredecessors()), (std::vector{bblocks[4], bblocks[5]}));
+    // the same inputs from the back edges need no PHI
+    ASSERT_EQ(latch->GetFirstPhiInstruction(), nullptr);
+
+    ASSERT_EQ(phi->GetInputsCount(), 2);
+    ASSERT_EQ(phi->ResolveInput(preHeader).GetInstruction(), preHeaderPhi);
+    ASSERT_EQ(phi->ResolveInput(latch).GetInstruction(), add);
+
+    // incrementally updated dominators are the same as the rebuilt ones
+    std::vector<BasicBlock *> dominators;
+    graph->ForEachBasicBlock([&dominators](BasicBlock *bblock) { dominators.push_back(bblock->GetDominator()); });
+    ASSERT_EQ(bblocks[3]->GetDominator(), preHeader);
+    ASSERT_EQ(preHeader->GetDominator(), bblocks[1]);
+    ASSERT_EQ(latch->GetDominator(), bblocks[4]);
+    PassManager::SetInvalid<AnalysisFlag::DOM_TREE>(graph);
+    PassManager::Run<DomTreeBuilder>(graph);
+    size_t idx = 0;
+    graph->ForEachBasicBlock([&dominators, &idx](BasicBlock *bblock) {
+        ASSERT_EQ(bblock->GetDominator(), dominators[idx++]);
+    });
+
+    // canonical loops are not changed
+    auto blocksCount = graph->GetBasicBlocksCount();
+    PassManager::Run<LoopCanonicalizer>(graph);
+    ASSERT_EQ(graph->GetBasicBlocksCount(), blocksCount);
+}
 }   // namespace ir::tests
@@ -136,20 +136,24 @@ static void CheckReplacementWithConstant(
     BinaryImmInstruction *userInstr,
     BinaryImmInstruction::Type expectedValue)
 {
-    auto *firstBlock = bblock->GetGraph()->GetFirstBasicBlock();
+    auto *graph = bblock->GetGraph();
+    auto *firstBlock = graph->GetFirstBasicBlock();
     ASSERT(firstBlock);
-    ASSERT_EQ(firstBlock->GetSize(), firstBlockPrevSize + 1);
     ASSERT_EQ(bblock->GetSize(), bblockPrevSize - 1);
 
     if (bblockPrevSize == 2) {
         ASSERT_EQ(bblock->GetFirstInstruction(), userInstr);
     }
     ASSERT_EQ(bblock->GetLastInstruction(), userInstr);
-    auto *newInstr = firstBlock->GetLastInstruction();
+    auto *newInstr = userInstr->GetInput(0).GetInstruction();
     ASSERT_NE(newInstr, nullptr);
     ASSERT_TRUE(newInstr->IsConst());
-    ASSERT_EQ(userInstr->GetInput(0), newInstr);
+    ASSERT_EQ(newInstr->GetBasicBlock(), firstBlock);
     ASSERT_EQ(newInstr->AsConst()->GetValue(), expectedValue);
+
+    // equal constants are shared
+    ASSERT_EQ(graph->GetConstantPool().Find(newInstr->GetType(), expectedValue), newInstr);
+    ASSERT_LE(firstBlock->GetSize(), firstBlockPrevSize + 1);
 }
 
 TEST_F(PeepholesTest, TestANDFolding) {
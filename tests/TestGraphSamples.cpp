@@ -222,6 +222,42 @@ TestGraphSamples::CFGInfoPair TestGraphSamples::BuildCase5() {
     return {graph, bblocks};
 }
 
+TestGraphSamples::LoopInfoPair TestGraphSamples::BuildLoop(OperandType type, InstructionBase *init,
+                                                           InstructionBase *bound, CondCode ccode,
+                                                           bool exitsOnTrue) {
+    /*
+        B0
+        |
+        B1
+        |
+        B2<--
+       / \  |
+      B5  B3|
+          | |
+          B4-
+    */
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    std::vector<BasicBlock *> bblocks{graph->GetFirstBasicBlock()};
+    for (size_t i = 1; i < 6; ++i) {
+        bblocks.push_back(graph->CreateEmptyBasicBlock());
+    }
+    graph->ConnectBasicBlocks(bblocks[0], bblocks[1]);
+    graph->ConnectBasicBlocks(bblocks[1], bblocks[2]);
+    // the first successor is the true branch
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[exitsOnTrue ? 5 : 3]);
+    graph->ConnectBasicBlocks(bblocks[2], bblocks[exitsOnTrue ? 3 : 5]);
+    graph->ConnectBasicBlocks(bblocks[3], bblocks[4]);
+    graph->ConnectBasicBlocks(bblocks[4], bblocks[2]);
+
+    auto *phi = instrBuilder->CreatePHI(type);
+    auto *cmp = instrBuilder->CreateCMP(type, ccode, phi, bound);
+    instrBuilder->PushBackInstruction(bblocks[2], phi, cmp, instrBuilder->CreateJCMP());
+    instrBuilder->PushBackInstruction(bblocks[5], instrBuilder->CreateRET(type, phi));
+    phi->AddPhiInput(init, bblocks[1]);
+    return {bblocks, phi};
+}
+
 TestGraphSamples::LivenessInfoTuple TestGraphSamples::FillCase1() {
     auto [graph, bblocks] = BuildCase1();
     auto type = OperandType::I32;
@@ -368,9 +404,9 @@ TestGraphSamples::LivenessInfoTuple TestGraphSamples::FillCase4() {
         add, retvoid);
 
     std::pmr::vector<LiveInterval> linearOrder{
-        {{{2, 18}}, constOne},
+        {{{2, 20}}, constOne},
         {{{4, 8}}, constTen},
-        {{{20, 22}, {6, 14}}, constTwenty},
+        {{{6, 22}}, constTwenty},
         {{{20, 22}, {8, 16}}, phi1},
         {{{8, 18}}, phi2},
         {{{10, 12}}, cmpEq},
@@ -440,11 +476,11 @@ TestGraphSamples::LivenessInfoTuple TestGraphSamples::FillCase5() {
 
     std::pmr::vector<LiveInterval> linearOrder{
         {{{2, 16}}, arg0},
-        {{{4, 20}}, arg1},
-        {{{30, 32}, {6, 26}}, arg2},
-        {{{8, 44}}, constZero},
-        {{{10, 46}}, constOne},
-        {{{12, 52}}, constTen},
+        {{{4, 56}}, arg1},
+        {{{6, 56}}, arg2},
+        {{{8, 56}}, constZero},
+        {{{10, 56}}, constOne},
+        {{{12, 56}}, constTen},
         {{{14, 16}}, constTwenty},
         {{{16, 18}}, phi1},
         {{{62, 64}, {18, 56}}, subi1},
@@ -10,6 +10,7 @@ class TestGraphSamples : public CompilerTestBase {
 public:
     using CFGInfoPair = std::pair<Graph *, std::vector<BasicBlock *>>;
     using LivenessInfoTuple = std::tuple<Graph *, std::vector<BasicBlock *>, std::pmr::vector<LiveInterval>>;
+    using LoopInfoPair = std::pair<std::vector<BasicBlock *>, PhiInstruction *>;
 
     CFGInfoPair BuildCase0();
     CFGInfoPair BuildCase1();
@@ -17,6 +18,11 @@ public:
     CFGInfoPair BuildCase3();
     CFGInfoPair BuildCase4();
     CFGInfoPair BuildCase5();
+    // Builds the loop over `phi = init, ...` with the test `phi ccode bound` in the header,
+    // which exits the loop by the false branch unless `exitsOnTrue` is set.
+    // The first basic block must be filled beforehand; the PHI's update input is left to the caller.
+    LoopInfoPair BuildLoop(OperandType type, InstructionBase *init, InstructionBase *bound, CondCode ccode,
+                           bool exitsOnTrue = false);
 
     LivenessInfoTuple FillCase1();
     LivenessInfoTuple FillCase2();
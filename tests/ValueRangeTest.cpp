@@ -0,0 +1,129 @@
+#include <limits>
+#include "TestGraphSamples.h"
+#include "ValueRangeAnalysis.h"
+
+
+namespace ir::tests {
+class ValueRangeTest : public TestGraphSamples {
+public:
+    static constexpr auto TYPE = OperandType::I32;
+    static constexpr int64_t MAX = std::numeric_limits<int32_t>::max();
+    static constexpr int64_t MIN = std::numeric_limits<int32_t>::min();
+};
+
+TEST_F(ValueRangeTest, TestRanges) {
+    ASSERT_EQ(ValueRange::Full(OperandType::I8), (ValueRange{-128, 127}));
+    ASSERT_EQ(ValueRange::Full(OperandType::U16), (ValueRange{-32768, 32767}));
+    ASSERT_TRUE(ValueRange::Empty().IsEmpty());
+
+    ValueRange range{0, 10};
+    ASSERT_EQ(range.Narrow(CondCode::LT, {5, 7}), (ValueRange{0, 6}));
+    ASSERT_EQ(range.Narrow(CondCode::GE, {5, 7}), (ValueRange{5, 10}));
+    ASSERT_EQ(range.Narrow(CondCode::NE, ValueRange::Single(10)), (ValueRange{0, 9}));
+    ASSERT_EQ(range.Narrow(CondCode::NE, {9, 10}), range);
+    ASSERT_TRUE(range.Narrow(CondCode::GT, {10, 20}).IsEmpty());
+
+    ASSERT_TRUE(ValueRange::AlwaysHolds(CondCode::LT, range, {11, 12}));
+    ASSERT_FALSE(ValueRange::AlwaysHolds(CondCode::LT, range, {10, 12}));
+    ASSERT_TRUE(ValueRange::AlwaysHolds(CondCode::LE, range, {10, 12}));
+    ASSERT_TRUE(ValueRange::AlwaysHolds(CondCode::NE, range, {-5, -1}));
+    ASSERT_FALSE(ValueRange::AlwaysHolds(CondCode::EQ, range, range));
+}
+
+TEST_F(ValueRangeTest, TestLoop) {
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(TYPE);
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    auto *constTen = instrBuilder->CreateCONST(TYPE, 10);
+    FillFirstBlock(graph, arg, constZero, constTen);
+    auto [bblocks, phi] = BuildLoop(TYPE, constZero, constTen, CondCode::LT);
+
+    // for (i = 0; i < 10; ++i) { j = 4 * i - 1; k = (I8)i; m = arg & 255; n = arg % 7; l = len(new int[16]); }
+    auto *mul = instrBuilder->CreateMULI(TYPE, phi, 4);
+    auto *sub = instrBuilder->CreateSUBI(TYPE, mul, 1);
+    auto *cast = instrBuilder->CreateCAST(TYPE, OperandType::I8, phi);
+    auto *andi = instrBuilder->CreateANDI(TYPE, arg, 255);
+    auto *mod = instrBuilder->CreateMODI(TYPE, arg, 7);
+    auto *array = instrBuilder->CreateNEW_ARRAY_IMM(16, 1);
+    auto *len = instrBuilder->CreateLEN(array);
+    auto *update = instrBuilder->CreateADDI(TYPE, phi, 1);
+    instrBuilder->PushBackInstruction(bblocks[3], mul, sub, cast, andi, mod, array, len);
+    instrBuilder->PushBackInstruction(bblocks[4], update);
+    phi->AddPhiInput(update, bblocks[4]);
+
+    ValueRangeAnalysis rangeAnalysis(graph);
+    rangeAnalysis.Run();
+
+    ASSERT_EQ(rangeAnalysis.GetRange(phi), (ValueRange{0, 10}));
+    ASSERT_EQ(rangeAnalysis.GetRange(phi, bblocks[3]), (ValueRange{0, 9}));
+    ASSERT_EQ(rangeAnalysis.GetRange(phi, bblocks[5]), ValueRange::Single(10));
+    ASSERT_EQ(rangeAnalysis.GetRange(phi, bblocks[2], bblocks[5]), ValueRange::Single(10));
+    ASSERT_EQ(rangeAnalysis.GetRange(update), (ValueRange{1, 10}));
+    ASSERT_EQ(rangeAnalysis.GetRange(mul), (ValueRange{0, 36}));
+    ASSERT_EQ(rangeAnalysis.GetRange(sub), (ValueRange{-1, 35}));
+    ASSERT_EQ(rangeAnalysis.GetRange(cast), (ValueRange{0, 9}));
+    ASSERT_EQ(rangeAnalysis.GetRange(andi), (ValueRange{0, 255}));
+    ASSERT_EQ(rangeAnalysis.GetRange(mod), (ValueRange{-6, 6}));
+    ASSERT_EQ(rangeAnalysis.GetRange(len), ValueRange::Single(16));
+    ASSERT_EQ(rangeAnalysis.GetRange(arg), ValueRange::Full(TYPE));
+}
+
+TEST_F(ValueRangeTest, TestUnknownBound) {
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *arg = instrBuilder->CreateARG(TYPE);
+    auto *constZero = instrBuilder->CreateCONST(TYPE, 0);
+    FillFirstBlock(graph, arg, constZero);
+    auto [bblocks, phi] = BuildLoop(TYPE, constZero, arg, CondCode::LT);
+
+    // for (i = 0; i < arg; ++i) { a = new int[i]; l = len(a); m = arg + 1; }
+    auto *array = instrBuilder->CreateNEW_ARRAY(phi, 1);
+    auto *len = instrBuilder->CreateLEN(array);
+    auto *add = instrBuilder->CreateADDI(TYPE, arg, 1);
+    auto *update = instrBuilder->CreateADDI(TYPE, phi, 1);
+    instrBuilder->PushBackInstruction(bblocks[3], array, len, add);
+    instrBuilder->PushBackInstruction(bblocks[4], update);
+    phi->AddPhiInput(update, bblocks[4]);
+
+    ValueRangeAnalysis rangeAnalysis(graph);
+    rangeAnalysis.Run();
+
+    // the update cannot overflow under the loop's condition
+    ASSERT_EQ(rangeAnalysis.GetRange(phi), (ValueRange{0, MAX}));
+    ASSERT_EQ(rangeAnalysis.GetRange(phi, bblocks[3]), (ValueRange{0, MAX - 1}));
+    ASSERT_EQ(rangeAnalysis.GetRange(update), (ValueRange{1, MAX}));
+    ASSERT_EQ(rangeAnalysis.GetRange(len), (ValueRange{0, MAX - 1}));
+    // the argument is narrowed by the same condition
+    ASSERT_EQ(rangeAnalysis.GetRange(arg, bblocks[3]), (ValueRange{1, MAX}));
+    ASSERT_EQ(rangeAnalysis.GetRange(add), ValueRange::Full(TYPE));
+    ASSERT_EQ(rangeAnalysis.GetRange(arg, bblocks[5]), (ValueRange{MIN, MAX}));
+}
+
+TEST_F(ValueRangeTest, TestUnsignedDivision) {
+    auto *graph = GetGraph();
+    auto *instrBuilder = GetInstructionBuilder();
+    auto *constMax = instrBuilder->CreateCONST(OperandType::U32, std::numeric_limits<uint32_t>::max());
+    auto *constHundred = instrBuilder->CreateCONST(OperandType::U32, 100);
+    auto *firstBlock = FillFirstBlock(graph, constMax, constHundred);
+    auto *bblock = graph->CreateEmptyBasicBlock();
+    graph->ConnectBasicBlocks(firstBlock, bblock);
+
+    // 0xFFFFFFFF is kept as -1, but it is divided as a large value
+    auto *div = instrBuilder->CreateDIVI(OperandType::U32, constMax, 2);
+    auto *mod = instrBuilder->CreateMODI(OperandType::U32, constMax, 7);
+    auto *cast = instrBuilder->CreateCAST(OperandType::U32, OperandType::I64, div);
+    auto *divSmall = instrBuilder->CreateDIVI(OperandType::U32, constHundred, 3);
+    instrBuilder->PushBackInstruction(
+        bblock, div, mod, cast, divSmall, instrBuilder->CreateRET(OperandType::I64, cast));
+
+    ValueRangeAnalysis rangeAnalysis(graph);
+    rangeAnalysis.Run();
+
+    ASSERT_EQ(rangeAnalysis.GetRange(constMax), ValueRange::Single(-1));
+    ASSERT_EQ(rangeAnalysis.GetRange(div), ValueRange::Full(OperandType::U32));
+    ASSERT_EQ(rangeAnalysis.GetRange(mod), ValueRange::Full(OperandType::U32));
+    ASSERT_TRUE(rangeAnalysis.GetRange(cast).Contains(std::numeric_limits<int32_t>::max()));
+    ASSERT_EQ(rangeAnalysis.GetRange(divSmall), ValueRange::Single(33));
+}
+}   // namespace ir::tests
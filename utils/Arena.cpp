@@ -0,0 +1,118 @@
+#include <algorithm>
+#include "Arena.h"
+#include <memory>
+#include <vector>
+
+
+namespace utils {
+static constexpr size_t CHUNK_ALIGNMENT = alignof(std::max_align_t);
+
+ChunkPool::ChunkPool(size_t chunkSize, std::pmr::memory_resource *upstream)
+    : chunkSize(chunkSize), upstream(upstream)
+{
+    ASSERT(chunkSize >= sizeof(FreeChunkHeader));
+    ASSERT(upstream);
+}
+
+ChunkPool::~ChunkPool() noexcept {
+    ASSERT(usedBytes == 0);
+    Trim();
+}
+
+void *ChunkPool::AllocateChunk(size_t size) {
+    ASSERT(size != 0);
+    usedBytes += std::max(size, chunkSize);
+    if (size > chunkSize) {
+        return upstream->allocate(size, CHUNK_ALIGNMENT);
+    }
+    if (freeList) {
+        auto *chunk = freeList;
+        freeList = chunk->next;
+        --cachedChunks;
+        return chunk;
+    }
+    return upstream->allocate(chunkSize, CHUNK_ALIGNMENT);
+}
+
+void ChunkPool::FreeChunk(void *chunk, size_t size) {
+    ASSERT(chunk);
+    size = std::max(size, chunkSize);
+    ASSERT(usedBytes >= size);
+    usedBytes -= size;
+    if (size > chunkSize) {
+        upstream->deallocate(chunk, size, CHUNK_ALIGNMENT);
+        return;
+    }
+    freeList = new (chunk) FreeChunkHeader{freeList};
+    ++cachedChunks;
+}
+
+void ChunkPool::Trim() {
+    while (freeList) {
+        auto *next = freeList->next;
+        upstream->deallocate(freeList, chunkSize, CHUNK_ALIGNMENT);
+        freeList = next;
+    }
+    cachedChunks = 0;
+}
+
+void Arena::Release() {
+    while (currentChunk) {
+        auto *prev = currentChunk->prev;
+        pool->FreeChunk(currentChunk, currentChunk->size);
+        currentChunk = prev;
+    }
+    current = nullptr;
+    end = nullptr;
+    allocatedBytes = 0;
+    reservedBytes = 0;
+}
+
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    void *ptr = current;
+    size_t space = end - current;
+    if (currentChunk == nullptr || !std::align(alignment, bytes, ptr, space)) {
+        acquireChunk(bytes + alignment);
+        ptr = current;
+        space = end - current;
+        [[maybe_unused]] auto *aligned = std::align(alignment, bytes, ptr, space);
+        ASSERT(aligned);
+    }
+    current = static_cast<std::byte *>(ptr) + bytes;
+    allocatedBytes += bytes;
+    return ptr;
+}
+
+void Arena::acquireChunk(size_t minSize) {
+    auto size = std::max(minSize + sizeof(ChunkHeader), pool->GetChunkSize());
+    auto *chunk = new (pool->AllocateChunk(size)) ChunkHeader{currentChunk, size};
+    currentChunk = chunk;
+    current = reinterpret_cast<std::byte *>(chunk + 1);
+    end = reinterpret_cast<std::byte *>(chunk) + size;
+    reservedBytes += size;
+}
+
+namespace {
+struct ScratchArenas {
+    ChunkPool pool;
+    std::vector<std::unique_ptr<Arena>> arenas;
+    size_t depth = 0;
+};
+
+thread_local ScratchArenas scratchArenas;
+}   // namespace
+
+ScratchScope::ScratchScope() : depth(scratchArenas.depth++) {
+    auto &arenas = scratchArenas.arenas;
+    if (depth == arenas.size()) {
+        arenas.push_back(std::make_unique<Arena>(&scratchArenas.pool));
+    }
+    arena = arenas[depth].get();
+}
+
+ScratchScope::~ScratchScope() noexcept {
+    ASSERT(scratchArenas.depth == depth + 1);
+    arena->Release();
+    --scratchArenas.depth;
+}
+}   // namespace utils
@@ -0,0 +1,132 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_ARENA_H_
+#define JIT_AOT_COMPILERS_COURSE_ARENA_H_
+
+#include "macros.h"
+#include <cstddef>
+#include <memory_resource>
+
+
+namespace utils {
+// Source of fixed-size memory chunks shared between arenas.
+// Chunks returned by arenas are cached in a free-list and handed out again
+// instead of being returned to the upstream resource.
+class ChunkPool final {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit ChunkPool(size_t chunkSize = DEFAULT_CHUNK_SIZE,
+                       std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    NO_COPY_SEMANTIC(ChunkPool);
+    NO_MOVE_SEMANTIC(ChunkPool);
+    ~ChunkPool() noexcept;
+
+    // Chunks larger than the pool's chunk size are allocated directly from
+    // (and freed back to) the upstream resource.
+    void *AllocateChunk(size_t size);
+    void FreeChunk(void *chunk, size_t size);
+    // Returns all cached chunks to the upstream resource.
+    void Trim();
+
+    size_t GetChunkSize() const {
+        return chunkSize;
+    }
+    // Bytes currently held by arenas.
+    size_t GetUsedBytes() const {
+        return usedBytes;
+    }
+    // Bytes currently cached in the free-list.
+    size_t GetCachedBytes() const {
+        return cachedChunks * chunkSize;
+    }
+    // Bytes currently obtained from the upstream resource.
+    size_t GetReservedBytes() const {
+        return GetUsedBytes() + GetCachedBytes();
+    }
+
+private:
+    struct FreeChunkHeader {
+        FreeChunkHeader *next;
+    };
+
+    size_t chunkSize;
+    std::pmr::memory_resource *upstream;
+
+    FreeChunkHeader *freeList = nullptr;
+    size_t cachedChunks = 0;
+    size_t usedBytes = 0;
+};
+
+// Bump-pointer memory resource, which takes chunks from a ChunkPool.
+// Deallocation of separate objects is a no-op; all memory is given back
+// to the pool at once by Release or on destruction.
+class Arena final : public std::pmr::memory_resource {
+public:
+    explicit Arena(ChunkPool *pool) : pool(pool) {
+        ASSERT(pool);
+    }
+    NO_COPY_SEMANTIC(Arena);
+    NO_MOVE_SEMANTIC(Arena);
+    ~Arena() noexcept override {
+        Release();
+    }
+
+    void Release();
+
+    // Bytes handed out to the arena's users.
+    size_t GetAllocatedBytes() const {
+        return allocatedBytes;
+    }
+    // Bytes held in chunks.
+    size_t GetReservedBytes() const {
+        return reservedBytes;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate([[maybe_unused]] void *p,
+                       [[maybe_unused]] size_t bytes,
+                       [[maybe_unused]] size_t alignment) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    void acquireChunk(size_t minSize);
+
+private:
+    struct ChunkHeader {
+        ChunkHeader *prev;
+        size_t size;
+    };
+
+    ChunkPool *pool;
+
+    ChunkHeader *currentChunk = nullptr;
+    std::byte *current = nullptr;
+    std::byte *end = nullptr;
+
+    size_t allocatedBytes = 0;
+    size_t reservedBytes = 0;
+};
+
+// Gives access to a per-thread stack of arenas for short-lived allocations.
+// Every scope takes the next arena from the stack and releases it on exit,
+// the chunks are kept by the thread's pool for the following scopes.
+// Scopes must be destroyed in the reverse order of their creation.
+class ScratchScope final {
+public:
+    ScratchScope();
+    NO_COPY_SEMANTIC(ScratchScope);
+    NO_MOVE_SEMANTIC(ScratchScope);
+    ~ScratchScope() noexcept;
+
+    Arena *GetArena() const {
+        return arena;
+    }
+
+private:
+    Arena *arena;
+    size_t depth;
+};
+}   // namespace utils
+
+#endif // JIT_AOT_COMPILERS_COURSE_ARENA_H_
@@ -0,0 +1,96 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_FREE_LISTS_H_
+#define JIT_AOT_COMPILERS_COURSE_FREE_LISTS_H_
+
+#include <array>
+#include <cstddef>
+#include "macros.h"
+#include <memory_resource>
+#include <new>
+
+
+namespace utils {
+struct FreeListsStats {
+    // number of all allocations and of the ones served from free-lists
+    size_t allocationsCount = 0;
+    size_t reusedCount = 0;
+    size_t freedCount = 0;
+    // bytes currently kept in free-lists
+    size_t cachedBytes = 0;
+
+    double GetReuseRate() const {
+        return allocationsCount == 0
+            ? 0.0 : static_cast<double>(reusedCount) / static_cast<double>(allocationsCount);
+    }
+};
+
+// Free-lists of memory blocks grouped into size classes.
+// Memory of destroyed objects is kept for the following allocations of
+// the same size class instead of being returned to the upstream resource,
+// which is useful for upstreams never reusing memory, like Arena.
+class FreeLists final {
+public:
+    static constexpr size_t GRANULARITY = alignof(std::max_align_t);
+    static constexpr size_t MAX_SIZE = 512;
+
+    explicit FreeLists(std::pmr::memory_resource *upstream) : upstream(upstream) {
+        ASSERT(upstream);
+    }
+    NO_COPY_SEMANTIC(FreeLists);
+    NO_MOVE_SEMANTIC(FreeLists);
+    DEFAULT_DTOR(FreeLists);
+
+    void *Allocate(size_t size) {
+        ASSERT(size != 0);
+        ++stats.allocationsCount;
+        if (size > MAX_SIZE) {
+            return upstream->allocate(size, GRANULARITY);
+        }
+        auto &head = lists[getSizeClass(size)];
+        if (head == nullptr) {
+            return upstream->allocate(getClassSize(size), GRANULARITY);
+        }
+        auto *block = head;
+        head = block->next;
+        ++stats.reusedCount;
+        stats.cachedBytes -= getClassSize(size);
+        return block;
+    }
+    // Size must be equal to the one passed on allocation.
+    void Free(void *ptr, size_t size) {
+        ASSERT((ptr) && size != 0);
+        ++stats.freedCount;
+        if (size > MAX_SIZE) {
+            upstream->deallocate(ptr, size, GRANULARITY);
+            return;
+        }
+        auto &head = lists[getSizeClass(size)];
+        head = new (ptr) FreeBlock{head};
+        stats.cachedBytes += getClassSize(size);
+    }
+
+    const FreeListsStats &GetStats() const {
+        return stats;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    static constexpr size_t getSizeClass(size_t size) {
+        return (size - 1) / GRANULARITY;
+    }
+    static constexpr size_t getClassSize(size_t size) {
+        return (getSizeClass(size) + 1) * GRANULARITY;
+    }
+
+private:
+    std::pmr::memory_resource *upstream;
+
+    std::array<FreeBlock *, MAX_SIZE / GRANULARITY> lists{};
+
+    FreeListsStats stats;
+};
+}   // namespace utils
+
+#endif // JIT_AOT_COMPILERS_COURSE_FREE_LISTS_H_
@@ -0,0 +1,118 @@
+#ifndef JIT_AOT_COMPILERS_COURSE_TRACKING_RESOURCE_H_
+#define JIT_AOT_COMPILERS_COURSE_TRACKING_RESOURCE_H_
+
+#include <algorithm>
+#include "macros.h"
+#include <memory_resource>
+
+
+namespace utils {
+struct MemoryStats {
+    // total number of bytes and allocations requested
+    size_t allocatedBytes = 0;
+    size_t allocationsCount = 0;
+    // number of bytes which are not deallocated yet
+    size_t currentBytes = 0;
+    size_t peakBytes = 0;
+    // bytes allocated from short-lived scratch memory, not included into the other counters
+    size_t scratchBytes = 0;
+};
+
+// Memory resource counting allocations passed to the upstream resource.
+// Exceeding the limit does not fail allocations, but is reported
+// via IsLimitExceeded, so that the user can stop the work in a consistent state.
+class TrackingResource final : public std::pmr::memory_resource {
+public:
+    // Saved state of the resource at the start of a nested measurement.
+    struct Checkpoint {
+        MemoryStats stats;
+        size_t outerPeakBytes;
+    };
+
+    explicit TrackingResource(std::pmr::memory_resource *upstream) : upstream(upstream) {
+        ASSERT(upstream);
+    }
+    NO_COPY_SEMANTIC(TrackingResource);
+    NO_MOVE_SEMANTIC(TrackingResource);
+    ~TrackingResource() noexcept override = default;
+
+    const MemoryStats &GetStats() const {
+        return stats;
+    }
+    void ResetStats() {
+        ASSERT(measurementsDepth == 0);
+        stats = MemoryStats();
+        limitExceeded = false;
+    }
+
+    // Zero limit means no limit.
+    size_t GetLimit() const {
+        return limit;
+    }
+    void SetLimit(size_t newLimit) {
+        limit = newLimit;
+        limitExceeded = limit != 0 && stats.currentBytes > limit;
+    }
+    bool IsLimitExceeded() const {
+        return limitExceeded;
+    }
+
+    // Measurements may be nested; the outer one accounts for everything
+    // allocated in the inner ones.
+    Checkpoint StartMeasurement() {
+        ++measurementsDepth;
+        Checkpoint checkpoint{stats, stats.peakBytes};
+        stats.peakBytes = stats.currentBytes;
+        return checkpoint;
+    }
+    // Returns statistics collected since the corresponding StartMeasurement call:
+    // `currentBytes` is the number of retained bytes, `peakBytes` is the maximum
+    // number of bytes held at once above the starting point.
+    MemoryStats FinishMeasurement(const Checkpoint &checkpoint) {
+        ASSERT(measurementsDepth > 0);
+        --measurementsDepth;
+        const auto &start = checkpoint.stats;
+        MemoryStats result{
+            stats.allocatedBytes - start.allocatedBytes,
+            stats.allocationsCount - start.allocationsCount,
+            stats.currentBytes > start.currentBytes ? stats.currentBytes - start.currentBytes : 0,
+            stats.peakBytes - start.currentBytes,
+            0};
+        stats.peakBytes = std::max(stats.peakBytes, checkpoint.outerPeakBytes);
+        return result;
+    }
+    size_t GetMeasurementsDepth() const {
+        return measurementsDepth;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        stats.allocatedBytes += bytes;
+        ++stats.allocationsCount;
+        stats.currentBytes += bytes;
+        stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+        if (limit != 0 && stats.currentBytes > limit) {
+            limitExceeded = true;
+        }
+        return upstream->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        ASSERT(stats.currentBytes >= bytes);
+        stats.currentBytes -= bytes;
+        upstream->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource *upstream;
+
+    MemoryStats stats;
+    size_t limit = 0;
+    bool limitExceeded = false;
+    size_t measurementsDepth = 0;
+};
+}   // namespace utils
+
+#endif // JIT_AOT_COMPILERS_COURSE_TRACKING_RESOURCE_H_
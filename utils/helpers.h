@@ -37,6 +37,10 @@ struct has_set_flag<T, std::void_t<decltype(T::SET_FLAG)>> {
 
 template <typename T>
 constexpr bool has_set_flag_v = has_set_flag<T>::value;
+
+// Adds const qualifier to T if From is const.
+template <typename From, typename T>
+using copy_const_t = std::conditional_t<std::is_const_v<From>, const T, T>;
 }   // namespace utils
 
 #endif // JIT_AOT_COMPILERS_COURSE_HELPERS_H_